@@ -23,6 +23,7 @@
 #include <G3D/AABox.h>
 
 #include "Define.h"
+#include "advstd.h"
 
 #include <stdexcept>
 #include <vector>
@@ -31,6 +32,10 @@
 #include <cmath>
 #include "string.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
 #define MAX_STACK_SIZE 64
 
 // https://stackoverflow.com/a/4328396
@@ -252,6 +257,211 @@ class TC_COMMON_API BIH
             }
         }
 
+        static constexpr uint32 RAY_PACKET_SIZE = 8;
+
+        /** Traces up to RAY_PACKET_SIZE rays at once, each ray stops at its first hit.
+            Node slabs are tested for all rays of the packet in one pass and a subtree is entered
+            if any ray still needs it, so rays that are close to each other share the traversal.
+            Returns the mask of rays that hit something within their maxDist. */
+        template<typename RayCallback>
+        uint32 intersectRayPacket(G3D::Ray const* rays, float const* maxDists, uint32 count, RayCallback& intersectCallback) const
+        {
+            count = std::min(count, RAY_PACKET_SIZE);
+
+            float const infinity = std::numeric_limits<float>::infinity();
+            float org[3][RAY_PACKET_SIZE] = { };
+            float invDir[3][RAY_PACKET_SIZE] = { };
+            float intervalMin[RAY_PACKET_SIZE];
+            float intervalMax[RAY_PACKET_SIZE];
+            float dist[RAY_PACKET_SIZE];
+            uint32 pending = 0;
+            uint32 hits = 0;
+
+            for (uint32 ray = 0; ray < RAY_PACKET_SIZE; ++ray)
+            {
+                // unused lanes get an empty interval
+                intervalMin[ray] = 1.f;
+                intervalMax[ray] = 0.f;
+                if (ray >= count)
+                    continue;
+
+                dist[ray] = maxDists[ray];
+                float tMin = -1.f;
+                float tMax = -1.f;
+                bool missed = false;
+                for (int i = 0; i < 3; ++i)
+                {
+                    org[i][ray] = rays[ray].origin()[i];
+                    invDir[i][ray] = 1.f / rays[ray].direction()[i];
+                    if (G3D::fuzzyNe(rays[ray].direction()[i], 0.0f))
+                    {
+                        float t1 = (bounds.low()[i] - org[i][ray]) * invDir[i][ray];
+                        float t2 = (bounds.high()[i] - org[i][ray]) * invDir[i][ray];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        if (t1 > tMin)
+                            tMin = t1;
+                        if (t2 < tMax || tMax < 0.f)
+                            tMax = t2;
+                        if (tMax <= 0 || tMin >= dist[ray])
+                            missed = true;
+                    }
+                }
+
+                if (missed || tMin > tMax)
+                    continue;
+
+                intervalMin[ray] = std::max(tMin, 0.f);
+                intervalMax[ray] = std::min(tMax, dist[ray]);
+                pending |= 1 << ray;
+            }
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            int node = 0;
+            uint32 active = pending;
+
+            while (pending) {
+                while (true)
+                {
+                    // rays that already hit something need no further traversal
+                    active &= pending;
+                    if (!active)
+                        break;
+
+                    uint32 tn = tree[node];
+                    uint32 axis = (tn & (3 << 30)) >> 30;
+                    bool BVH2 = (tn & (1 << 29)) != 0;
+                    int offset = tn & ~(7 << 29);
+                    if (!BVH2)
+                    {
+                        if (axis < 3)
+                        {
+                            // "normal" interior node, clip every ray against both child slabs
+                            float clipLeft = intBitsToFloat(tree[node + 1]);
+                            float clipRight = intBitsToFloat(tree[node + 2]);
+                            float leftMin[RAY_PACKET_SIZE], leftMax[RAY_PACKET_SIZE];
+                            float rightMin[RAY_PACKET_SIZE], rightMax[RAY_PACKET_SIZE];
+                            float const* axisOrg = org[axis];
+                            float const* axisInvDir = invDir[axis];
+                            for (uint32 ray = 0; ray < RAY_PACKET_SIZE; ++ray)
+                            {
+                                float tl = (clipLeft - axisOrg[ray]) * axisInvDir[ray];
+                                float tr = (clipRight - axisOrg[ray]) * axisInvDir[ray];
+                                // the plane is entered or left depending on the direction, NaN keeps the (conservative) parent interval
+                                bool neg = axisInvDir[ray] < 0.f;
+                                float leftEnter = neg ? tl : -infinity;
+                                float leftExit = neg ? infinity : tl;
+                                float rightEnter = neg ? -infinity : tr;
+                                float rightExit = neg ? tr : infinity;
+                                leftMin[ray] = std::max(intervalMin[ray], leftEnter);
+                                leftMax[ray] = std::min(intervalMax[ray], leftExit);
+                                rightMin[ray] = std::max(intervalMin[ray], rightEnter);
+                                rightMax[ray] = std::min(intervalMax[ray], rightExit);
+                            }
+                            uint32 leftActive = getNonEmptyIntervals(leftMin, leftMax) & active;
+                            uint32 rightActive = getNonEmptyIntervals(rightMin, rightMax) & active;
+
+                            // enter the child that is in front for the majority of the packet first
+                            uint32 firstRay = advstd::countr_zero(active);
+                            bool rightFirst = invDir[axis][firstRay] < 0.f;
+                            uint32 nearActive = rightFirst ? rightActive : leftActive;
+                            uint32 farActive = rightFirst ? leftActive : rightActive;
+                            float const* nearMin = rightFirst ? rightMin : leftMin;
+                            float const* nearMax = rightFirst ? rightMax : leftMax;
+                            float const* farMin = rightFirst ? leftMin : rightMin;
+                            float const* farMax = rightFirst ? leftMax : rightMax;
+                            int nearNode = rightFirst ? offset + 3 : offset;
+                            int farNode = rightFirst ? offset : offset + 3;
+
+                            if (nearActive && farActive)
+                            {
+                                stack[stackPos].node = farNode;
+                                stack[stackPos].active = farActive;
+                                std::copy(farMin, farMin + RAY_PACKET_SIZE, stack[stackPos].tnear);
+                                std::copy(farMax, farMax + RAY_PACKET_SIZE, stack[stackPos].tfar);
+                                stackPos++;
+                            }
+                            else if (!nearActive)
+                            {
+                                if (!farActive)
+                                    break;
+                                nearActive = farActive;
+                                nearMin = farMin;
+                                nearMax = farMax;
+                                nearNode = farNode;
+                            }
+
+                            node = nearNode;
+                            active = nearActive;
+                            std::copy(nearMin, nearMin + RAY_PACKET_SIZE, intervalMin);
+                            std::copy(nearMax, nearMax + RAY_PACKET_SIZE, intervalMax);
+                            continue;
+                        }
+                        else
+                        {
+                            // leaf - test some objects against every ray that reached it
+                            int n = tree[node + 1];
+                            while (n > 0 && active) {
+                                for (uint32 remaining = active; remaining; remaining &= remaining - 1)
+                                {
+                                    uint32 ray = advstd::countr_zero(remaining);
+                                    if (intersectCallback(rays[ray], objects[offset], dist[ray], true))
+                                    {
+                                        hits |= 1 << ray;
+                                        pending &= ~(1 << ray);
+                                        active &= ~(1 << ray);
+                                    }
+                                }
+                                --n;
+                                ++offset;
+                            }
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        if (axis>2)
+                            return hits; // should not happen
+                        float clipLow = intBitsToFloat(tree[node + 1]);
+                        float clipHigh = intBitsToFloat(tree[node + 2]);
+                        float const* axisOrg = org[axis];
+                        float const* axisInvDir = invDir[axis];
+                        for (uint32 ray = 0; ray < RAY_PACKET_SIZE; ++ray)
+                        {
+                            float tl = (clipLow - axisOrg[ray]) * axisInvDir[ray];
+                            float th = (clipHigh - axisOrg[ray]) * axisInvDir[ray];
+                            bool neg = axisInvDir[ray] < 0.f;
+                            float tf = neg ? th : tl;
+                            float tb = neg ? tl : th;
+                            intervalMin[ray] = (tf >= intervalMin[ray]) ? tf : intervalMin[ray];
+                            intervalMax[ray] = (tb <= intervalMax[ray]) ? tb : intervalMax[ray];
+                        }
+                        node = offset;
+                        active &= getNonEmptyIntervals(intervalMin, intervalMax);
+                        continue;
+                    }
+                } // traversal loop
+                do
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                        return hits;
+                    // move back up the stack
+                    stackPos--;
+                    active = stack[stackPos].active & pending;
+                    if (!active)
+                        continue;
+                    node = stack[stackPos].node;
+                    std::copy(stack[stackPos].tnear, stack[stackPos].tnear + RAY_PACKET_SIZE, intervalMin);
+                    std::copy(stack[stackPos].tfar, stack[stackPos].tfar + RAY_PACKET_SIZE, intervalMax);
+                    break;
+                } while (true);
+            }
+
+            return hits;
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -351,6 +561,27 @@ class TC_COMMON_API BIH
             float tnear;
             float tfar;
         };
+        struct PacketStackNode
+        {
+            uint32 node;
+            uint32 active;
+            float tnear[RAY_PACKET_SIZE];
+            float tfar[RAY_PACKET_SIZE];
+        };
+
+        // mask of the packet rays whose [tmin, tmax] interval is not empty
+        static uint32 getNonEmptyIntervals(float const* tMin, float const* tMax)
+        {
+            uint32 mask = 0;
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+            for (uint32 ray = 0; ray < RAY_PACKET_SIZE; ray += 4)
+                mask |= uint32(_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(tMin + ray), _mm_loadu_ps(tMax + ray)))) << ray;
+#else
+            for (uint32 ray = 0; ray < RAY_PACKET_SIZE; ++ray)
+                mask |= uint32(tMin[ray] <= tMax[ray]) << ray;
+#endif
+            return mask;
+        }
 
         class BuildStats
         {
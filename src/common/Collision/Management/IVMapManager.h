@@ -70,6 +70,14 @@ namespace VMAP
         Optional<AreaInfo> areaInfo;
         Optional<LiquidInfo> liquidInfo;
     };
+
+    // one ray of a batched line of sight query, inLineOfSight is filled by the query
+    struct LineOfSightRay
+    {
+        float x1, y1, z1;
+        float x2, y2, z2;
+        bool inLineOfSight;
+    };
     //===========================================================
     class TC_COMMON_API IVMapManager
     {
@@ -90,6 +98,7 @@ namespace VMAP
             virtual void unloadMap(unsigned int pMapId) = 0;
 
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+            virtual void isInLineOfSight(unsigned int pMapId, LineOfSightRay* rays, uint32 count, ModelIgnoreFlags ignoreFlags) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
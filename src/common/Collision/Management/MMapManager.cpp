@@ -18,13 +18,55 @@
 #include "MMapManager.h"
 #include "Errors.h"
 #include "Log.h"
-#include "Config.h"
 #include "MapDefines.h"
+#include "DetourNode.h"
+#include <algorithm>
+#include <atomic>
 
 namespace MMAP
 {
-    static char const* const MAP_FILE_NAME_FORMAT = "%s/mmaps/%03i.mmap";
-    static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
+    static char const* const MAP_FILE_NAME_FORMAT = "%s/%03i.mmap";
+    static char const* const TILE_FILE_NAME_FORMAT = "%s/%03i%02i%02i.mmtile";
+
+    namespace
+    {
+        std::atomic<uint64> NextMMapDataGeneration(1);
+        std::atomic<uint64> LoadedTileBytes(0);
+        std::atomic<uint32> NavMeshQueryCount(0);
+
+        // approximate size of the node pools and open list dtNavMeshQuery::init allocates
+        uint64 constexpr NavMeshQueryBytes = sizeof(dtNavMeshQuery)
+            + MMapManager::MAX_NAVMESH_QUERY_NODES * (sizeof(dtNode) + sizeof(dtNodeIndex) + sizeof(dtNode*))
+            + MMapManager::MAX_NAVMESH_QUERY_NODES / 4 * sizeof(dtNodeIndex)
+            + 64 * (sizeof(dtNode) + sizeof(dtNodeIndex));
+
+        // queries of one thread, the most recently used first
+        struct ThreadNavMeshQueries
+        {
+            struct Entry
+            {
+                uint32 MapId;
+                uint64 Generation;
+                dtNavMeshQuery* Query;
+            };
+
+            ~ThreadNavMeshQueries()
+            {
+                for (Entry& entry : Entries)
+                    dtFreeNavMeshQuery(entry.Query);
+
+                NavMeshQueryCount -= uint32(Entries.size());
+            }
+
+            std::vector<Entry> Entries;
+        };
+
+        thread_local ThreadNavMeshQueries ThreadQueries;
+    }
+
+    MMapData::MMapData(dtNavMesh* mesh) : navMesh(mesh), generation(NextMMapDataGeneration++)
+    {
+    }
 
     // ######################## MMapManager ########################
     MMapManager::~MMapManager()
@@ -55,7 +97,7 @@ namespace MMAP
         return itr;
     }
 
-    bool MMapManager::loadMapData(uint32 mapId)
+    bool MMapManager::loadMapData(std::string const& basePath, uint32 mapId)
     {
         // we already have this map loaded?
         MMapDataSet::iterator itr = loadedMMaps.find(mapId);
@@ -73,7 +115,7 @@ namespace MMAP
         }
 
         // load and init dtNavMesh - read parameters from file
-        std::string fileName = Trinity::StringFormat(MAP_FILE_NAME_FORMAT, sConfigMgr->GetStringDefault("DataDir", ".").c_str(), mapId);
+        std::string fileName = Trinity::StringFormat(MAP_FILE_NAME_FORMAT, basePath.c_str(), mapId);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
         {
@@ -113,10 +155,10 @@ namespace MMAP
         return uint32(x << 16 | y);
     }
 
-    bool MMapManager::loadMap(const std::string& /*basePath*/, uint32 mapId, int32 x, int32 y)
+    bool MMapManager::loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y)
     {
         // make sure the mmap is loaded and ready to load tiles
-        if (!loadMapData(mapId))
+        if (!loadMapData(basePath, mapId))
             return false;
 
         // get this mmap data
@@ -129,7 +171,7 @@ namespace MMAP
             return false;
 
         // load this tile :: mmaps/MMMXXYY.mmtile
-        std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetStringDefault("DataDir", ".").c_str(), mapId, x, y);
+        std::string fileName = Trinity::StringFormat(TILE_FILE_NAME_FORMAT, basePath.c_str(), mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
         {
@@ -186,6 +228,7 @@ namespace MMAP
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            LoadedTileBytes += fileHeader.size;
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile %03i[%02i, %02i] into %03i[%02i, %02i]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
@@ -220,6 +263,7 @@ namespace MMAP
         }
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
+        uint32 tileBytes = uint32(mmap->navMesh->getTileByRef(tileRef)->dataSize);
 
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
@@ -234,6 +278,7 @@ namespace MMAP
         {
             mmap->loadedTileRefs.erase(packedGridPos);
             --loadedTiles;
+            LoadedTileBytes -= tileBytes;
             TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %03i", mapId, x, y, mapId);
             return true;
         }
@@ -257,11 +302,13 @@ namespace MMAP
         {
             uint32 x = (i->first >> 16);
             uint32 y = (i->first & 0x0000FFFF);
+            uint32 tileBytes = uint32(mmap->navMesh->getTileByRef(i->second)->dataSize);
             if (dtStatusFailed(mmap->navMesh->removeTile(i->second, nullptr, nullptr)))
                 TC_LOG_ERROR("maps", "MMAP:unloadMap: Could not unload %03u%02i%02i.mmtile from navmesh", mapId, x, y);
             else
             {
                 --loadedTiles;
+                LoadedTileBytes -= tileBytes;
                 TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile %03i[%02i, %02i] from %03i", mapId, x, y, mapId);
             }
         }
@@ -273,33 +320,6 @@ namespace MMAP
         return true;
     }
 
-    bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
-    {
-        // check if we have this map loaded
-        MMapDataSet::const_iterator itr = GetMMapData(mapId);
-        if (itr == loadedMMaps.end())
-        {
-            // file may not exist, therefore not loaded
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
-            return false;
-        }
-
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-        {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
-            return false;
-        }
-
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId %03u instanceId %u", mapId, instanceId);
-
-        return true;
-    }
-
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
@@ -309,29 +329,61 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        std::vector<ThreadNavMeshQueries::Entry>& entries = ThreadQueries.Entries;
+        auto entry = std::find_if(entries.begin(), entries.end(), [mapId](ThreadNavMeshQueries::Entry const& entry) { return entry.MapId == mapId; });
+        if (entry == entries.end())
         {
-            // allocate mesh query
-            dtNavMeshQuery* query = dtAllocNavMeshQuery();
-            ASSERT(query);
-            if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+            if (entries.size() < MAX_THREAD_NAVMESH_QUERIES)
             {
-                dtFreeNavMeshQuery(query);
-                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
+                // allocate mesh query
+                dtNavMeshQuery* query = dtAllocNavMeshQuery();
+                ASSERT(query);
+                entries.push_back({ mapId, 0, query });
+                ++NavMeshQueryCount;
+                TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u", mapId);
+            }
+            else
+                entries.back().MapId = mapId;   // reuse the least recently used query
+
+            entry = std::prev(entries.end());
+            entry->Generation = 0;
+        }
+
+        // keep the most recently used query first
+        std::rotate(entries.begin(), entry, std::next(entry));
+        entry = entries.begin();
+
+        // the query may still be bound to a navmesh that was unloaded since
+        if (entry->Generation != mmap->generation)
+        {
+            if (dtStatusFailed(entry->Query->init(mmap->navMesh, MAX_NAVMESH_QUERY_NODES)))
+            {
+                entry->Generation = 0;
+                TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId %03u", mapId);
                 return nullptr;
             }
 
-            TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId %03u instanceId %u", mapId, instanceId);
-            mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
+            entry->Generation = mmap->generation;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        return entry->Query;
+    }
+
+    MMapMemoryStats MMapManager::GetMemoryStats() const
+    {
+        MMapMemoryStats stats;
+        stats.LoadedMaps = uint32(std::count_if(loadedMMaps.begin(), loadedMMaps.end(), [](MMapDataSet::value_type const& mmap) { return mmap.second != nullptr; }));
+        stats.LoadedTiles = loadedTiles;
+        stats.TileBytes = LoadedTileBytes;
+        stats.NavMeshQueries = NavMeshQueryCount;
+        stats.NavMeshQueryBytes = stats.NavMeshQueries * NavMeshQueryBytes;
+        return stats;
     }
 }
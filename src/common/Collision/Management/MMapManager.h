@@ -29,30 +29,33 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh);
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
-
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
-
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+        uint64 generation;                 // unique for every MMapData created, pooled queries are bound to it
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    struct MMapMemoryStats
+    {
+        uint32 LoadedMaps = 0;
+        uint32 LoadedTiles = 0;
+        uint64 TileBytes = 0;
+        uint32 NavMeshQueries = 0;
+        uint64 NavMeshQueryBytes = 0;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class TC_COMMON_API MMapManager
@@ -65,16 +68,20 @@ namespace MMAP
             bool loadMap(const std::string& basePath, uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId, int32 x, int32 y);
             bool unloadMap(uint32 mapId);
-            bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+            // the returned [dtNavMeshQuery const*] belongs to the calling thread, every thread keeps queries for at most
+            // MAX_THREAD_NAVMESH_QUERIES maps so it must not be kept past later GetNavMeshQuery calls
+            dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
+            MMapMemoryStats GetMemoryStats() const;
+
+            static int32 constexpr MAX_NAVMESH_QUERY_NODES = 1024;
+            static std::size_t constexpr MAX_THREAD_NAVMESH_QUERIES = 8;
         private:
-            bool loadMapData(uint32 mapId);
+            bool loadMapData(std::string const& basePath, uint32 mapId);
             uint32 packTileID(int32 x, int32 y);
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
@@ -45,10 +45,9 @@ namespace VMAP
         {
             delete iInstanceMapTree.second;
         }
-        for (std::pair<std::string const, ManagedModel>& iLoadedModelFile : iLoadedModelFiles)
-        {
-            delete iLoadedModelFile.second.getModel();
-        }
+        for (ModelFileShard& shard : iLoadedModelFiles)
+            for (std::pair<std::string const, ManagedModel>& iLoadedModelFile : shard.Models)
+                delete iLoadedModelFile.second.getModel();
     }
 
     void VMapManager2::InitializeThreadUnsafe(const std::vector<uint32>& mapIds)
@@ -180,6 +179,50 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, LineOfSightRay* rays, uint32 count, ModelIgnoreFlags ignoreFlags)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            rays[i].inLineOfSight = true;
+
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        // convert and trace one packet at a time
+        Vector3 pos1[BIH::RAY_PACKET_SIZE];
+        Vector3 pos2[BIH::RAY_PACKET_SIZE];
+        bool results[BIH::RAY_PACKET_SIZE];
+        LineOfSightRay* packetRays[BIH::RAY_PACKET_SIZE];
+        uint32 packetSize = 0;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            LineOfSightRay& ray = rays[i];
+            pos1[packetSize] = convertPositionToInternalRep(ray.x1, ray.y1, ray.z1);
+            pos2[packetSize] = convertPositionToInternalRep(ray.x2, ray.y2, ray.z2);
+            if (pos1[packetSize] == pos2[packetSize])
+                continue;
+
+            packetRays[packetSize++] = &ray;
+            if (packetSize == BIH::RAY_PACKET_SIZE)
+            {
+                instanceTree->second->isInLineOfSight(pos1, pos2, results, packetSize, ignoreFlags);
+                for (uint32 j = 0; j < packetSize; ++j)
+                    packetRays[j]->inLineOfSight = results[j];
+                packetSize = 0;
+            }
+        }
+
+        if (packetSize)
+        {
+            instanceTree->second->isInLineOfSight(pos1, pos2, results, packetSize, ignoreFlags);
+            for (uint32 j = 0; j < packetSize; ++j)
+                packetRays[j]->inLineOfSight = results[j];
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -312,49 +355,91 @@ namespace VMAP
         }
     }
 
+    VMapManager2::ModelFileShard& VMapManager2::getModelFileShard(std::string const& filename)
+    {
+        return iLoadedModelFiles[std::hash<std::string>()(filename) % MODEL_FILE_SHARD_COUNT];
+    }
+
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename, uint32 flags/* Only used when creating the model */)
     {
-        //! Critical section, thread safe access to iLoadedModelFiles
-        std::lock_guard<std::mutex> lock(LoadedModelFilesLock);
+        ModelFileShard& shard = getModelFileShard(filename);
 
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            WorldModel* worldmodel = new WorldModel();
-            if (!worldmodel->readFile(basepath + filename + ".vmo"))
+            //! Critical section, thread safe access to this shard of iLoadedModelFiles
+            std::lock_guard<std::mutex> lock(shard.Lock);
+
+            ModelFileMap::iterator model = shard.Models.find(filename);
+            if (model != shard.Models.end())
             {
-                VMAP_ERROR_LOG("misc", "VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
-                delete worldmodel;
-                return nullptr;
+                model->second.incRefCount();
+                return model->second.getModel();
             }
-            VMAP_DEBUG_LOG("maps", "VMapManager2: loading file '%s%s'", basepath.c_str(), filename.c_str());
+        }
+
+        // read the file without holding the lock, other threads may load (or even finish loading) the same model meanwhile
+        WorldModel* worldmodel = new WorldModel();
+        if (!worldmodel->readFile(basepath + filename + ".vmo"))
+        {
+            VMAP_ERROR_LOG("misc", "VMapManager2: could not load '%s%s.vmo'", basepath.c_str(), filename.c_str());
+            delete worldmodel;
+            return nullptr;
+        }
 
-            worldmodel->Flags = flags;
+        worldmodel->Flags = flags;
 
-            model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel>(filename, ManagedModel())).first;
+        std::lock_guard<std::mutex> lock(shard.Lock);
+
+        ModelFileMap::iterator model = shard.Models.find(filename);
+        if (model == shard.Models.end())
+        {
+            VMAP_DEBUG_LOG("maps", "VMapManager2: loading file '%s%s'", basepath.c_str(), filename.c_str());
+            model = shard.Models.emplace(filename, ManagedModel()).first;
             model->second.setModel(worldmodel);
         }
+        else
+            delete worldmodel;
+
         model->second.incRefCount();
         return model->second.getModel();
     }
 
     void VMapManager2::releaseModelInstance(const std::string &filename)
     {
-        //! Critical section, thread safe access to iLoadedModelFiles
-        std::lock_guard<std::mutex> lock(LoadedModelFilesLock);
+        ModelFileShard& shard = getModelFileShard(filename);
+
+        WorldModel* unloadedModel = nullptr;
 
-        ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
-        if (model == iLoadedModelFiles.end())
         {
-            VMAP_ERROR_LOG("misc", "VMapManager2: trying to unload non-loaded file '%s'", filename.c_str());
-            return;
+            //! Critical section, thread safe access to this shard of iLoadedModelFiles
+            std::lock_guard<std::mutex> lock(shard.Lock);
+
+            ModelFileMap::iterator model = shard.Models.find(filename);
+            if (model == shard.Models.end())
+            {
+                VMAP_ERROR_LOG("misc", "VMapManager2: trying to unload non-loaded file '%s'", filename.c_str());
+                return;
+            }
+            if (model->second.decRefCount() == 0)
+            {
+                VMAP_DEBUG_LOG("maps", "VMapManager2: unloading file '%s'", filename.c_str());
+                unloadedModel = model->second.getModel();
+                shard.Models.erase(model);
+            }
         }
-        if (model->second.decRefCount() == 0)
+
+        delete unloadedModel;
+    }
+
+    std::size_t VMapManager2::getLoadedModelCount()
+    {
+        std::size_t count = 0;
+        for (ModelFileShard& shard : iLoadedModelFiles)
         {
-            VMAP_DEBUG_LOG("maps", "VMapManager2: unloading file '%s'", filename.c_str());
-            delete model->second.getModel();
-            iLoadedModelFiles.erase(model);
+            std::lock_guard<std::mutex> lock(shard.Lock);
+            count += shard.Models.size();
         }
+
+        return count;
     }
 
     LoadResult VMapManager2::existsMap(char const* basePath, unsigned int mapId, int x, int y)
@@ -18,6 +18,7 @@
 #ifndef _VMAPMANAGER2_H
 #define _VMAPMANAGER2_H
 
+#include <array>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -77,12 +78,21 @@ namespace VMAP
     class TC_COMMON_API VMapManager2 : public IVMapManager
     {
         protected:
+            // Loaded models are split by file name hash so tiles of different maps can be loaded in parallel
+            struct alignas(64) ModelFileShard
+            {
+                ModelFileMap Models;
+                std::mutex Lock;
+            };
+
+            static constexpr std::size_t MODEL_FILE_SHARD_COUNT = 64;
+
             // Tree to check collision
-            ModelFileMap iLoadedModelFiles;
+            std::array<ModelFileShard, MODEL_FILE_SHARD_COUNT> iLoadedModelFiles;
             InstanceTreeMap iInstanceMapTrees;
             bool thread_safe_environment;
-            // Mutex for iLoadedModelFiles
-            std::mutex LoadedModelFilesLock;
+
+            ModelFileShard& getModelFileShard(std::string const& filename);
 
             bool _loadMap(uint32 mapId, const std::string& basePath, uint32 tileX, uint32 tileY);
             /* void _unloadMap(uint32 pMapId, uint32 x, uint32 y); */
@@ -107,6 +117,7 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+            void isInLineOfSight(unsigned int mapId, LineOfSightRay* rays, uint32 count, ModelIgnoreFlags ignoreFlags) override;
             /**
             fill the hit pos and return true, if an object was hit
             */
@@ -121,6 +132,7 @@ namespace VMAP
 
             WorldModel* acquireModelInstance(const std::string& basepath, const std::string& filename, uint32 flags = 0);
             void releaseModelInstance(const std::string& filename);
+            std::size_t getLoadedModelCount();
 
             // what's the use of this? o.O
             virtual std::string getDirFileName(unsigned int mapId, int /*x*/, int /*y*/) const override
@@ -171,6 +171,44 @@ namespace VMAP
 
         return true;
     }
+
+    void StaticMapTree::isInLineOfSight(Vector3 const* pos1, Vector3 const* pos2, bool* results, uint32 count, ModelIgnoreFlags ignoreFlags) const
+    {
+        G3D::Ray rays[BIH::RAY_PACKET_SIZE];
+        float maxDists[BIH::RAY_PACKET_SIZE];
+        uint32 rayIndexes[BIH::RAY_PACKET_SIZE];
+        uint32 rayCount = 0;
+        count = std::min(count, BIH::RAY_PACKET_SIZE);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            // same special cases as the single ray query
+            float maxDist = (pos2[i] - pos1[i]).magnitude();
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            results[i] = true;
+            if (maxDist < 1e-10f)
+                continue;
+
+            rays[rayCount] = G3D::Ray::fromOriginAndDirection(pos1[i], (pos2[i] - pos1[i]) / maxDist);
+            maxDists[rayCount] = maxDist;
+            rayIndexes[rayCount] = i;
+            ++rayCount;
+        }
+
+        if (!rayCount)
+            return;
+
+        MapRayCallback intersectionCallBack(iTreeValues, ignoreFlags);
+        uint32 hits = iTree.intersectRayPacket(rays, maxDists, rayCount, intersectionCallBack);
+        for (uint32 i = 0; i < rayCount; ++i)
+            if (hits & (1 << i))
+                results[rayIndexes[i]] = false;
+    }
+
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
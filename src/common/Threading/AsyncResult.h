@@ -0,0 +1,265 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AsyncResult_h__
+#define AsyncResult_h__
+
+#include "Define.h"
+#include "Errors.h"
+#include "MPSCQueue.h"
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+class AsyncCompletionQueue;
+
+namespace Trinity
+{
+namespace Impl
+{
+// Shared state between an AsyncPromise and its AsyncFuture
+// Unlike std::future it can push itself to a completion queue once the value is set
+// so consumers never have to poll pending results
+class AsyncStateBase
+{
+public:
+    AsyncStateBase() : _refCount(1), _status(STATUS_PENDING), _token(0)
+    {
+        CompletionLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    virtual ~AsyncStateBase() = default;
+
+    void AddRef()
+    {
+        _refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Release()
+    {
+        if (_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete this;
+    }
+
+    bool IsReady() const { return _status.load(std::memory_order_acquire) == STATUS_READY; }
+
+    // Producer side, called exactly once after the value was stored
+    inline void MarkReady();
+
+    // Consumer side, token is pushed to queue once the state becomes ready (immediately if it already is)
+    inline void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token);
+
+    uint64 GetToken() const { return _token; }
+
+    std::atomic<AsyncStateBase*> CompletionLink;
+
+private:
+    enum Status : uint8
+    {
+        STATUS_PENDING,
+        STATUS_WATCHED,
+        STATUS_READY
+    };
+
+    AsyncStateBase(AsyncStateBase const&) = delete;
+    AsyncStateBase& operator=(AsyncStateBase const&) = delete;
+
+    std::atomic<uint32> _refCount;
+    std::atomic<uint8> _status;
+    std::shared_ptr<AsyncCompletionQueue> _queue;
+    uint64 _token;
+};
+
+template<typename T>
+class AsyncState : public AsyncStateBase
+{
+public:
+    T Value;
+};
+
+template<>
+class AsyncState<void> : public AsyncStateBase
+{
+};
+}
+}
+
+// Multiple producer, single consumer queue of completed async results
+// Only the consumer thread may call Dequeue
+class AsyncCompletionQueue
+{
+public:
+    AsyncCompletionQueue() = default;
+
+    ~AsyncCompletionQueue()
+    {
+        uint64 token;
+        while (Dequeue(token))
+            ;
+    }
+
+    void Enqueue(Trinity::Impl::AsyncStateBase* state)
+    {
+        state->AddRef();
+        _queue.Enqueue(state);
+    }
+
+    bool Dequeue(uint64& token)
+    {
+        Trinity::Impl::AsyncStateBase* state;
+        if (!_queue.Dequeue(state))
+            return false;
+
+        token = state->GetToken();
+        state->Release();
+        return true;
+    }
+
+private:
+    AsyncCompletionQueue(AsyncCompletionQueue const&) = delete;
+    AsyncCompletionQueue& operator=(AsyncCompletionQueue const&) = delete;
+
+    MPSCQueue<Trinity::Impl::AsyncStateBase, &Trinity::Impl::AsyncStateBase::CompletionLink> _queue;
+};
+
+void Trinity::Impl::AsyncStateBase::MarkReady()
+{
+    if (_status.exchange(STATUS_READY, std::memory_order_acq_rel) != STATUS_WATCHED)
+        return;
+
+    // consumer does not touch _queue after it successfully started watching
+    std::shared_ptr<AsyncCompletionQueue> queue = std::move(_queue);
+    queue->Enqueue(this);
+}
+
+void Trinity::Impl::AsyncStateBase::NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+{
+    _token = token;
+    _queue = std::move(queue);
+
+    uint8 expected = STATUS_PENDING;
+    if (_status.compare_exchange_strong(expected, STATUS_WATCHED, std::memory_order_acq_rel))
+        return;
+
+    // already completed, nothing else will ever push this state
+    std::shared_ptr<AsyncCompletionQueue> readyQueue = std::move(_queue);
+    readyQueue->Enqueue(this);
+}
+
+template<typename T>
+class AsyncFuture
+{
+public:
+    AsyncFuture() : _state(nullptr) { }
+    explicit AsyncFuture(Trinity::Impl::AsyncState<T>* state) : _state(state)
+    {
+        _state->AddRef();
+    }
+
+    AsyncFuture(AsyncFuture&& right) noexcept : _state(std::exchange(right._state, nullptr)) { }
+
+    AsyncFuture& operator=(AsyncFuture&& right) noexcept
+    {
+        if (this != &right)
+        {
+            Reset();
+            _state = std::exchange(right._state, nullptr);
+        }
+        return *this;
+    }
+
+    ~AsyncFuture() { Reset(); }
+
+    bool Valid() const { return _state != nullptr; }
+    bool IsReady() const { return _state && _state->IsReady(); }
+
+    // Consumes the value, future is no longer valid afterwards
+    T Get()
+    {
+        ASSERT(IsReady(), "Attempted to retrieve the value of an async result that is not ready yet");
+        Trinity::Impl::AsyncState<T>* state = std::exchange(_state, nullptr);
+        if constexpr (std::is_void_v<T>)
+            state->Release();
+        else
+        {
+            T value = std::move(state->Value);
+            state->Release();
+            return value;
+        }
+    }
+
+    // Must be called at most once per future
+    void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+    {
+        ASSERT(_state);
+        _state->NotifyOnReady(std::move(queue), token);
+    }
+
+private:
+    AsyncFuture(AsyncFuture const&) = delete;
+    AsyncFuture& operator=(AsyncFuture const&) = delete;
+
+    void Reset()
+    {
+        if (_state)
+            std::exchange(_state, nullptr)->Release();
+    }
+
+    Trinity::Impl::AsyncState<T>* _state;
+};
+
+template<typename T>
+class AsyncPromise
+{
+public:
+    AsyncPromise() : _state(nullptr) { }
+
+    ~AsyncPromise()
+    {
+        if (_state)
+            _state->Release();
+    }
+
+    // Shared state is only allocated when someone is interested in the result
+    AsyncFuture<T> GetFuture()
+    {
+        ASSERT(!_state, "Future already retrieved");
+        _state = new Trinity::Impl::AsyncState<T>();
+        return AsyncFuture<T>(_state);
+    }
+
+    template<typename... Args>
+    void SetValue(Args&&... args)
+    {
+        if (!_state)
+            return;
+
+        if constexpr (!std::is_void_v<T>)
+            _state->Value = T(std::forward<Args>(args)...);
+
+        _state->MarkReady();
+    }
+
+private:
+    AsyncPromise(AsyncPromise const&) = delete;
+    AsyncPromise& operator=(AsyncPromise const&) = delete;
+
+    Trinity::Impl::AsyncState<T>* _state;
+};
+
+#endif // AsyncResult_h__
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DistributedSharedMutex.h"
+#include <atomic>
+
+void Trinity::DistributedSharedMutex::lock()
+{
+    // always in the same order, two writers can not deadlock
+    for (Slot& slot : _slots)
+        slot.Mutex.lock();
+}
+
+bool Trinity::DistributedSharedMutex::try_lock()
+{
+    for (std::size_t i = 0; i < _slots.size(); ++i)
+    {
+        if (!_slots[i].Mutex.try_lock())
+        {
+            while (i > 0)
+                _slots[--i].Mutex.unlock();
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Trinity::DistributedSharedMutex::unlock()
+{
+    for (Slot& slot : _slots)
+        slot.Mutex.unlock();
+}
+
+std::size_t Trinity::DistributedSharedMutex::GetThreadSlot()
+{
+    static std::atomic<std::size_t> nextSlot(0);
+    thread_local std::size_t const slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SlotCount;
+    return slot;
+}
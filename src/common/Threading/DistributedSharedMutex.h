@@ -0,0 +1,60 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef DistributedSharedMutex_h__
+#define DistributedSharedMutex_h__
+
+#include "Define.h"
+#include <array>
+#include <shared_mutex>
+
+namespace Trinity
+{
+// Shared mutex for data that is read from many threads and rarely modified
+// Every thread takes shared ownership through its own cache line, so readers never contend with each other,
+// exclusive ownership locks all slots. Meets the SharedMutex requirements (usable with std::shared_lock and std::unique_lock)
+// but shared ownership must be released by the thread that acquired it
+class TC_COMMON_API DistributedSharedMutex
+{
+public:
+    static constexpr std::size_t SlotCount = 32;
+
+    DistributedSharedMutex() = default;
+
+    DistributedSharedMutex(DistributedSharedMutex const&) = delete;
+    DistributedSharedMutex& operator=(DistributedSharedMutex const&) = delete;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared() { _slots[GetThreadSlot()].Mutex.lock_shared(); }
+    bool try_lock_shared() { return _slots[GetThreadSlot()].Mutex.try_lock_shared(); }
+    void unlock_shared() { _slots[GetThreadSlot()].Mutex.unlock_shared(); }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::shared_mutex Mutex;
+    };
+
+    static std::size_t GetThreadSlot();
+
+    std::array<Slot, SlotCount> _slots;
+};
+}
+
+#endif // DistributedSharedMutex_h__
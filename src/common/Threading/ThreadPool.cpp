@@ -0,0 +1,91 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadPool.h"
+
+void Trinity::ThreadPool::Start(std::size_t numThreads)
+{
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.emplace_back(&ThreadPool::WorkerThread, this);
+}
+
+void Trinity::ThreadPool::Stop()
+{
+    if (!IsStarted())
+        return;
+
+    Wait();
+
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+}
+
+void Trinity::ThreadPool::PostWork(std::function<void()> work)
+{
+    if (!IsStarted())
+    {
+        work();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        ++_pendingWork;
+    }
+
+    _queue.Push(new std::function<void()>(std::move(work)));
+}
+
+void Trinity::ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    while (_pendingWork > 0)
+        _condition.wait(lock);
+}
+
+void Trinity::ThreadPool::WorkFinished()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    --_pendingWork;
+
+    _condition.notify_all();
+}
+
+void Trinity::ThreadPool::WorkerThread()
+{
+    while (true)
+    {
+        std::function<void()>* work = nullptr;
+
+        _queue.WaitAndPop(work);
+
+        // queue was cancelled
+        if (!work)
+            return;
+
+        (*work)();
+        delete work;
+
+        WorkFinished();
+    }
+}
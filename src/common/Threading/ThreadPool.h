@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ThreadPool_h__
+#define ThreadPool_h__
+
+#include "Define.h"
+#include "ProducerConsumerQueue.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Trinity
+{
+// Fork-join worker pool for splitting a single tick's work across threads
+// Work posted while the pool is not started is executed immediately on the calling thread
+class TC_COMMON_API ThreadPool
+{
+public:
+    ThreadPool() : _pendingWork(0) { }
+    ~ThreadPool() { Stop(); }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    void Start(std::size_t numThreads);
+    void Stop();
+
+    bool IsStarted() const { return !_workerThreads.empty(); }
+    std::size_t GetThreadCount() const { return _workerThreads.size(); }
+
+    void PostWork(std::function<void()> work);
+
+    // Blocks until all work posted so far has finished executing
+    void Wait();
+
+private:
+    void WorkerThread();
+    void WorkFinished();
+
+    ProducerConsumerQueue<std::function<void()>*> _queue;
+    std::vector<std::thread> _workerThreads;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::size_t _pendingWork;
+};
+}
+
+#endif // ThreadPool_h__
@@ -19,23 +19,32 @@
 #define AsyncCallbackProcessor_h__
 
 #include "Define.h"
-#include <algorithm>
-#include <vector>
+#include "AsyncResult.h"
+#include <memory>
+#include <unordered_map>
 
 //template <class T>
-//concept AsyncCallback = requires(T t) { { t.InvokeIfReady() } -> std::convertible_to<bool> };
+//concept AsyncCallback = requires(T t, std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+//{
+//    { t.InvokeIfReady() } -> std::convertible_to<bool>;
+//    t.NotifyOnReady(queue, token);
+//};
 
+// Callbacks register themselves on a completion queue owned by the processor,
+// each tick only the callbacks whose results were pushed to that queue are touched
 template<typename T> // requires AsyncCallback<T>
 class AsyncCallbackProcessor
 {
 public:
-    AsyncCallbackProcessor() = default;
+    AsyncCallbackProcessor() : _completions(std::make_shared<AsyncCompletionQueue>()), _nextToken(0) { }
     ~AsyncCallbackProcessor() = default;
 
     T& AddCallback(T&& query)
     {
-        _callbacks.emplace_back(std::move(query));
-        return _callbacks.back();
+        uint64 token = ++_nextToken;
+        T& callback = _callbacks.emplace(token, std::move(query)).first->second;
+        callback.NotifyOnReady(_completions, token);
+        return callback;
     }
 
     void ProcessReadyCallbacks()
@@ -43,21 +52,31 @@ public:
         if (_callbacks.empty())
             return;
 
-        std::vector<T> updateCallbacks{ std::move(_callbacks) };
-
-        updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [](T& callback)
+        uint64 token;
+        while (_completions->Dequeue(token))
         {
-            return callback.InvokeIfReady();
-        }), updateCallbacks.end());
+            auto itr = _callbacks.find(token);
+            if (itr == _callbacks.end())
+                continue;
 
-        _callbacks.insert(_callbacks.end(), std::make_move_iterator(updateCallbacks.begin()), std::make_move_iterator(updateCallbacks.end()));
+            // callbacks may add new callbacks to this processor, element references stay valid across rehashing
+            T& callback = itr->second;
+            if (callback.InvokeIfReady())
+                _callbacks.erase(token);
+            else
+                callback.NotifyOnReady(_completions, token); // chained query
+        }
     }
 
+    std::size_t GetPendingCallbackCount() const { return _callbacks.size(); }
+
 private:
     AsyncCallbackProcessor(AsyncCallbackProcessor const&) = delete;
     AsyncCallbackProcessor& operator=(AsyncCallbackProcessor const&) = delete;
 
-    std::vector<T> _callbacks;
+    std::shared_ptr<AsyncCompletionQueue> _completions;
+    std::unordered_map<uint64, T> _callbacks;
+    uint64 _nextToken;
 };
 
 #endif // AsyncCallbackProcessor_h__
@@ -20,22 +20,28 @@
 
 #include "Define.h"
 #include "Duration.h"
-#include <map>
+#include <utility>
+#include <vector>
 
 class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * First: Time as TimePoint when the event should occur.
+    * Second: The event data as uint32.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
     * - Bit 16 - 23: Group
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
+    *
+    * Kept sorted in reverse execution order so the next event is at the back,
+    * events with equal time execute in the order they were scheduled.
+    * AIs only keep a handful of events so a flat vector beats tree nodes.
     */
-    typedef std::multimap<TimePoint, uint32> EventStore;
+    typedef std::pair<TimePoint, uint32> EventEntry;
+    typedef std::vector<EventEntry> EventStore;
 
 public:
     EventMap() : _time(TimePoint::min()), _phase(0), _lastEvent(0) { }
@@ -262,6 +268,12 @@ private:
     * @brief Stores information on the most recently executed event
     */
     uint32 _lastEvent;
+
+    /**
+    * @name Insert
+    * @brief Inserts an event after all events that are scheduled for the same or earlier time.
+    */
+    void Insert(TimePoint time, uint32 eventData);
 };
 
 #endif // _EVENT_MAP_H_
@@ -17,6 +17,8 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
+#include <vector>
 
 void BasicEvent::ScheduleAbort()
 {
@@ -42,13 +44,13 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    std::multimap<uint64, BasicEvent*>::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    m_events.Advance(m_time);
+
+    // main event loop, events added while executing that are already due run in this update too
+    while (Trinity::TimerWheelNode* node = m_events.PopDue())
     {
-        // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        // get event, it is already removed from queue
+        BasicEvent* event = static_cast<BasicEvent*>(node);
 
         if (event->IsRunning())
         {
@@ -81,33 +83,41 @@ void EventProcessor::Update(uint32 p_time)
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    if (m_events.Empty())
+        return;
+
+    // abort in execution order
+    std::vector<BasicEvent*> events;
+    events.reserve(m_events.Size());
+    m_events.ForEach([&events](Trinity::TimerWheelNode* node)
+    {
+        events.push_back(static_cast<BasicEvent*>(node));
+    });
+
+    std::sort(events.begin(), events.end(), [](BasicEvent const* left, BasicEvent const* right)
+    {
+        return left->FiresBefore(right);
+    });
+
+    for (BasicEvent* event : events)
     {
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
         // Skip non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
-        {
-            ++itr;
+        if (!force && !event->IsDeletable())
             continue;
-        }
 
-        delete itr->second;
+        if (m_events.Contains(event))
+            m_events.Unschedule(event);
 
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
     }
-
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_addtime)
@@ -115,19 +125,15 @@ void EventProcessor::AddEvent(BasicEvent* event, Milliseconds e_time, bool set_a
     if (set_addtime)
         event->m_addTime = m_time;
     event->m_execTime = e_time.count();
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time.count(), event));
+    m_events.Schedule(event, e_time.count());
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != event)
-            continue;
+    if (!m_events.Contains(event))
+        return;
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.insert(std::pair<uint64, BasicEvent*>(newTime.count(), event));
-        break;
-    }
+    event->m_execTime = newTime.count();
+    m_events.Unschedule(event);
+    m_events.Schedule(event, newTime.count());
 }
@@ -22,14 +22,14 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include "TimerWheel.h"
 #include <type_traits>
 
 class EventProcessor;
 
 // Note. All times are in milliseconds here.
 
-class TC_COMMON_API BasicEvent
+class TC_COMMON_API BasicEvent : private Trinity::TimerWheelNode
 {
         friend class EventProcessor;
 
@@ -114,7 +114,9 @@ class TC_COMMON_API EventProcessor
 
     protected:
         uint64 m_time;
-        std::multimap<uint64, BasicEvent*> m_events;
+
+        // 1ms resolution, levels span 64ms, 4s and 262s, anything further is kept in the overflow list
+        Trinity::TimerWheel<6, 3> m_events;
 };
 
 #endif
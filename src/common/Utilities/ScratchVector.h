@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SCRATCHVECTOR_H
+#define TRINITY_SCRATCHVECTOR_H
+
+#include "Define.h"
+#include <memory>
+#include <vector>
+
+namespace Trinity
+{
+    /*
+     * Empty std::vector borrowed from a pool owned by the calling thread and returned, cleared, when the
+     * ScratchVector goes out of scope. Vectors keep their capacity between uses so temporary lists built
+     * over and over (e.g. spell target searches) stop allocating once the pool has warmed up.
+     * ScratchVectors of the same type may be nested, each takes the next vector of the pool.
+     */
+    template<typename T>
+    class ScratchVector
+    {
+        struct Pool
+        {
+            std::vector<std::unique_ptr<std::vector<T>>> Vectors;
+            std::size_t Used = 0;
+        };
+
+    public:
+        ScratchVector() : _vector(Acquire()) { }
+        ~ScratchVector()
+        {
+            _vector->clear();
+            --GetPool().Used;
+        }
+
+        ScratchVector(ScratchVector const&) = delete;
+        ScratchVector& operator=(ScratchVector const&) = delete;
+
+        std::vector<T>& operator*() { return *_vector; }
+        std::vector<T>* operator->() { return _vector; }
+
+    private:
+        static Pool& GetPool()
+        {
+            static thread_local Pool pool;
+            return pool;
+        }
+
+        static std::vector<T>* Acquire()
+        {
+            Pool& pool = GetPool();
+            if (pool.Used == pool.Vectors.size())
+                pool.Vectors.push_back(std::make_unique<std::vector<T>>());
+
+            return pool.Vectors[pool.Used++].get();
+        }
+
+        std::vector<T>* _vector;
+    };
+}
+
+#endif // TRINITY_SCRATCHVECTOR_H
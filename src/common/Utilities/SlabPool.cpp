@@ -0,0 +1,264 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SlabPool.h"
+#include "Errors.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct Trinity::SlabPool::Slab
+{
+    SizeClass* Owner;
+    char* Memory;
+    void* FreeList;     // slots that were freed
+    uint32 Initialized; // slots handed out at least once, the rest of Memory was never touched
+    uint32 Used;
+    Slab* Prev;
+    Slab* Next;
+};
+
+struct Trinity::SlabPool::SizeClass
+{
+    SlabPool* Pool;
+    Arena* Owner;
+    std::size_t ObjectSize;
+    std::size_t SlotSize;
+    Slab* Partial = nullptr;
+    Slab* Full = nullptr;
+    Slab* Empty = nullptr;
+    uint32 SlabCount = 0;
+    std::size_t Live = 0;
+};
+
+// aligned to a cache line so arenas used by different threads do not share one
+struct alignas(64) Trinity::SlabPool::Arena
+{
+    std::mutex Lock;
+    std::vector<SizeClass*> SizeClasses;
+    uint64 Allocations = 0;
+};
+
+namespace
+{
+    // stored in front of every object so Deallocate finds its slab without knowing the pool
+    struct alignas(std::max_align_t) SlotHeader
+    {
+        void* Slab;
+    };
+
+    template<typename T>
+    void Link(T*& head, T* node)
+    {
+        node->Prev = nullptr;
+        node->Next = head;
+        if (head)
+            head->Prev = node;
+        head = node;
+    }
+
+    template<typename T>
+    void Unlink(T*& head, T* node)
+    {
+        if (node->Prev)
+            node->Prev->Next = node->Next;
+        else
+            head = node->Next;
+
+        if (node->Next)
+            node->Next->Prev = node->Prev;
+    }
+
+    std::size_t RoundUp(std::size_t size, std::size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+Trinity::SlabPool::SlabPool(std::string name, uint32 slotsPerSlab, uint32 arenaCount) : _name(std::move(name)), _slotsPerSlab(slotsPerSlab),
+    _arenaCount(arenaCount ? arenaCount : std::max(1u, std::thread::hardware_concurrency())), _arenas(new Arena[_arenaCount])
+{
+    ASSERT(slotsPerSlab > 0);
+}
+
+Trinity::SlabPool::~SlabPool()
+{
+    for (uint32 i = 0; i < _arenaCount; ++i)
+    {
+        for (SizeClass* sizeClass : _arenas[i].SizeClasses)
+        {
+            // objects still alive keep their slabs, leak them instead of leaving dangling objects
+            if (sizeClass->Live)
+                continue;
+
+            for (Slab* slab = sizeClass->Partial; slab;)
+            {
+                Slab* next = slab->Next;
+                ::operator delete(slab->Memory);
+                delete slab;
+                slab = next;
+            }
+
+            if (sizeClass->Empty)
+            {
+                ::operator delete(sizeClass->Empty->Memory);
+                delete sizeClass->Empty;
+            }
+
+            delete sizeClass;
+        }
+    }
+}
+
+Trinity::SlabPool::Arena& Trinity::SlabPool::GetThreadArena()
+{
+    // threads are spread over the arenas in the order they first allocate from any pool
+    static std::atomic<uint32> nextThreadIndex(0);
+    thread_local uint32 const threadIndex = nextThreadIndex++;
+    return _arenas[threadIndex % _arenaCount];
+}
+
+void* Trinity::SlabPool::Allocate(std::size_t size)
+{
+    Arena& arena = GetThreadArena();
+    std::lock_guard<std::mutex> lock(arena.Lock);
+
+    SizeClass& sizeClass = GetSizeClass(arena, size);
+    Slab* slab = sizeClass.Partial;
+    if (!slab)
+    {
+        slab = std::exchange(sizeClass.Empty, nullptr);
+        if (!slab)
+        {
+            slab = new Slab();
+            slab->Owner = &sizeClass;
+            slab->Memory = static_cast<char*>(::operator new(sizeClass.SlotSize * _slotsPerSlab));
+            slab->FreeList = nullptr;
+            slab->Initialized = 0;
+            slab->Used = 0;
+            ++sizeClass.SlabCount;
+        }
+
+        Link(sizeClass.Partial, slab);
+    }
+
+    char* slot;
+    if (slab->FreeList)
+    {
+        slot = static_cast<char*>(slab->FreeList);
+        slab->FreeList = *reinterpret_cast<void**>(slot);
+    }
+    else
+        slot = slab->Memory + sizeClass.SlotSize * slab->Initialized++;
+
+    if (++slab->Used == _slotsPerSlab)
+    {
+        Unlink(sizeClass.Partial, slab);
+        Link(sizeClass.Full, slab);
+    }
+
+    ++sizeClass.Live;
+    ++arena.Allocations;
+
+    new (slot) SlotHeader{ slab };
+    return slot + sizeof(SlotHeader);
+}
+
+void Trinity::SlabPool::Deallocate(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    char* slot = static_cast<char*>(ptr) - sizeof(SlotHeader);
+    Slab* slab = static_cast<Slab*>(reinterpret_cast<SlotHeader*>(slot)->Slab);
+    SizeClass* sizeClass = slab->Owner;
+
+    std::lock_guard<std::mutex> lock(sizeClass->Owner->Lock);
+    sizeClass->Pool->Free(slab, slot);
+}
+
+void Trinity::SlabPool::Free(Slab* slab, void* slot)
+{
+    SizeClass& sizeClass = *slab->Owner;
+    *static_cast<void**>(slot) = slab->FreeList;
+    slab->FreeList = slot;
+    --sizeClass.Live;
+
+    // slabs that were full go to the front, they are the most packed ones
+    if (slab->Used-- == _slotsPerSlab)
+    {
+        Unlink(sizeClass.Full, slab);
+        Link(sizeClass.Partial, slab);
+    }
+
+    if (slab->Used)
+        return;
+
+    Unlink(sizeClass.Partial, slab);
+    if (!sizeClass.Empty)
+    {
+        sizeClass.Empty = slab;
+        return;
+    }
+
+    --sizeClass.SlabCount;
+    ::operator delete(slab->Memory);
+    delete slab;
+}
+
+Trinity::SlabPool::SizeClass& Trinity::SlabPool::GetSizeClass(Arena& arena, std::size_t size)
+{
+    std::size_t objectSize = RoundUp(std::max<std::size_t>(size, sizeof(void*)), alignof(std::max_align_t));
+    for (SizeClass* sizeClass : arena.SizeClasses)
+        if (sizeClass->ObjectSize == objectSize)
+            return *sizeClass;
+
+    SizeClass* sizeClass = new SizeClass();
+    sizeClass->Pool = this;
+    sizeClass->Owner = &arena;
+    sizeClass->ObjectSize = objectSize;
+    sizeClass->SlotSize = sizeof(SlotHeader) + objectSize;
+    arena.SizeClasses.push_back(sizeClass);
+    return *sizeClass;
+}
+
+Trinity::SlabPool::Stats Trinity::SlabPool::GetStats() const
+{
+    Stats stats;
+    for (uint32 i = 0; i < _arenaCount; ++i)
+    {
+        Arena& arena = _arenas[i];
+        std::lock_guard<std::mutex> lock(arena.Lock);
+
+        stats.Allocations += arena.Allocations;
+        for (SizeClass const* sizeClass : arena.SizeClasses)
+        {
+            stats.Slabs += sizeClass->SlabCount;
+            stats.Live += sizeClass->Live;
+            stats.Capacity += std::size_t(sizeClass->SlabCount) * _slotsPerSlab;
+            stats.ReservedBytes += std::size_t(sizeClass->SlabCount) * _slotsPerSlab * sizeClass->SlotSize;
+            for (Slab const* slab = sizeClass->Partial; slab; slab = slab->Next)
+                stats.FreeInUsedSlabs += _slotsPerSlab - slab->Used;
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SLABPOOL_H
+#define TRINITY_SLABPOOL_H
+
+#include "Define.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Trinity
+{
+    /*
+     * Thread safe allocator for large, frequently created and destroyed objects (meant to back class specific operator new/delete).
+     * Allocations are rounded up to a size class and served from slabs holding slotsPerSlab objects of that class.
+     * Slots freed in slabs that were full are reused first, keeping objects packed so whole slabs become empty
+     * and can be released. One empty slab per size class is kept for reuse, further ones are returned to the heap.
+     *
+     * Slabs are owned by arenas with a lock each, every thread allocates from the arena picked for it on first use,
+     * so map threads do not wait for each other. A slot is always returned to the arena of its slab,
+     * objects deleted by another thread than the one that created them only take that arena's lock.
+     */
+    class TC_COMMON_API SlabPool
+    {
+    public:
+        struct Stats
+        {
+            uint64 Allocations = 0;     // total allocations since the pool was created
+            uint32 Slabs = 0;
+            std::size_t Live = 0;       // objects currently allocated
+            std::size_t Capacity = 0;   // object slots in all slabs
+            std::size_t FreeInUsedSlabs = 0; // unused slots in slabs that still hold objects (fragmentation)
+            std::size_t ReservedBytes = 0;
+        };
+
+        // arenaCount 0 uses one arena per hardware thread
+        explicit SlabPool(std::string name, uint32 slotsPerSlab = 64, uint32 arenaCount = 0);
+        ~SlabPool();
+
+        SlabPool(SlabPool const&) = delete;
+        SlabPool& operator=(SlabPool const&) = delete;
+
+        void* Allocate(std::size_t size);
+        static void Deallocate(void* ptr);
+
+        std::string const& GetName() const { return _name; }
+        uint32 GetArenaCount() const { return _arenaCount; }
+        Stats GetStats() const;
+
+    private:
+        struct Slab;
+        struct SizeClass;
+        struct Arena;
+
+        Arena& GetThreadArena();
+        SizeClass& GetSizeClass(Arena& arena, std::size_t size);
+        void Free(Slab* slab, void* slot);
+
+        std::string _name;
+        uint32 _slotsPerSlab;
+        uint32 _arenaCount;
+        std::unique_ptr<Arena[]> _arenas;
+    };
+}
+
+#endif // TRINITY_SLABPOOL_H
@@ -0,0 +1,384 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TIMERWHEEL_H
+#define TRINITY_TIMERWHEEL_H
+
+#include "advstd.h"
+#include "Define.h"
+#include "Errors.h"
+#include <limits>
+#include <memory>
+
+namespace Trinity
+{
+/**
+ * Intrusive hook for elements stored in a TimerWheel.
+ * Elements derive from this class so scheduling never allocates.
+ */
+class TimerWheelNode
+{
+    template<uint32 LevelBits, uint32 LevelCount>
+    friend class TimerWheel;
+
+public:
+    TimerWheelNode() : _prev(nullptr), _next(nullptr), _time(0), _sequence(0), _owner(nullptr), _level(0), _slot(0) { }
+
+    TimerWheelNode(TimerWheelNode const&) = delete;
+    TimerWheelNode& operator=(TimerWheelNode const&) = delete;
+
+    bool IsScheduled() const { return _owner != nullptr; }
+    uint64 GetScheduledTime() const { return _time; }
+
+    // order in which scheduled elements fire, equal times keep scheduling order
+    bool FiresBefore(TimerWheelNode const* other) const
+    {
+        return _time < other->_time || (_time == other->_time && _sequence < other->_sequence);
+    }
+
+private:
+    TimerWheelNode* _prev;
+    TimerWheelNode* _next;
+    uint64 _time;
+    uint64 _sequence;
+    void const* _owner;
+    uint8 _level;
+    uint8 _slot;
+};
+
+/**
+ * Hierarchical timing wheel.
+ *
+ * Level 0 has one slot per time unit, every next level has slots spanning a whole rotation of the previous one.
+ * Elements further away than the last level are kept in an overflow list redistributed once per full rotation.
+ * Elements are fired in order of their scheduled time, elements scheduled for the same time fire in the
+ * order they were scheduled in (same as std::multimap).
+ *
+ * The wheel does not own its elements.
+ */
+template<uint32 LevelBits, uint32 LevelCount>
+class TimerWheel
+{
+    static_assert(LevelBits > 0 && LevelBits <= 6, "Slot occupancy of a level must fit in 64 bits");
+    static_assert(LevelCount > 0 && LevelBits * LevelCount < 64, "Wheel range must fit in 64 bits");
+
+    static constexpr uint32 SlotCount = 1 << LevelBits;
+    static constexpr uint64 SlotMask = SlotCount - 1;
+    static constexpr uint32 WheelBits = LevelBits * LevelCount;
+
+    static constexpr uint8 LEVEL_DUE = 0xFE;
+    static constexpr uint8 LEVEL_OVERFLOW = 0xFF;
+
+    struct Level
+    {
+        TimerWheelNode* Slots[SlotCount];
+        uint64 Occupied;
+    };
+
+public:
+    TimerWheel() : _now(0), _sequence(0), _size(0), _wheelSize(0), _dueHead(nullptr), _dueTail(nullptr), _overflow(nullptr) { }
+
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+
+    // current time of the wheel, everything scheduled at or before it is due
+    uint64 GetTime() const { return _now; }
+
+    std::size_t Size() const { return _size; }
+    bool Empty() const { return _size == 0; }
+
+    bool Contains(TimerWheelNode const* node) const { return node->_owner == this; }
+
+    void Schedule(TimerWheelNode* node, uint64 time)
+    {
+        ASSERT(!node->IsScheduled(), "Tried to schedule a timer wheel element twice");
+
+        node->_time = time;
+        node->_sequence = ++_sequence;
+        node->_owner = this;
+        ++_size;
+
+        if (time <= _now)
+            InsertDue(node);
+        else
+            InsertWheel(node);
+    }
+
+    void Unschedule(TimerWheelNode* node)
+    {
+        ASSERT(Contains(node), "Tried to unschedule an element from a timer wheel it does not belong to");
+
+        Unlink(node);
+        node->_owner = nullptr;
+        --_size;
+    }
+
+    // Moves the wheel forward, everything scheduled at or before the given time becomes due
+    void Advance(uint64 time)
+    {
+        while (_now < time)
+        {
+            uint64 next = NextExpiryTime();
+            if (next > time)
+            {
+                _now = time;
+                break;
+            }
+
+            _now = next;
+            ExpireCurrent();
+        }
+    }
+
+    // Returns the first due element (already unscheduled) or nullptr if there is none
+    TimerWheelNode* PopDue()
+    {
+        TimerWheelNode* node = _dueHead;
+        if (node)
+            Unschedule(node);
+        return node;
+    }
+
+    TimerWheelNode* PeekDue() const { return _dueHead; }
+
+    // Calls the functor for every element, in no particular order. The functor must not modify the wheel
+    template<typename Func>
+    void ForEach(Func&& func) const
+    {
+        for (TimerWheelNode* node = _dueHead; node; node = node->_next)
+            func(node);
+
+        if (_levels)
+            for (uint32 level = 0; level < LevelCount; ++level)
+                for (uint32 slot = 0; slot < SlotCount; ++slot)
+                    for (TimerWheelNode* node = _levels[level].Slots[slot]; node; node = node->_next)
+                        func(node);
+
+        for (TimerWheelNode* node = _overflow; node; node = node->_next)
+            func(node);
+    }
+
+private:
+    void AllocateLevels()
+    {
+        _levels = std::make_unique<Level[]>(LevelCount);
+        for (uint32 level = 0; level < LevelCount; ++level)
+        {
+            for (uint32 slot = 0; slot < SlotCount; ++slot)
+                _levels[level].Slots[slot] = nullptr;
+            _levels[level].Occupied = 0;
+        }
+    }
+
+    static void PushFront(TimerWheelNode*& head, TimerWheelNode* node)
+    {
+        node->_prev = nullptr;
+        node->_next = head;
+        if (head)
+            head->_prev = node;
+        head = node;
+    }
+
+    void InsertDue(TimerWheelNode* node)
+    {
+        node->_level = LEVEL_DUE;
+
+        // most elements are appended, walk back from the tail for the ones that are due earlier
+        TimerWheelNode* after = _dueTail;
+        while (after && node->FiresBefore(after))
+            after = after->_prev;
+
+        node->_prev = after;
+        node->_next = after ? after->_next : _dueHead;
+        if (node->_next)
+            node->_next->_prev = node;
+        else
+            _dueTail = node;
+        if (after)
+            after->_next = node;
+        else
+            _dueHead = node;
+    }
+
+    // requires node->_time > _now
+    void InsertWheel(TimerWheelNode* node)
+    {
+        ++_wheelSize;
+
+        uint64 differentBits = node->_time ^ _now;
+        for (uint32 level = 0; level < LevelCount; ++level)
+        {
+            if (differentBits >> (LevelBits * (level + 1)))
+                continue;
+
+            if (!_levels)
+                AllocateLevels();
+
+            uint8 slot = uint8((node->_time >> (LevelBits * level)) & SlotMask);
+            node->_level = uint8(level);
+            node->_slot = slot;
+            PushFront(_levels[level].Slots[slot], node);
+            _levels[level].Occupied |= UI64LIT(1) << slot;
+            return;
+        }
+
+        node->_level = LEVEL_OVERFLOW;
+        PushFront(_overflow, node);
+    }
+
+    void Unlink(TimerWheelNode* node)
+    {
+        if (node->_level == LEVEL_DUE)
+        {
+            if (node->_prev)
+                node->_prev->_next = node->_next;
+            else
+                _dueHead = node->_next;
+
+            if (node->_next)
+                node->_next->_prev = node->_prev;
+            else
+                _dueTail = node->_prev;
+        }
+        else
+        {
+            --_wheelSize;
+
+            TimerWheelNode*& head = node->_level == LEVEL_OVERFLOW ? _overflow : _levels[node->_level].Slots[node->_slot];
+            if (node->_prev)
+                node->_prev->_next = node->_next;
+            else
+                head = node->_next;
+
+            if (node->_next)
+                node->_next->_prev = node->_prev;
+
+            if (!head && node->_level != LEVEL_OVERFLOW)
+                _levels[node->_level].Occupied &= ~(UI64LIT(1) << node->_slot);
+        }
+
+        node->_prev = nullptr;
+        node->_next = nullptr;
+    }
+
+    // Earliest time after _now at which something needs to be expired or cascaded
+    uint64 NextExpiryTime() const
+    {
+        if (!_wheelSize)
+            return std::numeric_limits<uint64>::max();
+
+        if (_levels)
+        {
+            // elements on a level always occupy slots after the current one
+            // and every level covers exactly the time up to the next slot of the level above
+            for (uint32 level = 0; level < LevelCount; ++level)
+            {
+                uint32 shift = LevelBits * level;
+                uint64 current = (_now >> shift) & SlotMask;
+                uint64 later = _levels[level].Occupied & ~((UI64LIT(2) << current) - 1);
+                if (!later)
+                    continue;
+
+                uint64 rotationStart = (_now >> (shift + LevelBits)) << (shift + LevelBits);
+                return rotationStart + (uint64(advstd::countr_zero(later)) << shift);
+            }
+        }
+
+        // only overflow left, it is redistributed when the last level completes a rotation
+        return ((_now >> WheelBits) + 1) << WheelBits;
+    }
+
+    // Moves every element of a detached list either to the due batch or back into the wheel
+    void Redistribute(TimerWheelNode* list, TimerWheelNode*& batch)
+    {
+        while (list)
+        {
+            TimerWheelNode* node = list;
+            list = list->_next;
+
+            if (node->_time <= _now)
+            {
+                // insertion sort by scheduling order, usually only a single element expires at once
+                TimerWheelNode** pos = &batch;
+                while (*pos && (*pos)->_sequence < node->_sequence)
+                    pos = &(*pos)->_next;
+                node->_next = *pos;
+                *pos = node;
+            }
+            else
+                InsertWheel(node);
+        }
+    }
+
+    TimerWheelNode* DetachSlot(uint32 level, uint32 slot)
+    {
+        TimerWheelNode* list = _levels[level].Slots[slot];
+        _levels[level].Slots[slot] = nullptr;
+        _levels[level].Occupied &= ~(UI64LIT(1) << slot);
+        for (TimerWheelNode* node = list; node; node = node->_next)
+            --_wheelSize;
+        return list;
+    }
+
+    void ExpireCurrent()
+    {
+        TimerWheelNode* batch = nullptr;
+
+        // cascade from the top, each level hands its current slot down once the level below completed a rotation
+        if (!(_now & ((UI64LIT(1) << WheelBits) - 1)))
+        {
+            TimerWheelNode* list = _overflow;
+            _overflow = nullptr;
+            for (TimerWheelNode* node = list; node; node = node->_next)
+                --_wheelSize;
+            Redistribute(list, batch);
+        }
+
+        if (_levels)
+        {
+            for (uint32 level = LevelCount - 1; level > 0; --level)
+            {
+                uint32 shift = LevelBits * level;
+                if (_now & ((UI64LIT(1) << shift) - 1))
+                    continue;
+
+                Redistribute(DetachSlot(level, (_now >> shift) & SlotMask), batch);
+            }
+
+            Redistribute(DetachSlot(0, _now & SlotMask), batch);
+        }
+
+        while (batch)
+        {
+            TimerWheelNode* node = batch;
+            batch = batch->_next;
+            InsertDue(node);
+        }
+    }
+
+    uint64 _now;
+    uint64 _sequence;
+    std::size_t _size;
+    std::size_t _wheelSize;                     // elements stored in levels and overflow
+    std::unique_ptr<Level[]> _levels;           // allocated when the first element is scheduled in the future
+    TimerWheelNode* _dueHead;
+    TimerWheelNode* _dueTail;
+    TimerWheelNode* _overflow;
+};
+}
+
+#endif // TRINITY_TIMERWHEEL_H
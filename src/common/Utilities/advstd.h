@@ -19,8 +19,13 @@
 #define TRINITY_ADVSTD_H
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 // this namespace holds implementations of upcoming stdlib features that our c++ version doesn't have yet
 namespace advstd
 {
@@ -38,6 +43,29 @@ namespace advstd
     // C++20 std::type_identity_t
     template <typename T>
     using type_identity_t = typename type_identity<T>::type;
+
+    // C++20 std::countr_zero (64 bit only)
+    inline int countr_zero(std::uint64_t value)
+    {
+        if (!value)
+            return 64;
+
+#ifdef _MSC_VER
+#ifdef _WIN64
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return int(index);
+#else
+        unsigned long index;
+        if (_BitScanForward(&index, std::uint32_t(value)))
+            return int(index);
+        _BitScanForward(&index, std::uint32_t(value >> 32));
+        return int(index) + 32;
+#endif
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
 }
 
 #endif
@@ -76,6 +76,7 @@ void StopDB();
 void SignalHandler(std::weak_ptr<Trinity::Asio::IoContext> ioContextRef, boost::system::error_code const& error, int signalNumber);
 void KeepDatabaseAliveHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> dbPingTimerRef, int32 dbPingInterval, boost::system::error_code const& error);
 void BanExpiryHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> banExpiryCheckTimerRef, int32 banExpiryCheckInterval, boost::system::error_code const& error);
+void DatabaseAutoScalingHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> dbAutoScalingTimerRef, boost::system::error_code const& error);
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, std::string& configService);
 
 int main(int argc, char** argv)
@@ -200,6 +201,11 @@ int main(int argc, char** argv)
     banExpiryCheckTimer->expires_from_now(boost::posix_time::seconds(banExpiryCheckInterval));
     banExpiryCheckTimer->async_wait(std::bind(&BanExpiryHandler, std::weak_ptr<Trinity::Asio::DeadlineTimer>(banExpiryCheckTimer), banExpiryCheckInterval, std::placeholders::_1));
 
+    // Adjust async database connections to queue load every second, like the worldserver does
+    std::shared_ptr<Trinity::Asio::DeadlineTimer> dbAutoScalingTimer = std::make_shared<Trinity::Asio::DeadlineTimer>(*ioContext);
+    dbAutoScalingTimer->expires_from_now(boost::posix_time::seconds(1));
+    dbAutoScalingTimer->async_wait(std::bind(&DatabaseAutoScalingHandler, std::weak_ptr<Trinity::Asio::DeadlineTimer>(dbAutoScalingTimer), std::placeholders::_1));
+
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
     std::shared_ptr<Trinity::Asio::DeadlineTimer> serviceStatusWatchTimer;
     if (m_ServiceStatus != -1)
@@ -216,6 +222,7 @@ int main(int argc, char** argv)
     // Start the io service worker loop
     ioContext->run();
 
+    dbAutoScalingTimer->cancel();
     banExpiryCheckTimer->cancel();
     dbPingTimer->cancel();
 
@@ -290,6 +297,20 @@ void BanExpiryHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> banExpiryCheck
     }
 }
 
+void DatabaseAutoScalingHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> dbAutoScalingTimerRef, boost::system::error_code const& error)
+{
+    if (!error)
+    {
+        if (std::shared_ptr<Trinity::Asio::DeadlineTimer> dbAutoScalingTimer = dbAutoScalingTimerRef.lock())
+        {
+            LoginDatabase.UpdateAutoScaling();
+
+            dbAutoScalingTimer->expires_from_now(boost::posix_time::seconds(1));
+            dbAutoScalingTimer->async_wait(std::bind(&DatabaseAutoScalingHandler, dbAutoScalingTimerRef, std::placeholders::_1));
+        }
+    }
+}
+
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
 void ServiceStatusWatcher(std::weak_ptr<Trinity::Asio::DeadlineTimer> serviceStatusWatchTimerRef, std::weak_ptr<Trinity::Asio::IoContext> ioContextRef, boost::system::error_code const& error)
 {
@@ -23,20 +23,15 @@
 #include <cstring>
 
 /*! Basic, ad-hoc queries. */
-BasicStatementTask::BasicStatementTask(char const* sql, bool async) :
-m_result(nullptr)
+BasicStatementTask::BasicStatementTask(char const* sql, bool async)
 {
     m_sql = strdup(sql);
     m_has_result = async; // If the operation is async, then there's a result
-    if (async)
-        m_result = new QueryResultPromise();
 }
 
 BasicStatementTask::~BasicStatementTask()
 {
     free((void*)m_sql);
-    if (m_has_result && m_result != nullptr)
-        delete m_result;
 }
 
 bool BasicStatementTask::Execute()
@@ -47,11 +42,11 @@ bool BasicStatementTask::Execute()
         if (!result || !result->GetRowCount() || !result->NextRow())
         {
             delete result;
-            m_result->set_value(QueryResult(nullptr));
+            m_result.SetValue(QueryResult(nullptr));
             return false;
         }
 
-        m_result->set_value(QueryResult(result));
+        m_result.SetValue(QueryResult(result));
         return true;
     }
 
@@ -19,6 +19,7 @@
 #define _ADHOCSTATEMENT_H
 
 #include "Define.h"
+#include "AsyncResult.h"
 #include "DatabaseEnvFwd.h"
 #include "SQLOperation.h"
 
@@ -30,12 +31,12 @@ class TC_DATABASE_API BasicStatementTask : public SQLOperation
         ~BasicStatementTask();
 
         bool Execute() override;
-        QueryResultFuture GetFuture() const { return m_result->get_future(); }
+        QueryResultFuture GetFuture() { return m_result.GetFuture(); }
 
     private:
         char const* m_sql;      //- Raw query to be executed
         bool m_has_result;
-        QueryResultPromise* m_result;
+        QueryResultPromise m_result;
 };
 
 #endif
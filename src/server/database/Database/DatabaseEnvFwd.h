@@ -18,16 +18,21 @@
 #ifndef DatabaseEnvFwd_h__
 #define DatabaseEnvFwd_h__
 
-#include <future>
 #include <memory>
 
+template<typename T>
+class AsyncFuture;
+
+template<typename T>
+class AsyncPromise;
+
 struct QueryResultFieldMetadata;
 class Field;
 
 class ResultSet;
 using QueryResult = std::shared_ptr<ResultSet>;
-using QueryResultFuture = std::future<QueryResult>;
-using QueryResultPromise = std::promise<QueryResult>;
+using QueryResultFuture = AsyncFuture<QueryResult>;
+using QueryResultPromise = AsyncPromise<QueryResult>;
 
 class CharacterDatabaseConnection;
 class LoginDatabaseConnection;
@@ -44,8 +49,8 @@ using WorldDatabasePreparedStatement = PreparedStatement<WorldDatabaseConnection
 
 class PreparedResultSet;
 using PreparedQueryResult = std::shared_ptr<PreparedResultSet>;
-using PreparedQueryResultFuture = std::future<PreparedQueryResult>;
-using PreparedQueryResultPromise = std::promise<PreparedQueryResult>;
+using PreparedQueryResultFuture = AsyncFuture<PreparedQueryResult>;
+using PreparedQueryResultPromise = AsyncPromise<PreparedQueryResult>;
 
 class QueryCallback;
 
@@ -56,8 +61,8 @@ using QueryCallbackProcessor = AsyncCallbackProcessor<QueryCallback>;
 
 class TransactionBase;
 
-using TransactionFuture = std::future<bool>;
-using TransactionPromise = std::promise<bool>;
+using TransactionFuture = AsyncFuture<bool>;
+using TransactionPromise = AsyncPromise<bool>;
 
 template<typename T>
 class Transaction;
@@ -72,8 +77,8 @@ using LoginDatabaseTransaction = SQLTransaction<LoginDatabaseConnection>;
 using WorldDatabaseTransaction = SQLTransaction<WorldDatabaseConnection>;
 
 class SQLQueryHolderBase;
-using QueryResultHolderFuture = std::future<void>;
-using QueryResultHolderPromise = std::promise<void>;
+using QueryResultHolderFuture = AsyncFuture<void>;
+using QueryResultHolderPromise = AsyncPromise<void>;
 
 template<typename T>
 class SQLQueryHolder;
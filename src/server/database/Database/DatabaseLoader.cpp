@@ -22,6 +22,7 @@
 #include "Log.h"
 
 #include <mysqld_error.h>
+#include <algorithm>
 
 DatabaseLoader::DatabaseLoader(std::string const& logger, uint32 const defaultUpdateMask)
     : _logger(logger), _autoSetup(sConfigMgr->GetBoolDefault("Updates.AutoSetup", true)),
@@ -53,7 +54,18 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
+        // values below WorkerThreads disable autoscaling
+        int32 const maxAsyncThreads = std::max<int32>(sConfigMgr->GetIntDefault(name + "Database.MaxWorkerThreads", asyncThreads), asyncThreads);
+        if (maxAsyncThreads > 32)
+        {
+            TC_LOG_ERROR(_logger, "%s database: invalid maximum number of worker threads specified. "
+                "Please pick a value up to 32.", name.c_str());
+            return false;
+        }
+
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        pool.SetAutoScaling(uint8(maxAsyncThreads), sConfigMgr->GetIntDefault("Database.AutoScaling.QueueDepth", 100),
+            std::chrono::milliseconds(sConfigMgr->GetIntDefault("Database.AutoScaling.WaitTime", 500)));
         if (uint32 error = pool.Open())
         {
             // Database does not exist
@@ -17,25 +17,31 @@
 
 #include "DatabaseWorker.h"
 #include "SQLOperation.h"
-#include "ProducerConsumerQueue.h"
+#include "SQLOperationQueue.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+DatabaseWorker::DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
     _cancelationToken = false;
+    _stopped = false;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
 DatabaseWorker::~DatabaseWorker()
 {
-    _cancelationToken = true;
-
-    _queue->Cancel();
+    RequestStop();
 
     _workerThread.join();
 }
 
+void DatabaseWorker::RequestStop()
+{
+    _cancelationToken = true;
+
+    _queue->WakeAll();
+}
+
 void DatabaseWorker::WorkerThread()
 {
     if (!_queue)
@@ -43,12 +49,12 @@ void DatabaseWorker::WorkerThread()
 
     for (;;)
     {
-        SQLOperation* operation = nullptr;
-
-        _queue->WaitAndPop(operation);
-
-        if (_cancelationToken || !operation)
+        SQLOperation* operation = _queue->WaitAndPop(_cancelationToken);
+        if (!operation)
+        {
+            _stopped = true;
             return;
+        }
 
         operation->SetConnection(_connection);
         operation->call();
@@ -22,26 +22,28 @@
 #include <atomic>
 #include <thread>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class MySQLConnection;
-class SQLOperation;
+class SQLOperationQueue;
 
 class TC_DATABASE_API DatabaseWorker
 {
     public:
-        DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+        DatabaseWorker(SQLOperationQueue* newQueue, MySQLConnection* connection);
         ~DatabaseWorker();
 
+        //! Asks the worker to exit after its current operation without affecting other workers of the queue
+        void RequestStop();
+        bool HasStopped() const { return _stopped; }
+
     private:
-        ProducerConsumerQueue<SQLOperation*>* _queue;
+        SQLOperationQueue* _queue;
         MySQLConnection* _connection;
 
         void WorkerThread();
         std::thread _workerThread;
 
         std::atomic<bool> _cancelationToken;
+        std::atomic<bool> _stopped;
 
         DatabaseWorker(DatabaseWorker const& right) = delete;
         DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
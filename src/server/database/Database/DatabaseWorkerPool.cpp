@@ -18,6 +18,7 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "Common.h"
+#include "DatabaseWorker.h"
 #include "Errors.h"
 #include "Implementation/LoginDatabase.h"
 #include "Implementation/WorldDatabase.h"
@@ -25,7 +26,6 @@
 #include "Log.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
-#include "ProducerConsumerQueue.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
@@ -33,6 +33,8 @@
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
+#include <functional>
 #ifdef TRINITY_DEBUG
 #include <sstream>
 #include <boost/stacktrace.hpp>
@@ -51,10 +53,30 @@ class PingOperation : public SQLOperation
     }
 };
 
+class ScalingOperation : public SQLOperation
+{
+public:
+    explicit ScalingOperation(std::function<void()>&& callback) : _callback(std::move(callback)) { }
+
+    //! Does not use its own connection, work is done by the pool
+    bool Execute() override
+    {
+        _callback();
+        return true;
+    }
+
+private:
+    std::function<void()> _callback;
+};
+
+//! Number of consecutive idle UpdateAutoScaling calls before a scaled connection is closed again
+static constexpr uint32 AUTOSCALING_IDLE_UPDATES = 60;
+
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _queue(new ProducerConsumerQueue<SQLOperation*>()),
-      _async_threads(0), _synch_threads(0)
+    : _queue(new SQLOperationQueue()),
+      _async_threads(0), _synch_threads(0), _asyncConnectionCount(0), _maxAsyncThreads(0), _scaleQueueDepth(0),
+      _scaleWaitTime(0), _idleScalingUpdates(0), _scalingConnection(false)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
     WPFatal(mysql_get_client_version() >= MIN_MYSQL_CLIENT_VERSION, "TrinityCore does not support MySQL versions below 5.1");
@@ -76,6 +98,15 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
+    _maxAsyncThreads = asyncThreads;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetAutoScaling(uint8 const maxAsyncThreads, uint32 const queueDepthThreshold, std::chrono::milliseconds const waitTimeThreshold)
+{
+    _maxAsyncThreads = std::max(maxAsyncThreads, _async_threads);
+    _scaleQueueDepth = queueDepthThreshold;
+    _scaleWaitTime = waitTimeThreshold;
 }
 
 template <class T>
@@ -111,6 +142,12 @@ void DatabaseWorkerPool<T>::Close()
 
     //! Closes the actualy MySQL connection.
     _connections[IDX_ASYNC].clear();
+    _asyncConnectionCount = 0;
+    _retiredConnections.clear();
+    {
+        std::lock_guard<std::mutex> lock(_scaledConnectionsLock);
+        _scaledConnections.clear();
+    }
 
     TC_LOG_INFO("sql.driver", "Asynchronous connections on DatabasePool '%s' terminated. "
                 "Proceeding with synchronous connections.",
@@ -206,32 +243,35 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql, SQLOperationPriority priority /*= SQL_PRIORITY_NORMAL*/)
 {
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, priority);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
+QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt, SQLOperationPriority priority /*= SQL_PRIORITY_NORMAL*/)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, priority);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
-SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, uint32 maxTasks /*= 1*/)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
+    size_t taskCount = SQLQueryHolderTask::GetTaskCount(holder->GetSize(), maxTasks, _asyncConnectionCount);
+    std::shared_ptr<SQLQueryHolderTask::SharedResult> sharedResult = std::make_shared<SQLQueryHolderTask::SharedResult>(uint32(taskCount));
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
-    QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    QueryResultHolderFuture result = sharedResult->Result.GetFuture();
+    for (size_t i = 0; i < taskCount; ++i)
+        Enqueue(new SQLQueryHolderTask(holder, sharedResult, i, taskCount));
+
     return { std::move(holder), std::move(result) };
 }
 
@@ -390,10 +430,16 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
         }
         else
         {
+            if (type == IDX_ASYNC)
+                connection->StartWorker();
+
             _connections[type].push_back(std::move(connection));
         }
     }
 
+    if (type == IDX_ASYNC)
+        _asyncConnectionCount = uint8(_connections[IDX_ASYNC].size());
+
     // Everything is fine
     return 0;
 }
@@ -408,9 +454,88 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::UpdateAutoScaling()
+{
+    // connections retired earlier are destroyed once their worker finished its last operation
+    _retiredConnections.erase(std::remove_if(_retiredConnections.begin(), _retiredConnections.end(), [](std::unique_ptr<T> const& connection)
+    {
+        return connection->m_worker->HasStopped();
+    }), _retiredConnections.end());
+
+    {
+        std::lock_guard<std::mutex> lock(_scaledConnectionsLock);
+        for (std::unique_ptr<T>& connection : _scaledConnections)
+        {
+            TC_LOG_INFO("sql.driver", "DatabasePool '%s' opened an additional asynchronous connection, " SZFMTD " running.",
+                GetDatabaseName(), _connections[IDX_ASYNC].size() + 1);
+            _connections[IDX_ASYNC].push_back(std::move(connection));
+        }
+
+        _scaledConnections.clear();
+        _asyncConnectionCount = uint8(_connections[IDX_ASYNC].size());
+    }
+
+    if (_maxAsyncThreads <= _async_threads)
+        return;
+
+    std::size_t const depth = _queue->GetDepth();
+    bool const overloaded = (_scaleQueueDepth && depth >= _scaleQueueDepth)
+        || (_scaleWaitTime > std::chrono::milliseconds::zero() && _queue->GetOldestWaitTime() >= _scaleWaitTime);
+
+    if (overloaded)
+    {
+        _idleScalingUpdates = 0;
+        if (_connections[IDX_ASYNC].size() < _maxAsyncThreads && !_scalingConnection.exchange(true))
+            Enqueue(new ScalingOperation([this]() { OpenScaledConnection(); }), SQL_PRIORITY_INTERACTIVE);
+
+        return;
+    }
+
+    if (depth || _connections[IDX_ASYNC].size() <= _async_threads)
+    {
+        _idleScalingUpdates = 0;
+        return;
+    }
+
+    if (++_idleScalingUpdates < AUTOSCALING_IDLE_UPDATES)
+        return;
+
+    _idleScalingUpdates = 0;
+
+    // only connections opened by scaling are closed, the configured ones stay at the front of the container
+    std::unique_ptr<T> connection = std::move(_connections[IDX_ASYNC].back());
+    _connections[IDX_ASYNC].pop_back();
+    _asyncConnectionCount = uint8(_connections[IDX_ASYNC].size());
+    connection->m_worker->RequestStop();
+    _retiredConnections.push_back(std::move(connection));
+
+    TC_LOG_INFO("sql.driver", "DatabasePool '%s' closed an idle asynchronous connection, " SZFMTD " running.",
+        GetDatabaseName(), _connections[IDX_ASYNC].size());
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::OpenScaledConnection()
+{
+    std::unique_ptr<T> connection = std::make_unique<T>(_queue.get(), *_connectionInfo);
+    if (connection->Open())
+        TC_LOG_ERROR("sql.driver", "DatabasePool '%s' failed to open an additional asynchronous connection.", GetDatabaseName());
+    else if (!connection->PrepareStatements())
+        TC_LOG_ERROR("sql.driver", "DatabasePool '%s' failed to prepare statements of an additional asynchronous connection.", GetDatabaseName());
+    else
+    {
+        connection->StartWorker();
+
+        std::lock_guard<std::mutex> lock(_scaledConnectionsLock);
+        _scaledConnections.push_back(std::move(connection));
+    }
+
+    _scalingConnection = false;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, SQLOperationPriority priority /*= SQL_PRIORITY_NORMAL*/)
 {
-    _queue->Push(op);
+    _queue->Push(op, priority);
 }
 
 template <class T>
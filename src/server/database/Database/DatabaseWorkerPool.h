@@ -20,14 +20,15 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "SQLOperationQueue.h"
 #include "StringFormat.h"
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class SQLOperation;
 struct MySQLConnectionInfo;
 
@@ -50,6 +51,10 @@ class DatabaseWorkerPool
 
         void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+        //! Allows UpdateAutoScaling to open up to maxAsyncThreads async connections while the queue holds at least
+        //! queueDepthThreshold operations or its oldest operation waited for waitTimeThreshold.
+        void SetAutoScaling(uint8 const maxAsyncThreads, uint32 const queueDepthThreshold, std::chrono::milliseconds const waitTimeThreshold);
+
         uint32 Open();
 
         void Close();
@@ -149,18 +154,22 @@ class DatabaseWorkerPool
 
         //! Enqueues a query in string format that will set the value of the QueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
-        QueryCallback AsyncQuery(char const* sql);
+        //! SQL_PRIORITY_INTERACTIVE lets the query overtake queued writes, only use it when the result does not depend on them.
+        QueryCallback AsyncQuery(char const* sql, SQLOperationPriority priority = SQL_PRIORITY_NORMAL);
 
         //! Enqueues a query in prepared format that will set the value of the PreparedQueryResultFuture return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        QueryCallback AsyncQuery(PreparedStatement<T>* stmt);
+        //! SQL_PRIORITY_INTERACTIVE lets the query overtake queued writes, only use it when the result does not depend on them.
+        QueryCallback AsyncQuery(PreparedStatement<T>* stmt, SQLOperationPriority priority = SQL_PRIORITY_NORMAL);
 
         //! Enqueues a vector of SQL operations (can be both adhoc and prepared) that will set the value of the QueryResultHolderFuture
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
-        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+        //! Queries of the holder execute in order on one async connection. With maxTasks above 1 they are split between
+        //! up to maxTasks async connections (at most half of them) and may execute in any order.
+        SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder, uint32 maxTasks = 1);
 
         /**
             Transaction context methods.
@@ -206,6 +215,15 @@ class DatabaseWorkerPool
         //! Keeps all our MySQL connections alive, prevent the server from disconnecting us.
         void KeepAlive();
 
+        //! Opens or closes async connections within the limits set by SetAutoScaling depending on queue load.
+        //! Must be called periodically from a single thread.
+        void UpdateAutoScaling();
+
+        uint8 GetAsyncConnectionCount() const { return _asyncConnectionCount; }
+
+        //! Queue stats of the lane since the previous call
+        SQLOperationQueueStats ConsumeQueueStats(SQLOperationPriority priority) { return _queue->ConsumeStats(priority); }
+
         void WarnAboutSyncQueries([[maybe_unused]] bool warn)
         {
 #ifdef TRINITY_DEBUG
@@ -218,7 +236,10 @@ class DatabaseWorkerPool
 
         unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-        void Enqueue(SQLOperation* op);
+        void Enqueue(SQLOperation* op, SQLOperationPriority priority = SQL_PRIORITY_NORMAL);
+
+        //! Executed by an async worker so opening the connection does not block the caller of UpdateAutoScaling
+        void OpenScaledConnection();
 
         //! Gets a free connection in the synchronous connection pool.
         //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -227,11 +248,22 @@ class DatabaseWorkerPool
         char const* GetDatabaseName() const;
 
         //! Queue shared by async worker threads.
-        std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+        std::unique_ptr<SQLOperationQueue> _queue;
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
         uint8 _async_threads, _synch_threads;
+
+        //! Async connection autoscaling, _connections[IDX_ASYNC] is only modified by UpdateAutoScaling after Open
+        std::atomic<uint8> _asyncConnectionCount;
+        uint8 _maxAsyncThreads;
+        uint32 _scaleQueueDepth;
+        std::chrono::milliseconds _scaleWaitTime;
+        uint32 _idleScalingUpdates;
+        std::atomic<bool> _scalingConnection;
+        std::mutex _scaledConnectionsLock;
+        std::vector<std::unique_ptr<T>> _scaledConnections;
+        std::vector<std::unique_ptr<T>> _retiredConnections;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
 #endif
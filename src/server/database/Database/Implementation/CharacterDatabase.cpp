@@ -600,7 +600,7 @@ CharacterDatabaseConnection::CharacterDatabaseConnection(MySQLConnectionInfo& co
 {
 }
 
-CharacterDatabaseConnection::CharacterDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo)
+CharacterDatabaseConnection::CharacterDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo)
 {
 }
 
@@ -520,7 +520,7 @@ public:
 
     //- Constructors for sync and async connections
     CharacterDatabaseConnection(MySQLConnectionInfo& connInfo);
-    CharacterDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo);
+    CharacterDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo);
     ~CharacterDatabaseConnection();
 
     //- Loads database type specific prepared statements
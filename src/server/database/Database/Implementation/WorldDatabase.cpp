@@ -100,7 +100,7 @@ WorldDatabaseConnection::WorldDatabaseConnection(MySQLConnectionInfo& connInfo)
 {
 }
 
-WorldDatabaseConnection::WorldDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo)
+WorldDatabaseConnection::WorldDatabaseConnection(SQLOperationQueue* q, MySQLConnectionInfo& connInfo) : MySQLConnection(q, connInfo)
 {
 }
 
@@ -55,22 +55,25 @@ m_Mysql(nullptr),
 m_connectionInfo(connInfo),
 m_connectionFlags(CONNECTION_SYNCH) { }
 
-MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo) :
 m_reconnecting(false),
 m_prepareError(false),
 m_queue(queue),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(CONNECTION_ASYNC)
-{
-    m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
-}
+m_connectionFlags(CONNECTION_ASYNC) { }
 
 MySQLConnection::~MySQLConnection()
 {
     Close();
 }
 
+void MySQLConnection::StartWorker()
+{
+    ASSERT(m_queue && !m_worker);
+    m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
+}
+
 void MySQLConnection::Close()
 {
     // Stop the worker thread before the statements are cleared
@@ -26,12 +26,9 @@
 #include <string>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class DatabaseWorker;
 class MySQLPreparedStatement;
-class SQLOperation;
+class SQLOperationQueue;
 
 enum ConnectionFlags
 {
@@ -59,12 +56,15 @@ class TC_DATABASE_API MySQLConnection
 
     public:
         MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-        MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+        MySQLConnection(SQLOperationQueue* queue, MySQLConnectionInfo& connInfo);     //! Constructor for asynchronous connections.
         virtual ~MySQLConnection();
 
         virtual uint32 Open();
         void Close();
 
+        //! Starts consuming the async queue, must be called after the connection was opened
+        void StartWorker();
+
         bool PrepareStatements();
 
         bool Execute(char const* sql);
@@ -106,7 +106,7 @@ class TC_DATABASE_API MySQLConnection
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
 
-        ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+        SQLOperationQueue*    m_queue;                      //! Queue shared with other asynchronous connections.
         std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
         MySQLHandle*          m_Mysql;                      //! MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //! Connection info (used for logging)
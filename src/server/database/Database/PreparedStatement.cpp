@@ -121,18 +121,14 @@ void PreparedStatementBase::setNull(const uint8 index)
 
 //- Execution
 PreparedStatementTask::PreparedStatementTask(PreparedStatementBase* stmt, bool async) :
-m_stmt(stmt), m_result(nullptr)
+m_stmt(stmt)
 {
     m_has_result = async; // If it's async, then there's a result
-    if (async)
-        m_result = new PreparedQueryResultPromise();
 }
 
 PreparedStatementTask::~PreparedStatementTask()
 {
     delete m_stmt;
-    if (m_has_result && m_result != nullptr)
-        delete m_result;
 }
 
 bool PreparedStatementTask::Execute()
@@ -143,10 +139,10 @@ bool PreparedStatementTask::Execute()
         if (!result || !result->GetRowCount())
         {
             delete result;
-            m_result->set_value(PreparedQueryResult(nullptr));
+            m_result.SetValue(PreparedQueryResult(nullptr));
             return false;
         }
-        m_result->set_value(PreparedQueryResult(result));
+        m_result.SetValue(PreparedQueryResult(result));
         return true;
     }
 
@@ -19,8 +19,8 @@
 #define _PREPAREDSTATEMENT_H
 
 #include "Define.h"
+#include "AsyncResult.h"
 #include "SQLOperation.h"
-#include <future>
 #include <vector>
 #include <variant>
 
@@ -119,11 +119,11 @@ class TC_DATABASE_API PreparedStatementTask : public SQLOperation
         ~PreparedStatementTask();
 
         bool Execute() override;
-        PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
+        PreparedQueryResultFuture GetFuture() { return m_result.GetFuture(); }
 
     protected:
         PreparedStatementBase* m_stmt;
         bool m_has_result;
-        PreparedQueryResultPromise* m_result;
+        PreparedQueryResultPromise m_result;
 };
 #endif
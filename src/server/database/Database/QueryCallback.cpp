@@ -105,13 +105,13 @@ private:
 };
 
 // Not using initialization lists to work around segmentation faults when compiling with clang without precompiled headers
-QueryCallback::QueryCallback(std::future<QueryResult>&& result)
+QueryCallback::QueryCallback(QueryResultFuture&& result)
 {
     _isPrepared = false;
     Construct(_string, std::move(result));
 }
 
-QueryCallback::QueryCallback(std::future<PreparedQueryResult>&& result)
+QueryCallback::QueryCallback(PreparedQueryResultFuture&& result)
 {
     _isPrepared = true;
     Construct(_prepared, std::move(result));
@@ -181,7 +181,7 @@ bool QueryCallback::InvokeIfReady()
     auto checkStateAndReturnCompletion = [this]()
     {
         _callbacks.pop();
-        bool hasNext = !_isPrepared ? _string.valid() : _prepared.valid();
+        bool hasNext = !_isPrepared ? _string.Valid() : _prepared.Valid();
         if (_callbacks.empty())
         {
             ASSERT(!hasNext);
@@ -198,24 +198,38 @@ bool QueryCallback::InvokeIfReady()
 
     if (!_isPrepared)
     {
-        if (_string.valid() && _string.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        if (_string.IsReady())
         {
             QueryResultFuture f(std::move(_string));
             std::function<void(QueryCallback&, QueryResult)> cb(std::move(callback._string));
-            cb(*this, f.get());
+            cb(*this, f.Get());
             return checkStateAndReturnCompletion();
         }
     }
     else
     {
-        if (_prepared.valid() && _prepared.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        if (_prepared.IsReady())
         {
             PreparedQueryResultFuture f(std::move(_prepared));
             std::function<void(QueryCallback&, PreparedQueryResult)> cb(std::move(callback._prepared));
-            cb(*this, f.get());
+            cb(*this, f.Get());
             return checkStateAndReturnCompletion();
         }
     }
 
     return false;
 }
+
+void QueryCallback::NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+{
+    if (!_isPrepared)
+    {
+        if (_string.Valid())
+            _string.NotifyOnReady(std::move(queue), token);
+    }
+    else
+    {
+        if (_prepared.Valid())
+            _prepared.NotifyOnReady(std::move(queue), token);
+    }
+}
@@ -19,9 +19,9 @@
 #define _QUERY_CALLBACK_H
 
 #include "Define.h"
+#include "AsyncResult.h"
 #include "DatabaseEnvFwd.h"
 #include <functional>
-#include <future>
 #include <list>
 #include <queue>
 #include <utility>
@@ -41,12 +41,15 @@ public:
     QueryCallback&& WithChainingCallback(std::function<void(QueryCallback&, QueryResult)>&& callback);
     QueryCallback&& WithChainingPreparedCallback(std::function<void(QueryCallback&, PreparedQueryResult)>&& callback);
 
-    // Moves std::future from next to this object
+    // Moves AsyncFuture from next to this object
     void SetNextQuery(QueryCallback&& next);
 
     // returns true when completed
     bool InvokeIfReady();
 
+    // pushes token to queue when the current query in chain completes
+    void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token);
+
 private:
     QueryCallback(QueryCallback const& right) = delete;
     QueryCallback& operator=(QueryCallback const& right) = delete;
@@ -21,6 +21,7 @@
 #include "MySQLConnection.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include <algorithm>
 
 bool SQLQueryHolderBase::SetPreparedQueryImpl(size_t index, PreparedStatementBase* stmt)
 {
@@ -43,6 +44,14 @@ PreparedQueryResult SQLQueryHolderBase::GetPreparedResult(size_t index) const
     return m_queries[index].second;
 }
 
+std::chrono::nanoseconds SQLQueryHolderBase::GetQueryTime(size_t index) const
+{
+    ASSERT(index < m_queryTimes.size(), "Query holder time index out of range, tried to access index " SZFMTD " but there are only " SZFMTD " queries",
+        index, m_queryTimes.size());
+
+    return m_queryTimes[index];
+}
+
 void SQLQueryHolderBase::SetPreparedResult(size_t index, PreparedResultSet* result)
 {
     if (result && !result->GetRowCount())
@@ -70,28 +79,56 @@ void SQLQueryHolderBase::SetSize(size_t size)
 {
     /// to optimize push_back, reserve the number of queries about to be executed
     m_queries.resize(size);
+    m_queryTimes.resize(size);
 }
 
 SQLQueryHolderTask::~SQLQueryHolderTask() = default;
 
 bool SQLQueryHolderTask::Execute()
 {
-    /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < m_holder->m_queries.size(); ++i)
+    /// execute this task's share of queries in the holder and pass the results
+    /// every index is only written by one task so no locking is needed
+    for (size_t i = m_firstQuery; i < m_holder->m_queries.size(); i += m_queryStride)
+    {
         if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
-            m_holder->SetPreparedResult(i, m_conn->Query(stmt));
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            m_holder->SetPreparedResult(i, Query(stmt));
+            m_holder->m_queryTimes[i] = std::chrono::steady_clock::now() - start;
+        }
+    }
+
+    if (m_result->PendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_result->Result.SetValue();
 
-    m_result.set_value();
     return true;
 }
 
+size_t SQLQueryHolderTask::GetTaskCount(size_t queryCount, uint32 maxTasks, uint32 asyncConnections)
+{
+    size_t limit = std::min<size_t>(maxTasks, std::max<uint32>(asyncConnections / 2, 1));
+    return std::max<size_t>(std::min(queryCount, limit), 1);
+}
+
+PreparedResultSet* SQLQueryHolderTask::Query(PreparedStatementBase* stmt)
+{
+    return m_conn->Query(stmt);
+}
+
 bool SQLQueryHolderCallback::InvokeIfReady()
 {
-    if (m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    if (m_future.IsReady())
     {
+        m_future.Get();
         m_callback(*m_holder);
         return true;
     }
 
     return false;
 }
+
+void SQLQueryHolderCallback::NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+{
+    if (m_future.Valid())
+        m_future.NotifyOnReady(std::move(queue), token);
+}
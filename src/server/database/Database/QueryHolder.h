@@ -18,7 +18,11 @@
 #ifndef _QUERYHOLDER_H
 #define _QUERYHOLDER_H
 
+#include "AsyncResult.h"
 #include "SQLOperation.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <vector>
 
 class TC_DATABASE_API SQLQueryHolderBase
@@ -26,11 +30,14 @@ class TC_DATABASE_API SQLQueryHolderBase
     friend class SQLQueryHolderTask;
     private:
         std::vector<std::pair<PreparedStatementBase*, PreparedQueryResult>> m_queries;
+        std::vector<std::chrono::nanoseconds> m_queryTimes;
     public:
         SQLQueryHolderBase() = default;
         virtual ~SQLQueryHolderBase();
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         PreparedQueryResult GetPreparedResult(size_t index) const;
+        std::chrono::nanoseconds GetQueryTime(size_t index) const;
         void SetPreparedResult(size_t index, PreparedResultSet* result);
 
     protected:
@@ -47,20 +54,39 @@ public:
     }
 };
 
+//- Executes every queryStride-th query of a holder starting at firstQuery
+//- Queries of holders that allow it are split between multiple tasks to run them on several async connections at once
 class TC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
+    public:
+        //- Shared by all tasks of one holder, the last one to finish completes it
+        struct SharedResult
+        {
+            explicit SharedResult(uint32 pendingTasks) : PendingTasks(pendingTasks) { }
+
+            std::atomic<uint32> PendingTasks;
+            QueryResultHolderPromise Result;
+        };
+
     private:
         std::shared_ptr<SQLQueryHolderBase> m_holder;
-        QueryResultHolderPromise m_result;
+        std::shared_ptr<SharedResult> m_result;
+        size_t m_firstQuery;
+        size_t m_queryStride;
 
     public:
-        explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
-            : m_holder(std::move(holder)) { }
+        SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, std::shared_ptr<SharedResult> result, size_t firstQuery, size_t queryStride)
+            : m_holder(std::move(holder)), m_result(std::move(result)), m_firstQuery(firstQuery), m_queryStride(queryStride) { }
 
         ~SQLQueryHolderTask();
 
         bool Execute() override;
-        QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
+
+        //- Number of tasks a holder of queryCount queries is split into, half of the async connections are left for other work
+        static size_t GetTaskCount(size_t queryCount, uint32 maxTasks, uint32 asyncConnections);
+
+    protected:
+        virtual PreparedResultSet* Query(PreparedStatementBase* stmt);
 };
 
 class TC_DATABASE_API SQLQueryHolderCallback
@@ -80,6 +106,8 @@ public:
 
     bool InvokeIfReady();
 
+    void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token);
+
     std::shared_ptr<SQLQueryHolderBase> m_holder;
     QueryResultHolderFuture m_future;
     std::function<void(SQLQueryHolderBase const&)> m_callback;
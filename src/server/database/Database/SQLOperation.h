@@ -42,6 +42,15 @@ struct SQLElementData
     SQLElementDataType type;
 };
 
+//- Async queue lane of an operation
+enum SQLOperationPriority : uint8
+{
+    SQL_PRIORITY_NORMAL,        //- executed in enqueue order, default for every operation
+    SQL_PRIORITY_INTERACTIVE,   //- may overtake normal operations, only for reads that do not depend on queued writes
+
+    MAX_SQL_PRIORITY
+};
+
 class MySQLConnection;
 
 class TC_DATABASE_API SQLOperation
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLOperationQueue.h"
+#include <algorithm>
+
+SQLOperationQueue::SQLOperationQueue() : _interactiveStreak(0), _shutdown(false)
+{
+}
+
+SQLOperationQueue::~SQLOperationQueue()
+{
+    Cancel();
+}
+
+void SQLOperationQueue::Push(SQLOperation* operation, SQLOperationPriority priority)
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _lanes[priority].Operations.push_back({ operation, std::chrono::steady_clock::now() });
+
+    _condition.notify_one();
+}
+
+SQLOperation* SQLOperationQueue::WaitAndPop(std::atomic<bool> const& cancel)
+{
+    std::unique_lock<std::mutex> lock(_queueLock);
+
+    while (IsEmpty() && !_shutdown && !cancel)
+        _condition.wait(lock);
+
+    if (_shutdown || cancel || IsEmpty())
+        return nullptr;
+
+    Lane& interactive = _lanes[SQL_PRIORITY_INTERACTIVE];
+    Lane& normal = _lanes[SQL_PRIORITY_NORMAL];
+    Lane* lane = &normal;
+    if (!interactive.Operations.empty() && (normal.Operations.empty() || _interactiveStreak < MAX_INTERACTIVE_STREAK))
+    {
+        lane = &interactive;
+        ++_interactiveStreak;
+    }
+    else
+        _interactiveStreak = 0;
+
+    QueuedOperation queued = lane->Operations.front();
+    lane->Operations.pop_front();
+
+    std::chrono::nanoseconds waitTime = std::chrono::steady_clock::now() - queued.QueueTime;
+    ++lane->Stats.Executed;
+    lane->Stats.TotalWaitTime += waitTime;
+    lane->Stats.MaxWaitTime = std::max(lane->Stats.MaxWaitTime, waitTime);
+    return queued.Operation;
+}
+
+void SQLOperationQueue::WakeAll()
+{
+    // lock so a worker between checking its cancel flag and waiting cannot miss the notification
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _condition.notify_all();
+}
+
+void SQLOperationQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+
+    for (Lane& lane : _lanes)
+    {
+        for (QueuedOperation& queued : lane.Operations)
+            delete queued.Operation;
+
+        lane.Operations.clear();
+    }
+
+    _shutdown = true;
+
+    _condition.notify_all();
+}
+
+std::size_t SQLOperationQueue::GetDepth() const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+
+    std::size_t depth = 0;
+    for (Lane const& lane : _lanes)
+        depth += lane.Operations.size();
+
+    return depth;
+}
+
+std::chrono::steady_clock::duration SQLOperationQueue::GetOldestWaitTime() const
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_queueLock);
+
+    std::chrono::steady_clock::duration oldest = std::chrono::steady_clock::duration::zero();
+    for (Lane const& lane : _lanes)
+        if (!lane.Operations.empty())
+            oldest = std::max(oldest, now - lane.Operations.front().QueueTime);
+
+    return oldest;
+}
+
+SQLOperationQueueStats SQLOperationQueue::ConsumeStats(SQLOperationPriority priority)
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+
+    Lane& lane = _lanes[priority];
+    SQLOperationQueueStats stats = lane.Stats;
+    stats.Depth = uint32(lane.Operations.size());
+    lane.Stats = SQLOperationQueueStats();
+    return stats;
+}
+
+bool SQLOperationQueue::IsEmpty() const
+{
+    return std::all_of(_lanes.begin(), _lanes.end(), [](Lane const& lane) { return lane.Operations.empty(); });
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SQLOPERATIONQUEUE_H
+#define _SQLOPERATIONQUEUE_H
+
+#include "Define.h"
+#include "SQLOperation.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+struct SQLOperationQueueStats
+{
+    uint32 Depth = 0;
+    uint32 Executed = 0;
+    std::chrono::nanoseconds TotalWaitTime = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds MaxWaitTime = std::chrono::nanoseconds::zero();
+};
+
+//- Queue shared by async worker threads of one database pool
+//- Interactive operations are served first, normal ones get a turn at least every MAX_INTERACTIVE_STREAK operations
+class TC_DATABASE_API SQLOperationQueue
+{
+public:
+    static constexpr uint32 MAX_INTERACTIVE_STREAK = 8;
+
+    SQLOperationQueue();
+    ~SQLOperationQueue();
+
+    void Push(SQLOperation* operation, SQLOperationPriority priority);
+
+    //- Blocks until an operation is available, returns nullptr once the queue is cancelled or cancel was set
+    SQLOperation* WaitAndPop(std::atomic<bool> const& cancel);
+
+    //- Wakes all waiting workers so they can check their cancel flag
+    void WakeAll();
+
+    //- Deletes all queued operations and releases all workers
+    void Cancel();
+
+    std::size_t GetDepth() const;
+    std::chrono::steady_clock::duration GetOldestWaitTime() const;
+
+    //- Returns stats of the lane collected since the previous call
+    SQLOperationQueueStats ConsumeStats(SQLOperationPriority priority);
+
+private:
+    struct QueuedOperation
+    {
+        SQLOperation* Operation;
+        std::chrono::steady_clock::time_point QueueTime;
+    };
+
+    struct Lane
+    {
+        std::deque<QueuedOperation> Operations;
+        SQLOperationQueueStats Stats;
+    };
+
+    SQLOperationQueue(SQLOperationQueue const&) = delete;
+    SQLOperationQueue& operator=(SQLOperationQueue const&) = delete;
+
+    bool IsEmpty() const;
+
+    mutable std::mutex _queueLock;
+    std::condition_variable _condition;
+    std::array<Lane, MAX_SQL_PRIORITY> _lanes;
+    uint32 _interactiveStreak;
+    bool _shutdown;
+};
+
+#endif
@@ -116,7 +116,7 @@ bool TransactionWithResultTask::Execute()
     int errorCode = TryExecute();
     if (!errorCode)
     {
-        m_result.set_value(true);
+        m_result.SetValue(true);
         return true;
     }
 
@@ -132,7 +132,7 @@ bool TransactionWithResultTask::Execute()
         {
             if (!TryExecute())
             {
-                m_result.set_value(true);
+                m_result.SetValue(true);
                 return true;
             }
 
@@ -144,18 +144,24 @@ bool TransactionWithResultTask::Execute()
 
     // Clean up now.
     CleanupOnFailure();
-    m_result.set_value(false);
+    m_result.SetValue(false);
 
     return false;
 }
 
 bool TransactionCallback::InvokeIfReady()
 {
-    if (m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    if (m_future.IsReady())
     {
-        m_callback(m_future.get());
+        m_callback(m_future.Get());
         return true;
     }
 
     return false;
 }
+
+void TransactionCallback::NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+{
+    if (m_future.Valid())
+        m_future.NotifyOnReady(std::move(queue), token);
+}
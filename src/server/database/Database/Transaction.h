@@ -19,6 +19,7 @@
 #define _TRANSACTION_H
 
 #include "Define.h"
+#include "AsyncResult.h"
 #include "DatabaseEnvFwd.h"
 #include "SQLOperation.h"
 #include "StringFormat.h"
@@ -93,7 +94,7 @@ class TC_DATABASE_API TransactionWithResultTask : public TransactionTask
 public:
     TransactionWithResultTask(std::shared_ptr<TransactionBase> trans) : TransactionTask(trans) { }
 
-    TransactionFuture GetFuture() { return m_result.get_future(); }
+    TransactionFuture GetFuture() { return m_result.GetFuture(); }
 
 protected:
     bool Execute() override;
@@ -116,6 +117,8 @@ public:
 
     bool InvokeIfReady();
 
+    void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token);
+
     TransactionFuture m_future;
     std::function<void(bool)> m_callback;
 };
@@ -18,6 +18,7 @@
 #include "SmartScript.h"
 #include "CellImpl.h"
 #include "ChatTextBuilder.h"
+#include "ConditionMgr.h"
 #include "Creature.h"
 #include "CreatureTextMgr.h"
 #include "CreatureTextMgrImpl.h"
@@ -60,6 +61,7 @@ SmartScript::SmartScript()
     mCurrentPriority = 0;
     mEventSortingRequired = false;
     mNestedEventsCounter = 0;
+    mEventIndexConditionsGeneration = 0;
 }
 
 SmartScript::~SmartScript()
@@ -229,15 +231,22 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     }
     else
     {
-        for (SmartScriptHolder& event : mEvents)
+        // conditions were reloaded, cached condition lists are dangling
+        uint32 conditionsGeneration = sConditionMgr->GetConditionsGeneration();
+        if (mEventIndexConditionsGeneration != conditionsGeneration)
+            BuildEventIndex();
+
+        // SMART_EVENT_LINK events are never in the index, they are only triggered by the event linking to them
+        auto itr = std::lower_bound(mEventIndex.begin(), mEventIndex.end(), uint32(e), [](EventIndexEntry const& entry, uint32 type)
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
+            return entry.Type < type;
+        });
 
-            if (eventType == e)
-                if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
-                    ProcessEvent(event, unit, var0, var1, bvar, spell, gob);
+        for (; itr != mEventIndex.end() && itr->Type == uint32(e); ++itr)
+        {
+            SmartScriptHolder& event = mEvents[itr->Position];
+            if (sConditionMgr->IsObjectMeetingSmartEventConditions(itr->Conditions, unit, GetBaseObject()))
+                ProcessEvent(event, unit, var0, var1, bvar, spell, gob);
         }
     }
 
@@ -3638,6 +3647,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(installevent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        BuildEventIndex();
     }
 }
 
@@ -3733,6 +3743,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     if (mEventSortingRequired)
     {
         SortEvents(mEvents);
+        BuildEventIndex();
         mEventSortingRequired = false;
     }
 
@@ -3795,6 +3806,28 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::BuildEventIndex()
+{
+    mEventIndex.clear();
+    mEventIndex.reserve(mEvents.size());
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        SmartScriptHolder const& event = mEvents[i];
+        if (event.GetEventType() == SMART_EVENT_LINK)
+            continue;
+
+        mEventIndex.push_back({ event.GetEventType(), i, sConditionMgr->GetConditionsForSmartEvent(event.entryOrGuid, event.event_id, event.source_type) });
+    }
+
+    // stable to keep events of the same type in mEvents (priority) order
+    std::stable_sort(mEventIndex.begin(), mEventIndex.end(), [](EventIndexEntry const& left, EventIndexEntry const& right)
+    {
+        return left.Type < right.Type;
+    });
+
+    mEventIndexConditionsGeneration = sConditionMgr->GetConditionsGeneration();
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1;
@@ -3847,6 +3880,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         }
         mEvents.push_back(scriptholder);//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    BuildEventIndex();
 }
 
 void SmartScript::GetScript()
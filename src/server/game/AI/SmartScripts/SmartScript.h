@@ -28,6 +28,7 @@ class SpellInfo;
 class Unit;
 class WorldObject;
 struct AreaTriggerEntry;
+struct Condition;
 
 class TC_GAME_API SmartScript
 {
@@ -102,11 +103,23 @@ class TC_GAME_API SmartScript
         bool IsInPhase(uint32 p) const;
 
         void SortEvents(SmartAIEventList& events);
+        void BuildEventIndex();
         void RaisePriority(SmartScriptHolder& e);
         void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
         SmartAIEventList mEvents;
         SmartAIEventList mInstallEvents;
+
+        // Positions of mEvents ordered by event type and then by position, so ProcessEventsFor only visits
+        // the events it can trigger. Must be rebuilt whenever mEvents is filled or reordered.
+        struct EventIndexEntry
+        {
+            uint32 Type;
+            uint32 Position;
+            std::vector<Condition*> const* Conditions; // resolved once per conditions generation, nullptr if the event has none
+        };
+        std::vector<EventIndexEntry> mEventIndex;
+        uint32 mEventIndexConditionsGeneration;
         SmartAIEventList mTimedActionList;
         ObjectGuid mTimedActionListInvoker;
         bool isProcessingTimedActionList;
@@ -555,11 +555,13 @@ void AuctionHouseMgr::UpdatePendingAuctions()
     }
 }
 
-void AuctionHouseMgr::Update()
+bool AuctionHouseMgr::Update(TimePoint deadline)
 {
-    mHordeAuctions.Update();
-    mAllianceAuctions.Update();
-    mNeutralAuctions.Update();
+    // every house handles at least one expired auction per call, none of them waits until the others caught up
+    bool done = mHordeAuctions.Update(deadline);
+    done = mAllianceAuctions.Update(deadline) && done;
+    done = mNeutralAuctions.Update(deadline) && done;
+    return done;
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -609,14 +611,14 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+bool AuctionHouseObject::Update(TimePoint deadline)
 {
     time_t curTime = GameTime::GetGameTime();
     ///- Handle expired auctions
 
     // If storage is empty, no need to update. next == NULL in this case.
     if (AuctionsMap.empty())
-        return;
+        return true;
 
     // Clear expired throttled players
     for (PlayerGetAllThrottleMap::const_iterator itr = GetAllThrottleMap.begin(); itr != GetAllThrottleMap.end();)
@@ -629,6 +631,7 @@ void AuctionHouseObject::Update()
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
+    bool done = true;
     for (AuctionEntryMap::iterator it = AuctionsMap.begin(); it != AuctionsMap.end();)
     {
         // from auctionhousehandler.cpp, creates auction pointer & player pointer
@@ -662,10 +665,18 @@ void AuctionHouseObject::Update()
 
         sAuctionMgr->RemoveAItem(auction->itemGUIDLow);
         RemoveAuction(auction);
+
+        // mails are the expensive part, the remaining expired auctions are picked up by the next call
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            done = false;
+            break;
+        }
     }
 
     // Run DB changes
     CharacterDatabase.CommitTransaction(trans);
+    return done;
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
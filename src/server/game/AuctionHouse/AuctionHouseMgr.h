@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "Duration.h"
 #include "ObjectGuid.h"
 #include <map>
 #include <set>
@@ -139,7 +140,8 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
-    void Update();
+    // handles expired auctions until the deadline passes, returns false if some are left for the next call
+    bool Update(TimePoint deadline);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -205,7 +207,7 @@ class TC_GAME_API AuctionHouseMgr
         uint32 PendingAuctionCount(Player const* player) const;
         void PendingAuctionProcess(Player* player);
         void UpdatePendingAuctions();
-        void Update();
+        bool Update(TimePoint deadline);
 
     private:
 
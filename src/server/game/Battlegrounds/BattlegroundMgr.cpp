@@ -32,6 +32,7 @@
 #include "Containers.h"
 #include "Chat.h"
 #include "DatabaseEnv.h"
+#include "DBCStores.h"
 #include "DisableMgr.h"
 #include "Formulas.h"
 #include "GameEventMgr.h"
@@ -152,11 +153,7 @@ void BattlegroundMgr::Update(uint32 diff)
         {
             // forced update for rated arenas (scan all, but skipped non rated)
             TC_LOG_TRACE("bg.arena", "BattlegroundMgr: UPDATING ARENA QUEUES");
-            for (int qtype = BATTLEGROUND_QUEUE_2v2; qtype <= BATTLEGROUND_QUEUE_5v5; ++qtype)
-                for (int bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
-                    m_BattlegroundQueues[qtype].BattlegroundQueueUpdate(diff,
-                        BATTLEGROUND_AA, BattlegroundBracketId(bracket),
-                        BattlegroundMgr::BGArenaType(BattlegroundQueueTypeId(qtype)), true, 0);
+            UpdateRatedArenaQueues();
 
             m_NextRatedArenaUpdate = sWorld->getIntConfig(CONFIG_ARENA_RATED_UPDATE_TIMER);
         }
@@ -850,6 +847,74 @@ void BattlegroundMgr::ScheduleQueueUpdate(uint32 arenaMatchmakerRating, uint8 ar
         m_QueueUpdateScheduler.push_back(scheduleId);
 }
 
+void BattlegroundMgr::InitializeQueueUpdateThreads()
+{
+    uint32 numThreads = sWorld->getIntConfig(CONFIG_BATTLEGROUND_QUEUE_UPDATE_THREADS);
+    if (numThreads > 0)
+        m_QueueUpdateThreads.Start(numThreads);
+}
+
+void BattlegroundMgr::StopQueueUpdateThreads()
+{
+    m_QueueUpdateThreads.Stop();
+}
+
+void BattlegroundMgr::UpdateRatedArenaQueues()
+{
+    struct RatedArenaQueueUpdate
+    {
+        BattlegroundQueueTypeId QueueTypeId;
+        BattlegroundBracketId BracketId;
+        BattlegroundQueue::RatedArenaMatch Match;
+    };
+
+    std::vector<RatedArenaQueueUpdate> updates;
+    for (int qtype = BATTLEGROUND_QUEUE_2v2; qtype <= BATTLEGROUND_QUEUE_5v5; ++qtype)
+        for (int bracket = BG_BRACKET_ID_FIRST; bracket < MAX_BATTLEGROUND_BRACKETS; ++bracket)
+            if (!m_BattlegroundQueues[qtype].IsBracketEmpty(BattlegroundBracketId(bracket)))
+                updates.push_back({ BattlegroundQueueTypeId(qtype), BattlegroundBracketId(bracket), {} });
+
+    if (updates.empty())
+        return;
+
+    // matchmaking does not modify the queues and every (queue, bracket) pair only reads its own groups
+    // so selection can run concurrently, results are applied afterwards in a fixed order
+    for (RatedArenaQueueUpdate& update : updates)
+    {
+        m_QueueUpdateThreads.PostWork([this, &update]()
+        {
+            m_BattlegroundQueues[update.QueueTypeId].SelectRatedArenaMatchCached(update.BracketId, update.Match);
+        });
+    }
+
+    m_QueueUpdateThreads.Wait();
+
+    Battleground* bg_template = GetBattlegroundTemplate(BATTLEGROUND_AA);
+    if (!bg_template)
+    {
+        TC_LOG_ERROR("bg.battleground", "Battleground: Update: bg template not found for %u", BATTLEGROUND_AA);
+        return;
+    }
+
+    for (RatedArenaQueueUpdate const& update : updates)
+    {
+        BattlegroundQueue& queue = m_BattlegroundQueues[update.QueueTypeId];
+        queue.InviteToFreeSlotBattlegrounds(BATTLEGROUND_AA, update.BracketId);
+
+        if (!update.Match.Found)
+            continue;
+
+        PvPDifficultyEntry const* bracketEntry = GetBattlegroundBracketById(bg_template->GetMapId(), update.BracketId);
+        if (!bracketEntry)
+        {
+            TC_LOG_ERROR("bg.battleground", "Battleground: Update: bg bracket entry not found for map %u bracket id %u", bg_template->GetMapId(), update.BracketId);
+            continue;
+        }
+
+        queue.StartRatedArenaMatch(BATTLEGROUND_AA, bracketEntry, BGArenaType(update.QueueTypeId), update.Match);
+    }
+}
+
 uint32 BattlegroundMgr::GetMaxRatingDifference() const
 {
     // this is for stupid people who can't use brain and set max rating difference to 0
@@ -29,6 +29,7 @@
 #include "ObjectAccessor.h"
 #include "Player.h"
 #include "World.h"
+#include <limits>
 
 /*********************************************************/
 /***            BATTLEGROUND QUEUE SYSTEM              ***/
@@ -46,6 +47,14 @@ BattlegroundQueue::BattlegroundQueue()
                 m_WaitTimes[i][j][k] = 0;
         }
     }
+
+    for (uint32 i = 0; i < MAX_BATTLEGROUND_BRACKETS; ++i)
+    {
+        m_QueueRevision[i] = 0;
+        m_RatedArenaSelectionCache[i].Revision = 0;
+        m_RatedArenaSelectionCache[i].RecheckTime = 0;
+        m_RatedArenaSelectionCache[i].Valid = false;
+    }
 }
 
 BattlegroundQueue::~BattlegroundQueue()
@@ -196,6 +205,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* grp, Battlegr
     //add GroupInfo to m_QueuedGroups
     {
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        MarkBracketChanged(bracketId);
 
         //announce to world, this code needs mutex
         if (!isRated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -338,6 +348,8 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     }
     TC_LOG_DEBUG("bg.battleground", "BattlegroundQueue: Removing %s, from bracket_id %u", guid.ToString().c_str(), (uint32)bracket_id);
 
+    MarkBracketChanged(BattlegroundBracketId(bracket_id));
+
     // ALL variables are correctly set
     // We can ignore leveling up in queue - it should not cause crash
     // remove player from group
@@ -444,6 +456,8 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
         BattlegroundQueueTypeId bgQueueTypeId = BattlegroundMgr::BGQueueTypeId(bgTypeId, bg->GetArenaType());
         BattlegroundBracketId bracket_id = bg->GetBracketId();
 
+        MarkBracketChanged(bracket_id);
+
         // set ArenaTeamId for rated matches
         if (bg->isArena() && bg->isRated())
             bg->SetArenaTeamIdForTeam(ginfo->Team, ginfo->ArenaTeamId);
@@ -652,6 +666,7 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
                 //we must insert group to normal queue and erase pointer from premade queue
                 m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
                 m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                MarkBracketChanged(bracket_id);
             }
         }
     }
@@ -739,6 +754,8 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     if (m_SelectionPools[otherTeam].GetPlayerCount() != minPlayersPerTeam)
         return false;
 
+    MarkBracketChanged(bracket_id);
+
     //here we have correct 2 selections and we need to change one teams team and move selection pool teams to other team's queue
     for (GroupsQueueType::iterator itr = m_SelectionPools[otherTeam].SelectedGroups.begin(); itr != m_SelectionPools[otherTeam].SelectedGroups.end(); ++itr)
     {
@@ -766,20 +783,16 @@ void BattlegroundQueue::UpdateEvents(uint32 diff)
     m_events.Update(diff);
 }
 
-/*
-this method is called when group is inserted, or player / group is removed from BG Queue - there is only one player's status changed, so we don't use while (true) cycles to invite whole queue
-it must be called after fully adding the members of a group to ensure group joining
-should be called from Battleground::RemovePlayer function in some cases
-*/
-void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType, bool isRated, uint32 arenaRating)
+bool BattlegroundQueue::IsBracketEmpty(BattlegroundBracketId bracket_id) const
 {
-    //if no players in queue - do nothing
-    if (m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
+    return m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty() &&
         m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty() &&
         m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE].empty() &&
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty())
-        return;
+        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_HORDE].empty();
+}
 
+void BattlegroundQueue::InviteToFreeSlotBattlegrounds(BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id)
+{
     // battleground with free slot for player should be always in the beggining of the queue
     // maybe it would be better to create bgfreeslotqueue for each bracket_id
     BGFreeSlotQueueContainer& bgQueues = sBattlegroundMgr->GetBGFreeSlotQueueStore(bgTypeId);
@@ -808,6 +821,20 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
                 bg->RemoveFromBGFreeSlotQueue();
         }
     }
+}
+
+/*
+this method is called when group is inserted, or player / group is removed from BG Queue - there is only one player's status changed, so we don't use while (true) cycles to invite whole queue
+it must be called after fully adding the members of a group to ensure group joining
+should be called from Battleground::RemovePlayer function in some cases
+*/
+void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType, bool isRated, uint32 arenaRating)
+{
+    //if no players in queue - do nothing
+    if (IsBracketEmpty(bracket_id))
+        return;
+
+    InviteToFreeSlotBattlegrounds(bgTypeId, bracket_id);
 
     // finished iterating through the bgs with free slots, maybe we need to create a new bg
 
@@ -888,126 +915,175 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundTyp
     }
     else if (bg_template->isArena())
     {
-        // found out the minimum and maximum ratings the newly added team should battle against
-        // arenaRating is the rating of the latest joined team, or 0
-        // 0 is on (automatic update call) and we must set it to team's with longest wait time
-        if (!arenaRating)
+        RatedArenaMatch match;
+        if (SelectRatedArenaMatch(bracket_id, arenaRating, match))
+            StartRatedArenaMatch(bgTypeId, bracketEntry, arenaType, match);
+    }
+}
+
+bool BattlegroundQueue::SelectRatedArenaMatch(BattlegroundBracketId bracket_id, uint32 arenaRating, RatedArenaMatch& match) const
+{
+    uint32 const now = GameTime::GetGameTimeMS();
+    uint32 const ratingDiscardTimer = sBattlegroundMgr->GetRatingDiscardTimer();
+    uint32 const opponentsDiscardTimer = sWorld->getIntConfig(CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER);
+
+    match.Found = false;
+    match.RecheckTime = std::numeric_limits<uint32>::max();
+
+    // found out the minimum and maximum ratings the newly added team should battle against
+    // arenaRating is the rating of the latest joined team, or 0
+    // 0 is on (automatic update call) and we must set it to team's with longest wait time
+    if (!arenaRating)
+    {
+        GroupQueueInfo* front1 = nullptr;
+        GroupQueueInfo* front2 = nullptr;
+        if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty())
         {
-            GroupQueueInfo* front1 = nullptr;
-            GroupQueueInfo* front2 = nullptr;
-            if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty())
-            {
-                front1 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].front();
+            front1 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].front();
+            arenaRating = front1->ArenaMatchmakerRating;
+        }
+        if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
+        {
+            front2 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].front();
+            arenaRating = front2->ArenaMatchmakerRating;
+        }
+        if (front1 && front2)
+        {
+            if (front1->JoinTime < front2->JoinTime)
                 arenaRating = front1->ArenaMatchmakerRating;
-            }
-            if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
-            {
-                front2 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].front();
-                arenaRating = front2->ArenaMatchmakerRating;
-            }
-            if (front1 && front2)
-            {
-                if (front1->JoinTime < front2->JoinTime)
-                    arenaRating = front1->ArenaMatchmakerRating;
-            }
-            else if (!front1 && !front2)
-                return; //queues are empty
         }
+        else if (!front1 && !front2)
+            return false; //queues are empty
+    }
+
+    //set rating range
+    uint32 arenaMinRating = (arenaRating <= sBattlegroundMgr->GetMaxRatingDifference()) ? 0 : arenaRating - sBattlegroundMgr->GetMaxRatingDifference();
+    uint32 arenaMaxRating = arenaRating + sBattlegroundMgr->GetMaxRatingDifference();
+    // if max rating difference is set and the time past since server startup is greater than the rating discard time
+    // (after what time the ratings aren't taken into account when making teams) then
+    // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
+    // else leave the discard time on 0, this way all ratings will be discarded
+    // this has to be signed value - when the server starts, this value would be negative and thus overflow
+    int32 discardTime = now - ratingDiscardTimer;
+
+    // timer for previous opponents
+    int32 discardOpponentsTime = now - opponentsDiscardTimer;
+
+    // we need to find 2 teams which will play next game
+    uint8 found = 0;
+    uint8 team = 0;
 
-        //set rating range
-        uint32 arenaMinRating = (arenaRating <= sBattlegroundMgr->GetMaxRatingDifference()) ? 0 : arenaRating - sBattlegroundMgr->GetMaxRatingDifference();
-        uint32 arenaMaxRating = arenaRating + sBattlegroundMgr->GetMaxRatingDifference();
-        // if max rating difference is set and the time past since server startup is greater than the rating discard time
-        // (after what time the ratings aren't taken into account when making teams) then
-        // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
-        // else leave the discard time on 0, this way all ratings will be discarded
-        // this has to be signed value - when the server starts, this value would be negative and thus overflow
-        int32 discardTime = GameTime::GetGameTimeMS() - sBattlegroundMgr->GetRatingDiscardTimer();
-
-        // timer for previous opponents
-        int32 discardOpponentsTime = GameTime::GetGameTimeMS() - sWorld->getIntConfig(CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER);
-
-        // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[PVP_TEAMS_COUNT];
-        uint8 found = 0;
-        uint8 team = 0;
-
-        for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
+    for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
+    {
+        // take the group that joined first
+        GroupsQueueType::const_iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
+        for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            // if group match conditions, then add it to pool
+            if (!(*itr2)->IsInvitedToBGInstanceGUID
+                && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
+                    || (int32)(*itr2)->JoinTime < discardTime))
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                match.Teams[found++] = itr2;
+                team = i;
+                break;
             }
         }
+    }
 
-        if (!found)
-            return;
-
-        if (found == 1)
+    if (found == 1)
+    {
+        for (GroupsQueueType::const_iterator itr3 = match.Teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
         {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
+            if (!(*itr3)->IsInvitedToBGInstanceGUID
+                && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating) || (int32)(*itr3)->JoinTime < discardTime)
+                && ((*match.Teams[0])->ArenaTeamId != (*itr3)->PreviousOpponentsTeamId || ((int32)(*itr3)->JoinTime < discardOpponentsTime))
+                && (*match.Teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
             {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating) || (int32)(*itr3)->JoinTime < discardTime)
-                    && ((*itr_teams[0])->ArenaTeamId != (*itr3)->PreviousOpponentsTeamId || ((int32)(*itr3)->JoinTime < discardOpponentsTime))
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
+                match.Teams[found++] = itr3;
+                break;
             }
         }
+    }
 
-        //if we have 2 teams, then start new arena and invite players!
-        if (found == 2)
+    match.Found = found == 2;
+    if (match.Found)
+        return true;
+
+    // without queue changes the outcome can only change once one of the waiting teams reaches a discard timer
+    for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
+    {
+        for (GroupQueueInfo const* ginfo : m_QueuedGroups[bracket_id][i])
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
-            Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
-            if (!arena)
-            {
-                TC_LOG_ERROR("bg.battleground", "BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
-                return;
-            }
+            if (ginfo->IsInvitedToBGInstanceGUID)
+                continue;
 
-            aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
-            hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
-            aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
-            hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
-            TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
-            TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
+            if ((int32)ginfo->JoinTime >= discardTime)
+                match.RecheckTime = std::min(match.RecheckTime, ginfo->JoinTime + ratingDiscardTimer + 1);
+            if ((int32)ginfo->JoinTime >= discardOpponentsTime)
+                match.RecheckTime = std::min(match.RecheckTime, ginfo->JoinTime + opponentsDiscardTimer + 1);
+        }
+    }
 
-            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if (aTeam->Team != ALLIANCE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
-            if (hTeam->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
+    return false;
+}
 
-            arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
-            arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
-            InviteGroupToBG(aTeam, arena, ALLIANCE);
-            InviteGroupToBG(hTeam, arena, HORDE);
+bool BattlegroundQueue::SelectRatedArenaMatchCached(BattlegroundBracketId bracket_id, RatedArenaMatch& match)
+{
+    RatedArenaSelectionCache& cache = m_RatedArenaSelectionCache[bracket_id];
+    if (cache.Valid && cache.Revision == m_QueueRevision[bracket_id] && GameTime::GetGameTimeMS() < cache.RecheckTime)
+        return false;
 
-            TC_LOG_DEBUG("bg.battleground", "Starting rated arena match!");
-            arena->StartBattleground();
-        }
+    if (SelectRatedArenaMatch(bracket_id, 0, match))
+    {
+        cache.Valid = false;
+        return true;
+    }
+
+    cache.Valid = true;
+    cache.Revision = m_QueueRevision[bracket_id];
+    cache.RecheckTime = match.RecheckTime;
+    return false;
+}
+
+void BattlegroundQueue::StartRatedArenaMatch(BattlegroundTypeId bgTypeId, PvPDifficultyEntry const* bracketEntry, uint8 arenaType, RatedArenaMatch const& match)
+{
+    BattlegroundBracketId bracket_id = bracketEntry->GetBracketId();
+    GroupQueueInfo* aTeam = *match.Teams[TEAM_ALLIANCE];
+    GroupQueueInfo* hTeam = *match.Teams[TEAM_HORDE];
+    Battleground* arena = sBattlegroundMgr->CreateNewBattleground(bgTypeId, bracketEntry, arenaType, true);
+    if (!arena)
+    {
+        TC_LOG_ERROR("bg.battleground", "BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
+        return;
+    }
+
+    aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
+    hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
+    aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
+    hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
+    TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
+    TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team %u to %u", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
+
+    // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+    if (aTeam->Team != ALLIANCE)
+    {
+        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
+        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(match.Teams[TEAM_ALLIANCE]);
+    }
+    if (hTeam->Team != HORDE)
+    {
+        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
+        m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(match.Teams[TEAM_HORDE]);
     }
+
+    arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
+    arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
+    InviteGroupToBG(aTeam, arena, ALLIANCE);
+    InviteGroupToBG(hTeam, arena, HORDE);
+
+    TC_LOG_DEBUG("bg.battleground", "Starting rated arena match!");
+    arena->StartBattleground();
 }
 
 /*********************************************************/
@@ -81,6 +81,9 @@ class TC_GAME_API BattlegroundQueue
         void BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id, uint8 arenaType = 0, bool isRated = false, uint32 minRating = 0);
         void UpdateEvents(uint32 diff);
 
+        bool IsBracketEmpty(BattlegroundBracketId bracket_id) const;
+        void InviteToFreeSlotBattlegrounds(BattlegroundTypeId bgTypeId, BattlegroundBracketId bracket_id);
+
         void FillPlayersToBG(Battleground* bg, BattlegroundBracketId bracket_id);
         bool CheckPremadeMatch(BattlegroundBracketId bracket_id, uint32 MinPlayersPerTeam, uint32 MaxPlayersPerTeam);
         bool CheckNormalMatch(Battleground* bg_template, BattlegroundBracketId bracket_id, uint32 minPlayers, uint32 maxPlayers);
@@ -109,6 +112,22 @@ class TC_GAME_API BattlegroundQueue
         */
         GroupsQueueType m_QueuedGroups[MAX_BATTLEGROUND_BRACKETS][BG_QUEUE_GROUP_TYPES_COUNT];
 
+        // result of rated arena matchmaking for one bracket
+        struct RatedArenaMatch
+        {
+            RatedArenaMatch() : Found(false), RecheckTime(0) { }
+
+            GroupsQueueType::const_iterator Teams[PVP_TEAMS_COUNT];
+            bool Found;
+            uint32 RecheckTime;                                 // game time (ms) after which an unsuccessful selection can have a different outcome without queue changes
+        };
+
+        // does not modify the queue, can be called for different brackets/queues concurrently
+        bool SelectRatedArenaMatch(BattlegroundBracketId bracket_id, uint32 arenaRating, RatedArenaMatch& match) const;
+        // same as above but skips brackets that did not change since the last unsuccessful selection
+        bool SelectRatedArenaMatchCached(BattlegroundBracketId bracket_id, RatedArenaMatch& match);
+        void StartRatedArenaMatch(BattlegroundTypeId bgTypeId, PvPDifficultyEntry const* bracketEntry, uint8 arenaType, RatedArenaMatch const& match);
+
         // class to select and invite groups to bg
         class SelectionPool
         {
@@ -130,10 +149,22 @@ class TC_GAME_API BattlegroundQueue
     private:
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, uint32 side);
+        void MarkBracketChanged(BattlegroundBracketId bracket_id) { ++m_QueueRevision[bracket_id]; }
         uint32 m_WaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
 
+        // incremented every time groups are added, removed, invited or moved between queues of a bracket
+        uint32 m_QueueRevision[MAX_BATTLEGROUND_BRACKETS];
+
+        struct RatedArenaSelectionCache
+        {
+            uint32 Revision;
+            uint32 RecheckTime;
+            bool Valid;
+        };
+        RatedArenaSelectionCache m_RatedArenaSelectionCache[MAX_BATTLEGROUND_BRACKETS];
+
         // Event handler
         EventProcessor m_events;
 };
@@ -24,12 +24,10 @@
 #include "Timer.h"
 #include "World.h"
 #include "WorldPacket.h"
-#include <unordered_map>
 
 namespace
 {
-    std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    CharacterCacheStorage _characterCacheStore;
 }
 
 CharacterCache::CharacterCache()
@@ -59,7 +57,7 @@ CharacterCache* CharacterCache::instance()
 *    if (!characterInfo)
 *        return;
 *
-*    std::string playerName = characterInfo->Name;
+*    std::string playerName(characterInfo->Name);
 *    uint8 playerGender = characterInfo->Sex;
 *    uint8 playerRace = characterInfo->Race;
 *    uint8 playerClass = characterInfo->Class;
@@ -69,7 +67,7 @@ CharacterCache* CharacterCache::instance()
 
 void CharacterCache::LoadCharacterCacheStorage()
 {
-    _characterCacheStore.clear();
+    _characterCacheStore.Clear();
     uint32 oldMSTime = getMSTime();
 
     QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters");
@@ -79,6 +77,8 @@ void CharacterCache::LoadCharacterCacheStorage()
         return;
     }
 
+    _characterCacheStore.Reserve(result->GetRowCount());
+
     do
     {
         Field* fields = result->Fetch();
@@ -86,7 +86,9 @@ void CharacterCache::LoadCharacterCacheStorage()
             fields[4].GetUInt8() /*gender*/, fields[3].GetUInt8() /*race*/, fields[5].GetUInt8() /*class*/, fields[6].GetUInt8() /*level*/);
     } while (result->NextRow());
 
-    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters in %u ms", _characterCacheStore.size(), GetMSTimeDiffToNow(oldMSTime));
+    CharacterCacheStorage::MemoryStats stats = _characterCacheStore.GetMemoryStats();
+    TC_LOG_INFO("server.loading", "Loaded character infos for " SZFMTD " characters (" SZFMTD " KiB) in %u ms", _characterCacheStore.GetSize(),
+        (stats.EntryBytes + stats.NameBytes + stats.IndexBytes) / 1024, GetMSTimeDiffToNow(oldMSTime));
 }
 
 /*
@@ -94,9 +96,7 @@ Modifying functions
 */
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
-    data.Guid = guid;
-    data.Name = name;
+    CharacterCacheEntry& data = *_characterCacheStore.Add(guid, name);
     data.AccountId = accountId;
     data.Race = race;
     data.Sex = gender;
@@ -105,75 +105,64 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
     data.GuildId = 0;                           // Will be set in guild loading or guild setting
     for (uint8 i = 0; i < MAX_ARENA_SLOT; ++i)
         data.ArenaTeamId[i] = 0;                // Will be set in arena teams loading
-
-    // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    _characterCacheStore.Remove(guid);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender /*= {}*/, Optional<uint8> race /*= {}*/)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* entry = _characterCacheStore.Rename(guid, name);
+    if (!entry)
         return;
 
-    std::string oldName = itr->second.Name;
-    itr->second.Name = name;
-
     if (gender)
-        itr->second.Sex = *gender;
+        entry->Sex = *gender;
 
     if (race)
-        itr->second.Race = *race;
+        entry->Race = *race;
 
     WorldPackets::Misc::InvalidatePlayer packet(guid);
     sWorld->SendGlobalMessage(packet.Write());
-
-    // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return;
 
-    itr->second.Level = level;
+    entry->Level = level;
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return;
 
-    itr->second.AccountId = accountId;
+    entry->AccountId = accountId;
 }
 
 void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::LowType guildId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return;
 
-    itr->second.GuildId = guildId;
+    entry->GuildId = guildId;
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return;
 
     ASSERT(slot < 3);
-    itr->second.ArenaTeamId[slot] = arenaTeamId;
+    entry->ArenaTeamId[slot] = arenaTeamId;
 }
 
 /*
@@ -181,98 +170,88 @@ Getters
 */
 bool CharacterCache::HasCharacterCacheEntry(ObjectGuid const& guid) const
 {
-    return _characterCacheStore.find(guid) != _characterCacheStore.end();
+    return _characterCacheStore.FindByGuid(guid) != nullptr;
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid const& guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr != _characterCacheStore.end())
-        return &itr->second;
-
-    return nullptr;
+    return _characterCacheStore.FindByGuid(guid);
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second;
-
-    return nullptr;
+    return _characterCacheStore.FindByName(name);
 }
 
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second->Guid;
+    if (CharacterCacheEntry const* entry = _characterCacheStore.FindByName(name))
+        return entry->Guid;
 
     return ObjectGuid::Empty;
 }
 
 bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return false;
 
-    name = itr->second.Name;
+    name = entry->Name;
     return true;
 }
 
 uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return 0;
 
-    return Player::TeamForRace(itr->second.Race);
+    return Player::TeamForRace(entry->Race);
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.AccountId;
+    return entry->AccountId;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-        return itr->second->AccountId;
+    if (CharacterCacheEntry const* entry = _characterCacheStore.FindByName(name))
+        return entry->AccountId;
 
     return 0;
 }
 
 uint8 CharacterCache::GetCharacterLevelByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.Level;
+    return entry->Level;
 }
 
 ObjectGuid::LowType CharacterCache::GetCharacterGuildIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return 0;
 
-    return itr->second.GuildId;
+    return entry->GuildId;
 }
 
 uint32 CharacterCache::GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* entry = _characterCacheStore.FindByGuid(guid);
+    if (!entry)
         return 0;
 
     uint8 slot = ArenaTeam::GetSlotByType(type);
     ASSERT(slot < 3);
-    return itr->second.ArenaTeamId[slot];
+    return entry->ArenaTeamId[slot];
 }
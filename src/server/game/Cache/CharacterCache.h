@@ -19,23 +19,11 @@
 #define CharacterCache_h__
 
 #include "Define.h"
+#include "CharacterCacheStorage.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include <string>
 
-struct CharacterCacheEntry
-{
-    ObjectGuid Guid;
-    std::string Name;
-    uint32 AccountId;
-    uint8 Class;
-    uint8 Race;
-    uint8 Sex;
-    uint8 Level;
-    ObjectGuid::LowType GuildId;
-    uint32 ArenaTeamId[3];
-};
-
 class TC_GAME_API CharacterCache
 {
     public:
@@ -45,7 +33,7 @@ class TC_GAME_API CharacterCache
 
         void LoadCharacterCacheStorage();
         void AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level);
-        void DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name);
+        void DeleteCharacterCacheEntry(ObjectGuid const& guid);
 
         void UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender = {}, Optional<uint8> race = {});
         void UpdateCharacterLevel(ObjectGuid const& guid, uint8 level);
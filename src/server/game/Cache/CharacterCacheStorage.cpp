@@ -0,0 +1,307 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterCacheStorage.h"
+#include "Errors.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr std::size_t NameChunkSize = 64 * 1024;
+
+    constexpr char ToLowerAscii(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+    }
+
+    bool EqualsIgnoreAsciiCase(std::string_view left, std::string_view right)
+    {
+        if (left.size() != right.size())
+            return false;
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            if (ToLowerAscii(left[i]) != ToLowerAscii(right[i]))
+                return false;
+
+        return true;
+    }
+}
+
+uint32 CharacterCacheStorage::HashName(std::string_view name)
+{
+    // FNV-1a over the lowercased name
+    uint32 hash = 2166136261u;
+    for (char c : name)
+    {
+        hash ^= uint8(ToLowerAscii(c));
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+std::size_t CharacterCacheStorage::Index::GetHome(uint32 key) const
+{
+    // keys are guid counters or FNV hashes, both need their bits mixed before masking
+    uint64 mixed = uint64(key) * UI64LIT(0x9E3779B97F4A7C15);
+    return std::size_t(mixed >> 32) & (_slots.size() - 1);
+}
+
+void CharacterCacheStorage::Index::Reserve(std::size_t count)
+{
+    std::size_t slotCount = 16;
+    while (slotCount * 3 < count * 4)
+        slotCount *= 2;
+
+    if (slotCount > _slots.size())
+        Grow(slotCount);
+}
+
+void CharacterCacheStorage::Index::Clear()
+{
+    std::vector<Slot>().swap(_slots);
+    _count = 0;
+}
+
+void CharacterCacheStorage::Index::Insert(uint32 key, uint32 entry)
+{
+    // keep load factor at or below 3/4, linear probing gets slow above that
+    if ((_count + 1) * 4 > _slots.size() * 3)
+        Grow(std::max<std::size_t>(16, _slots.size() * 2));
+
+    std::size_t i = GetHome(key);
+    while (_slots[i].Entry != EmptySlot)
+        i = (i + 1) & (_slots.size() - 1);
+
+    _slots[i] = { key, entry };
+    ++_count;
+}
+
+void CharacterCacheStorage::Index::Erase(uint32 key, uint32 entry)
+{
+    if (_slots.empty())
+        return;
+
+    std::size_t mask = _slots.size() - 1;
+    std::size_t i = GetHome(key);
+    while (_slots[i].Entry != entry || _slots[i].Key != key)
+    {
+        if (_slots[i].Entry == EmptySlot)
+            return;
+
+        i = (i + 1) & mask;
+    }
+
+    // backward shift deletion, moves following slots of the cluster into the gap so no tombstones are needed
+    std::size_t j = i;
+    while (true)
+    {
+        j = (j + 1) & mask;
+        if (_slots[j].Entry == EmptySlot)
+            break;
+
+        std::size_t home = GetHome(_slots[j].Key);
+        // slot j can fill the gap at i only if its home is not in the cyclic range (i, j]
+        bool homeInRange = i <= j ? (home > i && home <= j) : (home > i || home <= j);
+        if (homeInRange)
+            continue;
+
+        _slots[i] = _slots[j];
+        i = j;
+    }
+
+    _slots[i] = { 0, EmptySlot };
+    --_count;
+}
+
+void CharacterCacheStorage::Index::Grow(std::size_t slotCount)
+{
+    std::vector<Slot> oldSlots(slotCount, Slot{ 0, EmptySlot });
+    oldSlots.swap(_slots);
+    _count = 0;
+
+    for (Slot const& slot : oldSlots)
+        if (slot.Entry != EmptySlot)
+            Insert(slot.Key, slot.Entry);
+}
+
+CharacterCacheStorage::CharacterCacheStorage() : _size(0), _nameChunkSize(0), _nameChunkUsed(0), _nameBytes(0), _unusedNameBytes(0)
+{
+}
+
+CharacterCacheStorage::~CharacterCacheStorage() = default;
+
+void CharacterCacheStorage::Reserve(std::size_t count)
+{
+    _guidIndex.Reserve(count);
+    _nameIndex.Reserve(count);
+}
+
+void CharacterCacheStorage::Clear()
+{
+    _entries.clear();
+    _freeEntries.clear();
+    _size = 0;
+    _guidIndex.Clear();
+    _nameIndex.Clear();
+    _nameChunks.clear();
+    _nameChunkSize = 0;
+    _nameChunkUsed = 0;
+    _nameBytes = 0;
+    _unusedNameBytes = 0;
+}
+
+std::string_view CharacterCacheStorage::StoreName(std::string_view name)
+{
+    std::size_t size = name.size() + 1;
+    if (_nameChunkUsed + size > _nameChunkSize)
+    {
+        _nameChunkSize = std::max(NameChunkSize, size);
+        _nameChunks.push_back(std::make_unique<char[]>(_nameChunkSize));
+        _nameChunkUsed = 0;
+        _nameBytes += _nameChunkSize;
+    }
+
+    char* stored = _nameChunks.back().get() + _nameChunkUsed;
+    std::memcpy(stored, name.data(), name.size());
+    stored[name.size()] = '\0';
+    _nameChunkUsed += size;
+    return std::string_view(stored, name.size());
+}
+
+CharacterCacheEntry* CharacterCacheStorage::Add(ObjectGuid guid, std::string_view name)
+{
+    ASSERT(guid.IsPlayer());
+
+    if (CharacterCacheEntry* existing = FindByGuid(guid))
+        return Rename(guid, name);
+
+    uint32 index;
+    if (!_freeEntries.empty())
+    {
+        index = _freeEntries.back();
+        _freeEntries.pop_back();
+    }
+    else
+    {
+        index = uint32(_entries.size());
+        _entries.emplace_back();
+    }
+
+    CharacterCacheEntry& entry = _entries[index];
+    entry = CharacterCacheEntry();
+    entry.Guid = guid;
+    entry.Name = StoreName(name);
+    ++_size;
+
+    _guidIndex.Insert(guid.GetCounter(), index);
+    _nameIndex.Insert(HashName(name), index);
+    return &entry;
+}
+
+bool CharacterCacheStorage::Remove(ObjectGuid guid)
+{
+    CharacterCacheEntry* entry = FindByGuid(guid);
+    if (!entry)
+        return false;
+
+    uint32 index = 0;
+    _guidIndex.ForEachEntry(guid.GetCounter(), [&](uint32 candidate) { index = candidate; return true; });
+
+    _guidIndex.Erase(guid.GetCounter(), index);
+    _nameIndex.Erase(HashName(entry->Name), index);
+    _unusedNameBytes += entry->Name.size() + 1;
+
+    entry->Guid.Clear();
+    entry->Name = {};
+    _freeEntries.push_back(index);
+    --_size;
+    return true;
+}
+
+CharacterCacheEntry* CharacterCacheStorage::Rename(ObjectGuid guid, std::string_view name)
+{
+    CharacterCacheEntry* entry = FindByGuid(guid);
+    if (!entry || entry->Name == name)
+        return entry;
+
+    uint32 index = 0;
+    _guidIndex.ForEachEntry(guid.GetCounter(), [&](uint32 candidate) { index = candidate; return true; });
+
+    _nameIndex.Erase(HashName(entry->Name), index);
+    _unusedNameBytes += entry->Name.size() + 1;
+
+    // old name stays in the arena so views handed out before stay valid
+    entry->Name = StoreName(name);
+    _nameIndex.Insert(HashName(name), index);
+    return entry;
+}
+
+CharacterCacheEntry* CharacterCacheStorage::FindByGuid(ObjectGuid guid)
+{
+    return const_cast<CharacterCacheEntry*>(static_cast<CharacterCacheStorage const*>(this)->FindByGuid(guid));
+}
+
+CharacterCacheEntry const* CharacterCacheStorage::FindByGuid(ObjectGuid guid) const
+{
+    if (!guid.IsPlayer())
+        return nullptr;
+
+    // guid counters of players are unique, the key alone identifies the entry
+    CharacterCacheEntry const* result = nullptr;
+    _guidIndex.ForEachEntry(guid.GetCounter(), [&](uint32 index)
+    {
+        result = &_entries[index];
+        return true;
+    });
+
+    return result;
+}
+
+CharacterCacheEntry const* CharacterCacheStorage::FindByName(std::string_view name) const
+{
+    CharacterCacheEntry const* result = nullptr;
+    _nameIndex.ForEachEntry(HashName(name), [&](uint32 index)
+    {
+        CharacterCacheEntry const& entry = _entries[index];
+        if (entry.Name == name)
+        {
+            result = &entry;
+            return true;
+        }
+
+        // names only differing in case should not exist but prefer the exact match if they do
+        if (!result && EqualsIgnoreAsciiCase(entry.Name, name))
+            result = &entry;
+
+        return false;
+    });
+
+    return result;
+}
+
+CharacterCacheStorage::MemoryStats CharacterCacheStorage::GetMemoryStats() const
+{
+    MemoryStats stats;
+    stats.Entries = _size;
+    stats.EntryBytes = _entries.size() * sizeof(CharacterCacheEntry) + _freeEntries.capacity() * sizeof(uint32);
+    stats.NameBytes = _nameBytes;
+    stats.UnusedNameBytes = _unusedNameBytes;
+    stats.IndexBytes = _guidIndex.GetMemoryUsage() + _nameIndex.GetMemoryUsage();
+    return stats;
+}
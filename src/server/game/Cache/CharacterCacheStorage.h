@@ -0,0 +1,137 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CharacterCacheStorage_h__
+#define CharacterCacheStorage_h__
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <deque>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+struct CharacterCacheEntry
+{
+    ObjectGuid Guid;
+    std::string_view Name;                      // null terminated, stays valid until the cache is cleared (also after renames)
+    uint32 AccountId;
+    ObjectGuid::LowType GuildId;
+    uint32 ArenaTeamId[3];
+    uint8 Class;
+    uint8 Race;
+    uint8 Sex;
+    uint8 Level;
+};
+
+/*
+ * Compact storage for CharacterCacheEntry of every character on the realm.
+ * Names are interned in an append only arena, entries live in a deque (pointers stay valid until removed) and both
+ * guid and name lookups go through open addressing tables holding 32 bit hashes and entry indexes instead of
+ * node based maps. Name lookups ignore ASCII case.
+ */
+class TC_GAME_API CharacterCacheStorage
+{
+    public:
+        struct MemoryStats
+        {
+            std::size_t Entries = 0;
+            std::size_t EntryBytes = 0;
+            std::size_t NameBytes = 0;          // reserved arena memory
+            std::size_t UnusedNameBytes = 0;    // names of deleted and renamed characters
+            std::size_t IndexBytes = 0;
+        };
+
+        CharacterCacheStorage();
+        ~CharacterCacheStorage();
+
+        CharacterCacheStorage(CharacterCacheStorage const&) = delete;
+        CharacterCacheStorage& operator=(CharacterCacheStorage const&) = delete;
+
+        void Reserve(std::size_t count);
+        void Clear();
+
+        // returns the existing entry (renamed if needed) when guid is already stored, remaining fields are not reset then
+        CharacterCacheEntry* Add(ObjectGuid guid, std::string_view name);
+        bool Remove(ObjectGuid guid);
+        CharacterCacheEntry* Rename(ObjectGuid guid, std::string_view name);
+
+        CharacterCacheEntry* FindByGuid(ObjectGuid guid);
+        CharacterCacheEntry const* FindByGuid(ObjectGuid guid) const;
+        CharacterCacheEntry const* FindByName(std::string_view name) const;
+
+        std::size_t GetSize() const { return _size; }
+        MemoryStats GetMemoryStats() const;
+
+        static uint32 HashName(std::string_view name);
+
+    private:
+        // 32 bit key (guid counter or name hash) with the index of the entry it belongs to
+        struct Slot
+        {
+            uint32 Key;
+            uint32 Entry;
+        };
+
+        class Index
+        {
+            public:
+                static constexpr uint32 EmptySlot = 0xFFFFFFFF;
+
+                void Reserve(std::size_t count);
+                void Clear();
+                void Insert(uint32 key, uint32 entry);
+                void Erase(uint32 key, uint32 entry);
+
+                // calls func with every entry stored for key until it returns true
+                template<typename Func>
+                void ForEachEntry(uint32 key, Func&& func) const
+                {
+                    if (_slots.empty())
+                        return;
+
+                    for (std::size_t i = GetHome(key); _slots[i].Entry != EmptySlot; i = (i + 1) & (_slots.size() - 1))
+                        if (_slots[i].Key == key && func(_slots[i].Entry))
+                            return;
+                }
+
+                std::size_t GetMemoryUsage() const { return _slots.capacity() * sizeof(Slot); }
+
+            private:
+                std::size_t GetHome(uint32 key) const;
+                void Grow(std::size_t slotCount);
+
+                std::vector<Slot> _slots;
+                std::size_t _count = 0;
+        };
+
+        std::string_view StoreName(std::string_view name);
+
+        std::deque<CharacterCacheEntry> _entries;
+        std::vector<uint32> _freeEntries;
+        std::size_t _size;
+
+        Index _guidIndex;
+        Index _nameIndex;
+
+        std::vector<std::unique_ptr<char[]>> _nameChunks;
+        std::size_t _nameChunkSize;             // size of the last chunk
+        std::size_t _nameChunkUsed;             // used bytes of the last chunk
+        std::size_t _nameBytes;
+        std::size_t _unusedNameBytes;
+};
+
+#endif // CharacterCacheStorage_h__
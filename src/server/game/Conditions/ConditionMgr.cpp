@@ -784,7 +784,7 @@ std::string Condition::ToString(bool ext /*= false*/) const
     return ss.str();
 }
 
-ConditionMgr::ConditionMgr() { }
+ConditionMgr::ConditionMgr() : _conditionsGeneration(0) { }
 
 ConditionMgr::~ConditionMgr()
 {
@@ -811,9 +811,8 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 
         if ((*i)->ReferenceId) // handle reference
         {
-            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-            ASSERT(ref != ConditionReferenceStore.end() && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
-            elseGroupSearcherTypeMasks[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditionList((*ref).second);
+            ASSERT((*i)->ReferencedConditions && "ConditionMgr::GetSearcherTypeMaskForConditionList - incorrect reference");
+            elseGroupSearcherTypeMasks[(*i)->ElseGroup] &= GetSearcherTypeMaskForConditionList(*(*i)->ReferencedConditions);
         }
         else // handle normal condition
         {
@@ -833,48 +832,22 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
-    for (Condition const* condition : conditions)
+    return EvaluateConditionList(conditions, [&](Condition const* condition)
     {
         TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s val1: %u", condition->ToString().c_str(), condition->ConditionValue1);
-        if (condition->isLoaded())
-        {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = elseGroupStore.find(condition->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == elseGroupStore.end())
-                elseGroupStore[condition->ElseGroup] = true;
-            else if (!(*itr).second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
-                continue;
-
-            if (condition->ReferenceId)//handle reference
-            {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, ref->second))
-                        elseGroupStore[condition->ElseGroup] = false;
-                }
-                else
-                {
-                    TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s Reference template -%u not found",
-                        condition->ToString().c_str(), condition->ReferenceId); // checked at loading, should never happen
-                }
+        if (condition->ReferenceId) //handle reference
+        {
+            if (condition->ReferencedConditions)
+                return IsObjectMeetToConditionList(sourceInfo, *condition->ReferencedConditions);
 
-            }
-            else //handle normal condition
-            {
-                if (!condition->Meets(sourceInfo))
-                    elseGroupStore[condition->ElseGroup] = false;
-            }
-        }
-    }
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
+            TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList %s Reference template -%u not found",
+                condition->ToString().c_str(), condition->ReferenceId); // checked at loading, should never happen
             return true;
+        }
 
-    return false;
+        //handle normal condition
+        return condition->Meets(sourceInfo);
+    });
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionContainer const& conditions) const
@@ -898,6 +871,20 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+void ConditionMgr::AddToConditionList(ConditionContainer& conditions, Condition* cond)
+{
+    // insert after the last condition of the same ElseGroup, or append if it is a new one
+    auto itr = std::find_if(conditions.rbegin(), conditions.rend(), [cond](Condition const* other)
+    {
+        return other->ElseGroup == cond->ElseGroup;
+    });
+
+    if (itr != conditions.rend())
+        conditions.insert(itr.base(), cond);
+    else
+        conditions.push_back(cond);
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType)
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE ||
@@ -1004,6 +991,20 @@ bool ConditionMgr::IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint
 }
 
 bool ConditionMgr::IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const
+{
+    return IsObjectMeetingSmartEventConditions(GetConditionsForSmartEvent(entryOrGuid, eventId, sourceType), unit, baseObject);
+}
+
+bool ConditionMgr::IsObjectMeetingSmartEventConditions(ConditionContainer const* conditions, Unit* unit, WorldObject* baseObject) const
+{
+    if (!conditions)
+        return true;
+
+    ConditionSourceInfo sourceInfo(unit, baseObject);
+    return IsObjectMeetToConditions(sourceInfo, *conditions);
+}
+
+ConditionContainer const* ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
     SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
     if (itr != SmartEventConditionStore.end())
@@ -1012,11 +1013,10 @@ bool ConditionMgr::IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32
         if (i != itr->second.end())
         {
             TC_LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid %d eventId %u", entryOrGuid, eventId);
-            ConditionSourceInfo sourceInfo(unit, baseObject);
-            return IsObjectMeetToConditions(sourceInfo, i->second);
+            return &i->second;
         }
     }
-    return true;
+    return nullptr;
 }
 
 bool ConditionMgr::IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const
@@ -1051,6 +1051,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++_conditionsGeneration;
 
     //must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -1151,7 +1152,7 @@ void ConditionMgr::LoadConditions(bool isReload)
 
         if (iSourceTypeOrReferenceId < 0)//it is a reference template
         {
-            ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)].push_back(cond);//add to reference storage
+            AddToConditionList(ConditionReferenceStore[std::abs(iSourceTypeOrReferenceId)], cond);//add to reference storage
             ++count;
             continue;
         }//end of reference templates
@@ -1239,7 +1240,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
                 {
-                    SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     if (cond->ConditionType == CONDITION_AURA)
                         SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
                     valid = true;
@@ -1251,7 +1252,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                     break;
                 case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
                 {
-                    VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;   // do not add to m_AllocatedMemory to avoid double deleting
@@ -1260,14 +1261,14 @@ void ConditionMgr::LoadConditions(bool isReload)
                 {
                     //! TODO: PAIR_32 ?
                     std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                    SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                    AddToConditionList(SmartEventConditionStore[key][cond->SourceGroup], cond);
                     valid = true;
                     ++count;
                     continue;
                 }
                 case CONDITION_SOURCE_TYPE_NPC_VENDOR:
                 {
-                    NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                    AddToConditionList(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                     valid = true;
                     ++count;
                     continue;
@@ -1293,14 +1294,61 @@ void ConditionMgr::LoadConditions(bool isReload)
         //add new Condition to storage based on Type/Entry
         if (cond->SourceType == CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT && cond->ConditionType == CONDITION_AURA)
             SpellsUsedInSpellClickConditions.insert(cond->ConditionValue1);
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        AddToConditionList(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
         ++count;
     }
     while (result->NextRow());
 
+    ResolveReferences();
+
     TC_LOG_INFO("server.loading", ">> Loaded %u conditions in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
+void ConditionMgr::ResolveReferences()
+{
+    auto resolve = [this](Condition* cond)
+    {
+        if (!cond->ReferenceId)
+            return;
+
+        ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(cond->ReferenceId);
+        if (ref != ConditionReferenceStore.end())
+            cond->ReferencedConditions = &ref->second;
+        else
+            TC_LOG_ERROR("sql.sql", "%s Reference template -%u not found.", cond->ToString().c_str(), cond->ReferenceId);
+    };
+
+    auto resolveEntries = [&resolve](ConditionsByEntryMap const& entries)
+    {
+        for (ConditionsByEntryMap::value_type const& entry : entries)
+            for (Condition* cond : entry.second)
+                resolve(cond);
+    };
+
+    // grouped conditions (loot, gossip, spell implicit targets) are all owned by AllocatedMemoryStore
+    for (Condition* cond : AllocatedMemoryStore)
+        resolve(cond);
+
+    for (ConditionsByEntryMap const& entries : ConditionStore)
+        resolveEntries(entries);
+
+    for (ConditionReferenceContainer::value_type const& ref : ConditionReferenceStore)
+        for (Condition* cond : ref.second)
+            resolve(cond);
+
+    for (ConditionEntriesByCreatureIdMap::value_type const& entries : VehicleSpellConditionStore)
+        resolveEntries(entries.second);
+
+    for (ConditionEntriesByCreatureIdMap::value_type const& entries : SpellClickEventConditionStore)
+        resolveEntries(entries.second);
+
+    for (ConditionEntriesByCreatureIdMap::value_type const& entries : NpcVendorConditionContainerStore)
+        resolveEntries(entries.second);
+
+    for (SmartEventConditionContainer::value_type const& entries : SmartEventConditionStore)
+        resolveEntries(entries.second);
+}
+
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot) const
 {
     if (!loot)
@@ -1326,7 +1374,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond) const
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1345,7 +1393,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond) const
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1461,7 +1509,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond) const
                     return false;
                 }
             }
-            sharedList->push_back(cond);
+            AddToConditionList(*sharedList, cond);
             break;
         }
     }
@@ -202,6 +202,7 @@ struct TC_GAME_API Condition
     uint32                  ErrorType;
     uint32                  ErrorTextId;
     uint32                  ReferenceId;
+    std::vector<Condition*> const* ReferencedConditions; // reference template of ReferenceId, resolved when conditions are loaded
     uint32                  ScriptId;
     uint8                   ConditionTarget;
     bool                    NegativeCondition;
@@ -219,6 +220,7 @@ struct TC_GAME_API Condition
         ConditionValue2    = 0;
         ConditionValue3    = 0;
         ReferenceId        = 0;
+        ReferencedConditions = nullptr;
         ErrorType          = 0;
         ErrorTextId        = 0;
         ScriptId           = 0;
@@ -256,6 +258,11 @@ class TC_GAME_API ConditionMgr
         bool IsObjectMeetToConditions(WorldObject* object, ConditionContainer const& conditions) const;
         bool IsObjectMeetToConditions(WorldObject* object1, WorldObject* object2, ConditionContainer const& conditions) const;
         bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
+        // Adds a condition to a list keeping conditions of the same ElseGroup next to each other, as expected by EvaluateConditionList
+        static void AddToConditionList(ConditionContainer& conditions, Condition* cond);
+        // Returns true when all loaded conditions of any ElseGroup pass the check, stops at the first ElseGroup that does
+        template<typename Check>
+        static bool EvaluateConditionList(ConditionContainer const& conditions, Check check);
         static bool CanHaveSourceGroupSet(ConditionSourceType sourceType);
         static bool CanHaveSourceIdSet(ConditionSourceType sourceType);
         bool IsObjectMeetingNotGroupedConditions(ConditionSourceType sourceType, uint32 entry, ConditionSourceInfo& sourceInfo) const;
@@ -265,6 +272,10 @@ class TC_GAME_API ConditionMgr
         ConditionContainer const* GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId) const;
         bool IsObjectMeetingVehicleSpellConditions(uint32 creatureId, uint32 spellId, Player* player, Unit* vehicle) const;
         bool IsObjectMeetingSmartEventConditions(int32 entryOrGuid, uint32 eventId, uint32 sourceType, Unit* unit, WorldObject* baseObject) const;
+        bool IsObjectMeetingSmartEventConditions(ConditionContainer const* conditions, Unit* unit, WorldObject* baseObject) const;
+        ConditionContainer const* GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
+        // Incremented every time conditions are (re)loaded, pointers returned by GetConditionsFor* are only valid for one generation
+        uint32 GetConditionsGeneration() const { return _conditionsGeneration; }
         bool IsObjectMeetingVendorItemConditions(uint32 creatureId, uint32 itemId, Player* player, Creature* vendor) const;
 
         bool IsSpellUsedInSpellClickConditions(uint32 spellId) const;
@@ -288,6 +299,7 @@ class TC_GAME_API ConditionMgr
         bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const;
 
         static void LogUselessConditionValue(Condition* cond, uint8 index, uint32 value);
+        void ResolveReferences();
 
         void Clean(); // free up resources
         std::vector<Condition*> AllocatedMemoryStore; // some garbage collection :)
@@ -300,8 +312,41 @@ class TC_GAME_API ConditionMgr
         SmartEventConditionContainer    SmartEventConditionStore;
 
         std::unordered_set<uint32> SpellsUsedInSpellClickConditions;
+
+        uint32 _conditionsGeneration;
 };
 
+template<typename Check>
+bool ConditionMgr::EvaluateConditionList(ConditionContainer const& conditions, Check check)
+{
+    bool hasGroup = false;
+    bool groupMet = true;
+    uint32 elseGroup = 0;
+    for (Condition const* condition : conditions)
+    {
+        if (!condition->isLoaded())
+            continue;
+
+        if (!hasGroup || condition->ElseGroup != elseGroup)
+        {
+            // previous group passed, no need to look at the others
+            if (hasGroup && groupMet)
+                return true;
+
+            hasGroup = true;
+            groupMet = true;
+            elseGroup = condition->ElseGroup;
+        }
+        else if (!groupMet) // another condition in this group was unmatched before this, the group is false anyway
+            continue;
+
+        if (!check(condition))
+            groupMet = false;
+    }
+
+    return hasGroup && groupMet;
+}
+
 #define sConditionMgr ConditionMgr::instance()
 
 #endif
@@ -43,6 +43,7 @@
 #include "QueryPackets.h"
 #include "QuestDef.h"
 #include "ScriptedGossip.h"
+#include "SlabPool.h"
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
@@ -249,6 +250,23 @@ bool ForcedDespawnDelayEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
     return true;
 }
 
+void* Creature::operator new(size_t size)
+{
+    return GetAllocationPool().Allocate(size);
+}
+
+void Creature::operator delete(void* ptr)
+{
+    Trinity::SlabPool::Deallocate(ptr);
+}
+
+Trinity::SlabPool& Creature::GetAllocationPool()
+{
+    // never destroyed, creatures may still be deleted during static destruction
+    static Trinity::SlabPool* pool = new Trinity::SlabPool("creature");
+    return *pool;
+}
+
 Creature::Creature(bool isWorldObject): Unit(isWorldObject), MapObject(), m_groupLootTimer(0), lootingGroupLowGUID(0), m_PlayerDamageReq(0), m_lootRecipient(), m_lootRecipientGroup(0), _pickpocketLootRestore(0),
     m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(300), m_corpseDelay(60), m_wanderDistance(0.0f), m_boundaryCheckTime(2500), m_combatPulseTime(0), m_combatPulseDelay(0), m_reactState(REACT_AGGRESSIVE),
     m_defaultMovementType(IDLE_MOTION_TYPE), m_spawnId(0), m_equipmentId(0), m_originalEquipmentId(0), m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false), m_cannotReachTarget(false), m_cannotReachTimer(0),
@@ -57,11 +57,21 @@ typedef std::list<VendorItemCount> VendorItemCounts;
 typedef std::vector<uint8> CreatureTextRepeatIds;
 typedef std::unordered_map<uint8, CreatureTextRepeatIds> CreatureTextRepeatGroup;
 
+namespace Trinity
+{
+    class SlabPool;
+}
+
 class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public MapObject
 {
     public:
         explicit Creature(bool isWorldObject = false);
 
+        // creatures are constantly created and destroyed by grid loading, keep them packed in slabs instead of spreading them over the heap
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+        static Trinity::SlabPool& GetAllocationPool();
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -25,6 +25,23 @@
 #include "ObjectAccessor.h"
 #include "Pet.h"
 #include "Player.h"
+#include "SlabPool.h"
+
+void* TempSummon::operator new(size_t size)
+{
+    return GetAllocationPool().Allocate(size);
+}
+
+void TempSummon::operator delete(void* ptr)
+{
+    Trinity::SlabPool::Deallocate(ptr);
+}
+
+Trinity::SlabPool& TempSummon::GetAllocationPool()
+{
+    static Trinity::SlabPool* pool = new Trinity::SlabPool("summon");
+    return *pool;
+}
 
 TempSummon::TempSummon(SummonPropertiesEntry const* properties, WorldObject* owner, bool isWorldObject) :
 Creature(isWorldObject), m_Properties(properties), m_type(TEMPSUMMON_MANUAL_DESPAWN),
@@ -37,6 +37,12 @@ class TC_GAME_API TempSummon : public Creature
     public:
         explicit TempSummon(SummonPropertiesEntry const* properties, WorldObject* owner, bool isWorldObject);
         virtual ~TempSummon() { }
+
+        // summons (including pets and totems) are short lived, give them their own slabs so they do not fragment the creature ones
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+        static Trinity::SlabPool& GetAllocationPool();
+
         void Update(uint32 time) override;
         virtual void InitStats(uint32 lifetime);
         virtual void InitSummon();
@@ -37,6 +37,7 @@
 #include "PoolMgr.h"
 #include "QueryPackets.h"
 #include "ScriptMgr.h"
+#include "SlabPool.h"
 #include "SpellMgr.h"
 #include "Transport.h"
 #include "UpdateFieldFlags.h"
@@ -106,6 +107,22 @@ QuaternionData QuaternionData::fromEulerAnglesZYX(float Z, float Y, float X)
     return QuaternionData(quat.x, quat.y, quat.z, quat.w);
 }
 
+void* GameObject::operator new(size_t size)
+{
+    return GetAllocationPool().Allocate(size);
+}
+
+void GameObject::operator delete(void* ptr)
+{
+    Trinity::SlabPool::Deallocate(ptr);
+}
+
+Trinity::SlabPool& GameObject::GetAllocationPool()
+{
+    static Trinity::SlabPool* pool = new Trinity::SlabPool("gameobject");
+    return *pool;
+}
+
 GameObject::GameObject() : WorldObject(false), MapObject(),
     m_model(nullptr), m_goValue(), m_AI(nullptr), m_respawnCompatibilityMode(false)
 {
@@ -2427,6 +2444,8 @@ void GameObject::EnableCollision(bool enable)
         GetMap()->InsertGameObjectModel(*m_model);*/
 
     m_model->enable(enable ? GetPhaseMask() : 0);
+    if (IsInWorld())
+        GetMap()->GameObjectModelChanged();
 }
 
 void GameObject::UpdateModel()
@@ -2523,65 +2542,68 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    if (updateType == UPDATETYPE_VALUES)
+        updateMask = _changesMask;
+    else
+        updateMask.SetNonZeroBits(m_uint32Values);
+
+    UpdateFieldFlagMasks::For(flags).Filter(updateMask, visibleFlag, _fieldNotifyFlags);
+
+    if (forcedFlags)
+        updateMask.SetBit(GAMEOBJECT_FLAGS);
+
+    updateMask.ForEachSetBit([&](uint32 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-            (index == GAMEOBJECT_FLAGS && forcedFlags))
+        if (index == GAMEOBJECT_DYNAMIC)
         {
-            updateMask.SetBit(index);
-
-            if (index == GAMEOBJECT_DYNAMIC)
+            uint16 dynFlags = 0;
+            int16 pathProgress = -1;
+            switch (GetGoType())
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+                    else if (targetIsGM)
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_TRANSPORT:
+                case GAMEOBJECT_TYPE_MO_TRANSPORT:
                 {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
+                    if (uint32 transportPeriod = GetTransportPeriod())
                     {
-                        if (uint32 transportPeriod = GetTransportPeriod())
-                        {
-                            float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
-                            pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
-                        }
-                        break;
+                        float timer = float(m_goValue.Transport.PathProgress % transportPeriod);
+                        pathProgress = int16(timer / float(transportPeriod) * 65535.0f);
                     }
-                    default:
-                        break;
+                    break;
                 }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
+                default:
+                    break;
             }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
-                    if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
 
-                fieldBuffer << goFlags;
-            }
-            else
-                fieldBuffer << m_uint32Values[index];                // other cases
+            fieldBuffer << uint16(dynFlags);
+            fieldBuffer << int16(pathProgress);
         }
-    }
+        else if (index == GAMEOBJECT_FLAGS)
+        {
+            uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST)
+                if (GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+
+            fieldBuffer << goFlags;
+        }
+        else
+            fieldBuffer << m_uint32Values[index];                // other cases
+    });
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
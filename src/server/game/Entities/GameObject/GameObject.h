@@ -76,12 +76,22 @@ enum LootState
 // 5 sec for bobber catch
 #define FISHING_BOBBER_READY_TIME 5
 
+namespace Trinity
+{
+    class SlabPool;
+}
+
 class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>, public MapObject
 {
     public:
         explicit GameObject();
         ~GameObject();
 
+        // allocated from slabs like creatures, grid loading creates and destroys them in large numbers
+        static void* operator new(size_t size);
+        static void operator delete(void* ptr);
+        static Trinity::SlabPool& GetAllocationPool();
+
         void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, Player* target) const override;
 
         void AddToWorld() override;
@@ -37,6 +37,7 @@
 #include "PathGenerator.h"
 #include "Player.h"
 #include "ReputationMgr.h"
+#include "ScratchVector.h"
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "StringConvert.h"
@@ -74,6 +75,7 @@ Object::Object() : m_PackGUID(sizeof(uint64)+1)
     m_inWorld           = false;
     m_isNewObject       = false;
     m_objectUpdated     = false;
+    m_updateObjectIndex = 0;
 }
 
 WorldObject::~WorldObject()
@@ -481,15 +483,17 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
     ASSERT(flags);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    if (updateType == UPDATETYPE_VALUES)
+        updateMask = _changesMask;
+    else
+        updateMask.SetNonZeroBits(m_uint32Values);
+
+    UpdateFieldFlagMasks::For(flags).Filter(updateMask, visibleFlag, _fieldNotifyFlags);
+
+    updateMask.ForEachSetBit([&](uint32 index)
     {
-        if (_fieldNotifyFlags & flags[index] ||
-            ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+        fieldBuffer << m_uint32Values[index];
+    });
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
@@ -1228,22 +1232,30 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, LineOfSightChecks ch
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-
-        return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
+        VMAP::LineOfSightRay ray;
+        GetLineOfSightRay(ox, oy, oz, ray);
+        return GetMap()->isInLineOfSight(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, GetPhaseMask(), checks, ignoreFlags);
     }
 
     return true;
 }
 
+void WorldObject::GetLineOfSightRay(float ox, float oy, float oz, VMAP::LineOfSightRay& ray) const
+{
+    oz += GetCollisionHeight();
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(ray.x1, ray.y1, ray.z1);
+        ray.z1 += GetCollisionHeight();
+    }
+    else
+        GetHitSpherePointFor({ ox, oy, oz }, ray.x1, ray.y1, ray.z1);
+
+    ray.x2 = ox;
+    ray.y2 = oy;
+    ray.z2 = oz;
+}
+
 bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!IsInMap(obj))
@@ -1490,6 +1502,38 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float &z, float* grou
     }
 }
 
+void WorldObject::UpdateAllowedPositionZ(G3D::Vector3* points, uint32 count) const
+{
+    // walking units only need the map height, which can be looked up for all points at once
+    Unit const* unit = ToUnit();
+    if (GetTransport() || !unit || unit->CanFly() || unit->CanSwim())
+    {
+        for (uint32 i = 0; i < count; ++i)
+            UpdateAllowedPositionZ(points[i].x, points[i].y, points[i].z);
+        return;
+    }
+
+    Trinity::ScratchVector<float> x, y, z, heights;
+    x->resize(count);
+    y->resize(count);
+    z->resize(count);
+    heights->resize(count);
+    float collisionHeight = GetCollisionHeight();
+    for (uint32 i = 0; i < count; ++i)
+    {
+        (*x)[i] = points[i].x;
+        (*y)[i] = points[i].y;
+        (*z)[i] = points[i].z != MAX_HEIGHT ? points[i].z + collisionHeight : MAX_HEIGHT;
+    }
+
+    GetMap()->GetHeights(GetPhaseMask(), x->data(), y->data(), z->data(), heights->data(), count);
+
+    float hoverOffset = unit->GetHoverOffset();
+    for (uint32 i = 0; i < count; ++i)
+        if ((*heights)[i] > INVALID_HEIGHT)
+            points[i].z = (*heights)[i] + hoverOffset;
+}
+
 float WorldObject::GetGridActivationRange() const
 {
     if (isActiveObject())
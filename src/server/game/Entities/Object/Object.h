@@ -58,8 +58,15 @@ class ZoneScript;
 struct FactionTemplateEntry;
 struct PositionFullTerrainStatus;
 struct QuaternionData;
+
+namespace G3D
+{
+    class Vector3;
+}
 enum ZLiquidStatus : uint32;
 
+namespace VMAP { struct LineOfSightRay; }
+
 typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
 
 float const DEFAULT_COLLISION_HEIGHT = 2.03128f; // Most common value in dbc
@@ -233,6 +240,11 @@ class TC_GAME_API Object
         bool m_objectUpdated;
 
     private:
+        friend class Map;
+
+        // position in the owning map's dirty object list, only valid while m_objectUpdated is set
+        uint32 m_updateObjectIndex;
+
         bool m_inWorld;
         bool m_isNewObject;
 
@@ -308,6 +320,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
         void UpdateGroundPositionZ(float x, float y, float &z) const;
         void UpdateAllowedPositionZ(float x, float y, float &z, float* groundZ = nullptr) const;
+        void UpdateAllowedPositionZ(G3D::Vector3* points, uint32 count) const;
 
         void GetRandomPoint(Position const& srcPos, float distance, float& rand_x, float& rand_y, float& rand_z) const;
         Position GetRandomPoint(Position const& srcPos, float distance) const;
@@ -351,6 +364,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         bool IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D = true) const;
         bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool incOwnRadius = true, bool incTargetRadius = true) const;
         bool IsWithinLOS(float x, float y, float z, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
+        void GetLineOfSightRay(float x, float y, float z, VMAP::LineOfSightRay& ray) const; // ray traced by IsWithinLOS
         bool IsWithinLOSInMap(WorldObject const* obj, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing) const;
         Position GetHitSpherePointFor(Position const& dest) const;
         void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z) const;
@@ -1566,3 +1566,75 @@ uint32 CorpseUpdateFieldFlags[CORPSE_END] =
     UF_FLAG_DYNAMIC,                                        // CORPSE_FIELD_DYNAMIC_FLAGS
     UF_FLAG_NONE,                                           // CORPSE_FIELD_PAD
 };
+
+UpdateFieldFlagMasks::UpdateFieldFlagMasks(uint32 const* flags, uint32 count) : _count(count)
+{
+    for (uint32 bit = 0; bit < UF_FLAG_COUNT; ++bit)
+    {
+        _masks[bit].SetCount(count);
+        for (uint32 index = 0; index < count; ++index)
+            if (flags[index] & (1 << bit))
+                _masks[bit].SetBit(index);
+    }
+}
+
+void UpdateFieldFlagMasks::Filter(UpdateMask& mask, uint32 visibleFlags, uint32 forcedFlags) const
+{
+    ASSERT(mask.GetCount() <= _count);
+
+    UpdateMask const* visible[UF_FLAG_COUNT];
+    UpdateMask const* forced[UF_FLAG_COUNT];
+    uint32 visibleCount = 0;
+    uint32 forcedCount = 0;
+    for (uint32 bit = 0; bit < UF_FLAG_COUNT; ++bit)
+    {
+        if (visibleFlags & (1 << bit))
+            visible[visibleCount++] = &_masks[bit];
+        if (forcedFlags & (1 << bit))
+            forced[forcedCount++] = &_masks[bit];
+    }
+
+    for (uint32 block = 0; block < mask.GetBlockCount(); ++block)
+    {
+        UpdateMask::ClientUpdateMaskType visibleBits = 0;
+        for (uint32 i = 0; i < visibleCount; ++i)
+            visibleBits |= visible[i]->GetBlock(block);
+
+        UpdateMask::ClientUpdateMaskType forcedBits = 0;
+        for (uint32 i = 0; i < forcedCount; ++i)
+            forcedBits |= forced[i]->GetBlock(block);
+
+        mask.SetBlock(block, (mask.GetBlock(block) & visibleBits) | forcedBits);
+    }
+
+    // the tables of units and items are shared by types with less fields, drop anything forced past the end
+    if (uint32 lastBits = mask.GetCount() % UpdateMask::CLIENT_UPDATE_MASK_BITS)
+    {
+        uint32 lastBlock = mask.GetBlockCount() - 1;
+        mask.SetBlock(lastBlock, mask.GetBlock(lastBlock) & ((UpdateMask::ClientUpdateMaskType(1) << lastBits) - 1));
+    }
+}
+
+namespace
+{
+    UpdateFieldFlagMasks const ItemUpdateFieldFlagMasks(ItemUpdateFieldFlags, CONTAINER_END);
+    UpdateFieldFlagMasks const UnitUpdateFieldFlagMasks(UnitUpdateFieldFlags, PLAYER_END);
+    UpdateFieldFlagMasks const GameObjectUpdateFieldFlagMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END);
+    UpdateFieldFlagMasks const DynamicObjectUpdateFieldFlagMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END);
+    UpdateFieldFlagMasks const CorpseUpdateFieldFlagMasks(CorpseUpdateFieldFlags, CORPSE_END);
+}
+
+UpdateFieldFlagMasks const& UpdateFieldFlagMasks::For(uint32 const* flags)
+{
+    if (flags == ItemUpdateFieldFlags)
+        return ItemUpdateFieldFlagMasks;
+    if (flags == UnitUpdateFieldFlags)
+        return UnitUpdateFieldFlagMasks;
+    if (flags == GameObjectUpdateFieldFlags)
+        return GameObjectUpdateFieldFlagMasks;
+    if (flags == DynamicObjectUpdateFieldFlags)
+        return DynamicObjectUpdateFieldFlagMasks;
+
+    ASSERT(flags == CorpseUpdateFieldFlags);
+    return CorpseUpdateFieldFlagMasks;
+}
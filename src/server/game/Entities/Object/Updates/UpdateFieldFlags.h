@@ -20,6 +20,7 @@
 
 #include "UpdateFields.h"
 #include "Define.h"
+#include "UpdateMask.h"
 
 enum UpdatefieldFlags
 {
@@ -32,7 +33,9 @@ enum UpdatefieldFlags
     UF_FLAG_SPECIAL_INFO = 0x020,
     UF_FLAG_PARTY_MEMBER = 0x040,
     UF_FLAG_UNUSED2      = 0x080,
-    UF_FLAG_DYNAMIC      = 0x100
+    UF_FLAG_DYNAMIC      = 0x100,
+
+    UF_FLAG_COUNT        = 9
 };
 
 TC_GAME_API extern uint32 ItemUpdateFieldFlags[CONTAINER_END];
@@ -41,4 +44,21 @@ TC_GAME_API extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
 TC_GAME_API extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 TC_GAME_API extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 
+/// Per flag bitmaps of one of the field flag tables above, used to select the fields visible to a player with word operations
+class TC_GAME_API UpdateFieldFlagMasks
+{
+    public:
+        UpdateFieldFlagMasks(uint32 const* flags, uint32 count);
+
+        /// Keeps the fields of mask having any of visibleFlags and adds all fields having any of forcedFlags
+        void Filter(UpdateMask& mask, uint32 visibleFlags, uint32 forcedFlags) const;
+
+        /// Returns the bitmaps built for one of the field flag tables
+        static UpdateFieldFlagMasks const& For(uint32 const* flags);
+
+    private:
+        uint32 _count;
+        std::array<UpdateMask, UF_FLAG_COUNT> _masks;
+};
+
 #endif // _UPDATEFIELDFLAGS_H
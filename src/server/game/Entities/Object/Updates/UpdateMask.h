@@ -20,7 +20,11 @@
 
 #include "UpdateFields.h"
 #include "ByteBuffer.h"
+#include "Errors.h"
+#include "advstd.h"
+#include <array>
 
+/// Bitset of update fields, stored inline and packed the same way the client reads it
 class UpdateMask
 {
     public:
@@ -30,70 +34,68 @@ class UpdateMask
         enum UpdateMaskCount
         {
             CLIENT_UPDATE_MASK_BITS = sizeof(ClientUpdateMaskType) * 8,
+            MAX_BLOCK_COUNT = (PLAYER_END + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS
         };
 
-        UpdateMask() : _fieldCount(0), _blockCount(0), _bits(nullptr) { }
+        UpdateMask() : _fieldCount(0), _blockCount(0), _blocks() { }
 
-        UpdateMask(UpdateMask const& right) : _bits(nullptr)
-        {
-            SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
-        }
+        void SetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS); }
+        void UnsetBit(uint32 index) { _blocks[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+        bool GetBit(uint32 index) const { return (_blocks[index / CLIENT_UPDATE_MASK_BITS] & (ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS))) != 0; }
 
-        ~UpdateMask() { delete[] _bits; }
+        ClientUpdateMaskType GetBlock(uint32 block) const { return _blocks[block]; }
+        void SetBlock(uint32 block, ClientUpdateMaskType bits) { _blocks[block] = bits; }
 
-        void SetBit(uint32 index) { _bits[index] = 1; }
-        void UnsetBit(uint32 index) { _bits[index] = 0; }
-        bool GetBit(uint32 index) const { return _bits[index] != 0; }
+        /// Sets the bits of all fields with a non zero value, values must hold GetCount() fields
+        void SetNonZeroBits(uint32 const* values)
+        {
+            for (uint32 i = 0; i < _fieldCount; ++i)
+                _blocks[i / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(values[i] != 0) << (i % CLIENT_UPDATE_MASK_BITS);
+        }
 
-        void AppendToPacket(ByteBuffer* data)
+        /// Calls callback with the index of every set bit, in ascending order
+        template<typename Callback>
+        void ForEachSetBit(Callback&& callback) const
         {
-            for (uint32 i = 0; i < GetBlockCount(); ++i)
+            for (uint32 i = 0; i < _blockCount; ++i)
             {
-                ClientUpdateMaskType maskPart = 0;
-                for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                    if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                        maskPart |= 1 << j;
-
-                *data << maskPart;
+                ClientUpdateMaskType block = _blocks[i];
+                while (block)
+                {
+                    callback(i * CLIENT_UPDATE_MASK_BITS + uint32(advstd::countr_zero(block)));
+                    block &= block - 1;
+                }
             }
         }
 
+        void AppendToPacket(ByteBuffer* data) const
+        {
+            for (uint32 i = 0; i < _blockCount; ++i)
+                *data << _blocks[i];
+        }
+
         uint32 GetBlockCount() const { return _blockCount; }
         uint32 GetCount() const { return _fieldCount; }
 
         void SetCount(uint32 valuesCount)
         {
-            delete[] _bits;
+            ASSERT(valuesCount <= PLAYER_END);
 
             _fieldCount = valuesCount;
             _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
-
-            _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            _blocks.fill(0);
         }
 
         void Clear()
         {
-            if (_bits)
-                memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
-        }
-
-        UpdateMask& operator=(UpdateMask const& right)
-        {
-            if (this == &right)
-                return *this;
-
-            SetCount(right.GetCount());
-            memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
-            return *this;
+            std::fill_n(_blocks.begin(), _blockCount, 0);
         }
 
         UpdateMask& operator&=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
-                _bits[i] &= right._bits[i];
+            for (uint32 i = 0; i < _blockCount; ++i)
+                _blocks[i] &= right._blocks[i];
 
             return *this;
         }
@@ -101,8 +103,8 @@ class UpdateMask
         UpdateMask& operator|=(UpdateMask const& right)
         {
             ASSERT(right.GetCount() <= GetCount());
-            for (uint32 i = 0; i < _fieldCount; ++i)
-                _bits[i] |= right._bits[i];
+            for (uint32 i = 0; i < _blockCount; ++i)
+                _blocks[i] |= right._blocks[i];
 
             return *this;
         }
@@ -117,7 +119,7 @@ class UpdateMask
     private:
         uint32 _fieldCount;
         uint32 _blockCount;
-        uint8* _bits;
+        std::array<ClientUpdateMaskType, MAX_BLOCK_COUNT> _blocks;
 };
 
 #endif
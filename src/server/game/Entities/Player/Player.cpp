@@ -4442,7 +4442,7 @@ void Player::DeleteFromDB(ObjectGuid playerguid, uint32 accountId, bool updateRe
     if (updateRealmChars)
         sWorld->UpdateRealmCharCount(accountId);
 
-    sCharacterCache->DeleteCharacterCacheEntry(playerguid, name);
+    sCharacterCache->DeleteCharacterCacheEntry(playerguid);
 }
 
 /**
@@ -37,7 +37,7 @@ void HashMapHolder<T>::Insert(T* o)
         || std::is_same<Transport, T>::value,
         "Only Player and Transport can be registered in global HashMapHolder");
 
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
+    std::unique_lock<LockType> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
 }
@@ -45,7 +45,7 @@ void HashMapHolder<T>::Insert(T* o)
 template<class T>
 void HashMapHolder<T>::Remove(T* o)
 {
-    std::unique_lock<std::shared_mutex> lock(*GetLock());
+    std::unique_lock<LockType> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
 }
@@ -53,7 +53,7 @@ void HashMapHolder<T>::Remove(T* o)
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
+    std::shared_lock<LockType> lock(*GetLock());
 
     typename MapType::iterator itr = GetContainer().find(guid);
     return (itr != GetContainer().end()) ? itr->second : nullptr;
@@ -67,9 +67,9 @@ auto HashMapHolder<T>::GetContainer() -> MapType&
 }
 
 template<class T>
-std::shared_mutex* HashMapHolder<T>::GetLock()
+auto HashMapHolder<T>::GetLock() -> LockType*
 {
-    static std::shared_mutex _lock;
+    static LockType _lock;
     return &_lock;
 }
 
@@ -85,14 +85,17 @@ namespace PlayerNameMapHolder
 {
     typedef std::unordered_map<std::string, Player*> MapType;
     static MapType PlayerNameMap;
+    static Trinity::DistributedSharedMutex PlayerNameMapLock;
 
     void Insert(Player* p)
     {
+        std::unique_lock<Trinity::DistributedSharedMutex> lock(PlayerNameMapLock);
         PlayerNameMap[p->GetName()] = p;
     }
 
     void Remove(Player* p)
     {
+        std::unique_lock<Trinity::DistributedSharedMutex> lock(PlayerNameMapLock);
         PlayerNameMap.erase(p->GetName());
     }
 
@@ -102,6 +105,7 @@ namespace PlayerNameMapHolder
         if (!normalizePlayerName(charName))
             return nullptr;
 
+        std::shared_lock<Trinity::DistributedSharedMutex> lock(PlayerNameMapLock);
         auto itr = PlayerNameMap.find(charName);
         return (itr != PlayerNameMap.end()) ? itr->second : nullptr;
     }
@@ -263,7 +267,7 @@ Player* ObjectAccessor::FindConnectedPlayerByName(std::string_view name)
 
 void ObjectAccessor::SaveAllPlayers()
 {
-    std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+    std::shared_lock<HashMapHolder<Player>::LockType> lock(*HashMapHolder<Player>::GetLock());
 
     HashMapHolder<Player>::MapType const& m = GetPlayers();
     for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
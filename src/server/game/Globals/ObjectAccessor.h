@@ -18,6 +18,7 @@
 #ifndef TRINITY_OBJECTACCESSOR_H
 #define TRINITY_OBJECTACCESSOR_H
 
+#include "DistributedSharedMutex.h"
 #include "ObjectGuid.h"
 #include <shared_mutex>
 #include <unordered_map>
@@ -43,6 +44,8 @@ class TC_GAME_API HashMapHolder
 public:
 
     typedef std::unordered_map<ObjectGuid, T*> MapType;
+    // lookups come from all map threads while inserts only happen on login/logout and transport creation
+    typedef Trinity::DistributedSharedMutex LockType;
 
     static void Insert(T* o);
 
@@ -52,7 +55,7 @@ public:
 
     static MapType& GetContainer();
 
-    static std::shared_mutex* GetLock();
+    static LockType* GetLock();
 };
 
 namespace ObjectAccessor
@@ -64,6 +64,9 @@ class LoginQueryHolder : public CharacterDatabaseQueryHolder
         ObjectGuid GetGuid() const { return m_guid; }
         uint32 GetAccountId() const { return m_accountId; }
         bool Initialize();
+
+        // the login queries do not depend on each other, they may run on several async connections at once
+        static constexpr uint32 MAX_PARALLEL_TASKS = 4;
 };
 
 bool LoginQueryHolder::Initialize()
@@ -727,8 +730,14 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
-    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this](SQLQueryHolderBase const& holder)
+    TimePoint queryStart = std::chrono::steady_clock::now();
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder, LoginQueryHolder::MAX_PARALLEL_TASKS)).AfterComplete([this, queryStart](SQLQueryHolderBase const& holder)
     {
+        TC_METRIC_VALUE("player_login_query_holder_time", std::chrono::nanoseconds(std::chrono::steady_clock::now() - queryStart));
+        if (sMetric->IsEnabled())
+            for (size_t i = 0; i < holder.GetSize(); ++i)
+                TC_METRIC_VALUE("player_login_query_time", holder.GetQueryTime(i), TC_METRIC_TAG("query", std::to_string(i)));
+
         HandlePlayerLogin(static_cast<LoginQueryHolder const&>(holder));
     });
 }
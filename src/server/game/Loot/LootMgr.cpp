@@ -29,6 +29,8 @@
 #include "SpellMgr.h"
 #include "Util.h"
 #include "World.h"
+#include <algorithm>
+#include <limits>
 
 static Rates const qualityToRate[MAX_ITEM_QUALITY] =
 {
@@ -59,14 +61,14 @@ struct LootGroupInvalidSelector
 {
     explicit LootGroupInvalidSelector(Loot const& loot, uint16 lootMode) : _loot(loot), _lootMode(lootMode) { }
 
-    bool operator()(LootStoreItem* item) const
+    bool operator()(LootStoreItem const& item) const
     {
-        if (!(item->lootmode & _lootMode))
+        if (!(item.lootmode & _lootMode))
             return true;
 
         uint8 foundDuplicates = 0;
         for (std::vector<LootItem>::const_iterator itr = _loot.items.begin(); itr != _loot.items.end(); ++itr)
-            if (itr->itemid == item->itemid)
+            if (itr->itemid == item.itemid)
                 if (++foundDuplicates == _loot.maxDuplicates)
                     return true;
 
@@ -78,36 +80,6 @@ private:
     uint16 _lootMode;
 };
 
-class LootTemplate::LootGroup                               // A set of loot definitions for items (refs are not allowed)
-{
-    public:
-        LootGroup() { }
-        ~LootGroup();
-
-        void AddEntry(LootStoreItem* item);                 // Adds an entry to the group (at loading stage)
-        bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
-        bool HasQuestDropForPlayer(Player const* player) const;
-                                                            // The same for active quests of the player
-        void Process(Loot& loot, uint16 lootMode) const;    // Rolls an item from the group (if any) and adds the item to the loot
-        float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
-        float TotalChance() const;                          // Overall chance for the group
-
-        void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
-        void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
-        LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
-        LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
-        void CopyConditions(ConditionContainer conditions);
-    private:
-        LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
-        LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
-
-        LootStoreItem const* Roll(Loot& loot, uint16 lootMode) const;   // Rolls an item from the group, returns NULL if all miss their chances
-
-        // This class must never be copied - storing pointers
-        LootGroup(LootGroup const&) = delete;
-        LootGroup& operator=(LootGroup const&) = delete;
-};
-
 //Remove all data and free all memory
 void LootStore::Clear()
 {
@@ -161,13 +133,10 @@ uint32 LootStore::LoadLootTable()
             return 0;
         }
 
-        LootStoreItem* storeitem = new LootStoreItem(item, reference, chance, needsquest, lootmode, groupid, mincount, maxcount);
+        LootStoreItem storeitem(item, reference, chance, needsquest, lootmode, groupid, mincount, maxcount);
 
-        if (!storeitem->IsValid(*this, entry))            // Validity checks
-        {
-            delete storeitem;
+        if (!storeitem.IsValid(*this, entry))             // Validity checks
             continue;
-        }
 
         // Looking for the template of the entry
                                                          // often entries are put together
@@ -347,69 +316,95 @@ bool LootStoreItem::IsValid(LootStore const& store, uint32 entry) const
 // --------- LootTemplate::LootGroup ---------
 //
 
-LootTemplate::LootGroup::~LootGroup()
+// Adds an entry to the group (at loading stage)
+void LootTemplate::LootGroup::AddEntry(LootStoreItem const& item)
 {
-    while (!ExplicitlyChanced.empty())
+    if (item.chance != 0)
     {
-        delete ExplicitlyChanced.back();
-        ExplicitlyChanced.pop_back();
+        float total = ExplicitlyChancedCumulative.empty() ? 0.0f : ExplicitlyChancedCumulative.back();
+        ExplicitlyChanced.push_back(item);
+        ExplicitlyChancedCumulative.push_back(total + item.chance);
     }
+    else
+        EqualChanced.push_back(item);
 
-    while (!EqualChanced.empty())
-    {
-        delete EqualChanced.back();
-        EqualChanced.pop_back();
-    }
+    ItemIds.insert(std::upper_bound(ItemIds.begin(), ItemIds.end(), item.itemid), item.itemid);
+    CommonLootMode &= item.lootmode;
 }
 
-// Adds an entry to the group (at loading stage)
-void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
+// True if LootGroupInvalidSelector could select any entry of the group
+bool LootTemplate::LootGroup::IsAnyEntryInvalid(Loot const& loot, uint16 lootMode) const
 {
-    if (item->chance != 0)
-        ExplicitlyChanced.push_back(item);
-    else
-        EqualChanced.push_back(item);
+    if (!(CommonLootMode & lootMode))
+        return true;
+
+    for (LootItem const& lootItem : loot.items)
+        if (std::binary_search(ItemIds.begin(), ItemIds.end(), lootItem.itemid))
+            return true;
+
+    return false;
 }
 
-// Rolls an item from the group, returns NULL if all miss their chances
-LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, uint16 lootMode) const
+// Rolls an item from the group with the given random values, returns NULL if all miss their chances
+LootStoreItem const* LootTemplate::LootGroup::Roll(Loot const& loot, uint16 lootMode, float roll, float equalChancedRoll) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    // Entries are only filtered out when the loot mode does not match or the item already dropped,
+    // otherwise the rolled entry can be looked up directly in the cumulative chances
+    if (IsAnyEntryInvalid(loot, lootMode))
+        return RollFiltered(loot, lootMode, roll, equalChancedRoll);
 
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    if (!ExplicitlyChanced.empty())                        // First explicitly chanced entries are checked
     {
-        float roll = (float)rand_chance();
+        auto itr = std::upper_bound(ExplicitlyChancedCumulative.begin(), ExplicitlyChancedCumulative.end(), roll);
+        if (itr != ExplicitlyChancedCumulative.end())
+            return &ExplicitlyChanced[std::distance(ExplicitlyChancedCumulative.begin(), itr)];
+    }
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
-        {
-            LootStoreItem* item = *itr;
-            if (item->chance >= 100.0f)
-                return item;
+    if (!EqualChanced.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+        return &EqualChanced[std::min(std::size_t(equalChancedRoll * EqualChanced.size()), EqualChanced.size() - 1)];
 
-            roll -= item->chance;
-            if (roll < 0)
-                return item;
-        }
+    return nullptr;                                         // Empty drop from the group
+}
+
+// Rolls an item from the group skipping entries selected by LootGroupInvalidSelector
+LootStoreItem const* LootTemplate::LootGroup::RollFiltered(Loot const& loot, uint16 lootMode, float roll, float equalChancedRoll) const
+{
+    LootGroupInvalidSelector isInvalid(loot, lootMode);
+
+    for (LootStoreItem const& item : ExplicitlyChanced)    // check each explicitly chanced entry in the template and modify its chance based on quality.
+    {
+        if (isInvalid(item))
+            continue;
+
+        if (item.chance >= 100.0f)
+            return &item;
+
+        roll -= item.chance;
+        if (roll < 0)
+            return &item;
     }
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
-    if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-        return Trinity::Containers::SelectRandomContainerElement(possibleLoot);
+    std::size_t possibleLoot = std::count_if(EqualChanced.begin(), EqualChanced.end(), [&](LootStoreItem const& item) { return !isInvalid(item); });
+    if (!possibleLoot)
+        return nullptr;                                     // Empty drop from the group
+
+    std::size_t selected = std::min(std::size_t(equalChancedRoll * possibleLoot), possibleLoot - 1);
+    for (LootStoreItem const& item : EqualChanced)
+        if (!isInvalid(item) && !selected--)
+            return &item;
 
-    return nullptr;                                            // Empty drop from the group
+    return nullptr;
 }
 
 // True if group includes at least 1 quest drop entry
 bool LootTemplate::LootGroup::HasQuestDrop() const
 {
     for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        if ((*i)->needs_quest)
+        if (i->needs_quest)
             return true;
 
     for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
-        if ((*i)->needs_quest)
+        if (i->needs_quest)
             return true;
 
     return false;
@@ -419,11 +414,11 @@ bool LootTemplate::LootGroup::HasQuestDrop() const
 bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player) const
 {
     for (LootStoreItemList::const_iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        if (player->HasQuestForItem((*i)->itemid))
+        if (player->HasQuestForItem(i->itemid))
             return true;
 
     for (LootStoreItemList::const_iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
-        if (player->HasQuestForItem((*i)->itemid))
+        if (player->HasQuestForItem(i->itemid))
             return true;
 
     return false;
@@ -432,16 +427,16 @@ bool LootTemplate::LootGroup::HasQuestDropForPlayer(Player const* player) const
 void LootTemplate::LootGroup::CopyConditions(ConditionContainer /*conditions*/)
 {
     for (LootStoreItemList::iterator i = ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        (*i)->conditions.clear();
+        i->conditions.clear();
 
     for (LootStoreItemList::iterator i = EqualChanced.begin(); i != EqualChanced.end(); ++i)
-        (*i)->conditions.clear();
+        i->conditions.clear();
 }
 
 // Rolls an item from the group (if any takes its chance) and adds the item to the loot
 void LootTemplate::LootGroup::Process(Loot& loot, uint16 lootMode) const
 {
-    if (LootStoreItem const* item = Roll(loot, lootMode))
+    if (LootStoreItem const* item = Roll(loot, lootMode, float(rand_chance()), float(rand_norm())))
         loot.AddItem(*item);
 }
 
@@ -451,8 +446,8 @@ float LootTemplate::LootGroup::RawTotalChance() const
     float result = 0;
 
     for (LootStoreItemList::const_iterator i=ExplicitlyChanced.begin(); i != ExplicitlyChanced.end(); ++i)
-        if (!(*i)->needs_quest)
-            result += (*i)->chance;
+        if (!i->needs_quest)
+            result += i->chance;
 
     return result;
 }
@@ -482,25 +477,25 @@ void LootTemplate::LootGroup::CheckLootRefs(LootTemplateMap const& /*store*/, Lo
 {
     for (LootStoreItemList::const_iterator ieItr = ExplicitlyChanced.begin(); ieItr != ExplicitlyChanced.end(); ++ieItr)
     {
-        LootStoreItem* item = *ieItr;
-        if (item->reference > 0)
+        LootStoreItem const& item = *ieItr;
+        if (item.reference > 0)
         {
-            if (!LootTemplates_Reference.GetLootFor(item->reference))
-                LootTemplates_Reference.ReportNonExistingId(item->reference, "Reference", item->itemid);
+            if (!LootTemplates_Reference.GetLootFor(item.reference))
+                LootTemplates_Reference.ReportNonExistingId(item.reference, "Reference", item.itemid);
             else if (ref_set)
-                ref_set->erase(item->reference);
+                ref_set->erase(item.reference);
         }
     }
 
     for (LootStoreItemList::const_iterator ieItr = EqualChanced.begin(); ieItr != EqualChanced.end(); ++ieItr)
     {
-        LootStoreItem* item = *ieItr;
-        if (item->reference > 0)
+        LootStoreItem const& item = *ieItr;
+        if (item.reference > 0)
         {
-            if (!LootTemplates_Reference.GetLootFor(item->reference))
-                LootTemplates_Reference.ReportNonExistingId(item->reference, "Reference", item->itemid);
+            if (!LootTemplates_Reference.GetLootFor(item.reference))
+                LootTemplates_Reference.ReportNonExistingId(item.reference, "Reference", item.itemid);
             else if (ref_set)
-                ref_set->erase(item->reference);
+                ref_set->erase(item.reference);
         }
     }
 }
@@ -511,24 +506,21 @@ void LootTemplate::LootGroup::CheckLootRefs(LootTemplateMap const& /*store*/, Lo
 
 LootTemplate::~LootTemplate()
 {
-    for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
-        delete *i;
-
     for (size_t i = 0; i < Groups.size(); ++i)
         delete Groups[i];
 }
 
 // Adds an entry to the group (at loading stage)
-void LootTemplate::AddEntry(LootStoreItem* item)
+void LootTemplate::AddEntry(LootStoreItem const& item)
 {
-    if (item->groupid > 0 && item->reference == 0)            // Group
+    if (item.groupid > 0 && item.reference == 0)              // Group
     {
-        if (item->groupid >= Groups.size())
-            Groups.resize(item->groupid, nullptr);               // Adds new group the the loot template if needed
-        if (!Groups[item->groupid - 1])
-            Groups[item->groupid - 1] = new LootGroup();
+        if (item.groupid >= Groups.size())
+            Groups.resize(item.groupid, nullptr);                // Adds new group the the loot template if needed
+        if (!Groups[item.groupid - 1])
+            Groups[item.groupid - 1] = new LootGroup();
 
-        Groups[item->groupid - 1]->AddEntry(item);            // Adds new entry to the group
+        Groups[item.groupid - 1]->AddEntry(item);             // Adds new entry to the group
     }
     else                                                      // Non-grouped entries and references are stored together
         Entries.push_back(item);
@@ -537,7 +529,7 @@ void LootTemplate::AddEntry(LootStoreItem* item)
 void LootTemplate::CopyConditions(ConditionContainer const& conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
-        (*i)->conditions.clear();
+        i->conditions.clear();
 
     for (LootGroups::iterator i = Groups.begin(); i != Groups.end(); ++i)
         if (LootGroup* group = *i)
@@ -549,11 +541,11 @@ void LootTemplate::CopyConditions(LootItem* li) const
     // Copies the conditions list from a template item to a LootItem
     for (LootStoreItemList::const_iterator _iter = Entries.begin(); _iter != Entries.end(); ++_iter)
     {
-        LootStoreItem* item = *_iter;
-        if (item->itemid != li->itemid)
+        LootStoreItem const& item = *_iter;
+        if (item.itemid != li->itemid)
             continue;
 
-        li->conditions = item->conditions;
+        li->conditions = item.conditions;
         break;
     }
 }
@@ -576,25 +568,25 @@ void LootTemplate::Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId
     // Rolling non-grouped items
     for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
-        LootStoreItem* item = *i;
-        if (!(item->lootmode & lootMode))                       // Do not add if mode mismatch
+        LootStoreItem const& item = *i;
+        if (!(item.lootmode & lootMode))                        // Do not add if mode mismatch
             continue;
 
-        if (!item->Roll(rate))
+        if (!item.Roll(rate))
             continue;                                           // Bad luck for the entry
 
-        if (item->reference > 0)                            // References processing
+        if (item.reference > 0)                             // References processing
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(item->reference);
+            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(item.reference);
             if (!Referenced)
                 continue;                                       // Error message already printed at loading stage
 
-            uint32 maxcount = uint32(float(item->maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
+            uint32 maxcount = uint32(float(item.maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
             for (uint32 loop = 0; loop < maxcount; ++loop)      // Ref multiplicator
-                Referenced->Process(loot, rate, lootMode, item->groupid);
+                Referenced->Process(loot, rate, lootMode, item.groupid);
         }
         else                                                    // Plain entries (not a reference, not grouped)
-            loot.AddItem(*item);                                // Chance is already checked, just add
+            loot.AddItem(item);                                 // Chance is already checked, just add
     }
 
     // Now processing groups
@@ -619,16 +611,16 @@ bool LootTemplate::HasQuestDrop(LootTemplateMap const& store, uint8 groupId) con
 
     for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
-        LootStoreItem* item = *i;
-        if (item->reference > 0)                        // References
+        LootStoreItem const& item = *i;
+        if (item.reference > 0)                             // References
         {
-            LootTemplateMap::const_iterator Referenced = store.find(item->reference);
+            LootTemplateMap::const_iterator Referenced = store.find(item.reference);
             if (Referenced == store.end())
                 continue;                                   // Error message [should be] already printed at loading stage
-            if (Referenced->second->HasQuestDrop(store, item->groupid))
+            if (Referenced->second->HasQuestDrop(store, item.groupid))
                 return true;
         }
-        else if (item->needs_quest)
+        else if (item.needs_quest)
             return true;                                    // quest drop found
     }
 
@@ -658,16 +650,16 @@ bool LootTemplate::HasQuestDropForPlayer(LootTemplateMap const& store, Player co
     // Checking non-grouped entries
     for (LootStoreItemList::const_iterator i = Entries.begin(); i != Entries.end(); ++i)
     {
-        LootStoreItem* item = *i;
-        if (item->reference > 0)                        // References processing
+        LootStoreItem const& item = *i;
+        if (item.reference > 0)                             // References processing
         {
-            LootTemplateMap::const_iterator Referenced = store.find(item->reference);
+            LootTemplateMap::const_iterator Referenced = store.find(item.reference);
             if (Referenced == store.end())
                 continue;                                   // Error message already printed at loading stage
-            if (Referenced->second->HasQuestDropForPlayer(store, player, item->groupid))
+            if (Referenced->second->HasQuestDropForPlayer(store, player, item.groupid))
                 return true;
         }
-        else if (player->HasQuestForItem(item->itemid))
+        else if (player->HasQuestForItem(item.itemid))
             return true;                                    // active quest drop found
     }
 
@@ -695,13 +687,13 @@ void LootTemplate::CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_se
 {
     for (LootStoreItemList::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
     {
-        LootStoreItem* item = *ieItr;
-        if (item->reference > 0)
+        LootStoreItem const& item = *ieItr;
+        if (item.reference > 0)
         {
-            if (!LootTemplates_Reference.GetLootFor(item->reference))
-                LootTemplates_Reference.ReportNonExistingId(item->reference, "Reference", item->itemid);
+            if (!LootTemplates_Reference.GetLootFor(item.reference))
+                LootTemplates_Reference.ReportNonExistingId(item.reference, "Reference", item.itemid);
             else if (ref_set)
-                ref_set->erase(item->reference);
+                ref_set->erase(item.reference);
         }
     }
 
@@ -722,9 +714,9 @@ bool LootTemplate::addConditionItem(Condition* cond)
     {
         for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
         {
-            if ((*i)->itemid == uint32(cond->SourceEntry))
+            if (i->itemid == uint32(cond->SourceEntry))
             {
-                (*i)->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList(i->conditions, cond);
                 return true;
             }
         }
@@ -743,9 +735,9 @@ bool LootTemplate::addConditionItem(Condition* cond)
             {
                 for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
                 {
-                    if ((*i)->itemid == uint32(cond->SourceEntry))
+                    if (i->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList(i->conditions, cond);
                         return true;
                     }
                 }
@@ -756,9 +748,9 @@ bool LootTemplate::addConditionItem(Condition* cond)
             {
                 for (LootStoreItemList::iterator i = itemList->begin(); i != itemList->end(); ++i)
                 {
-                    if ((*i)->itemid == uint32(cond->SourceEntry))
+                    if (i->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList(i->conditions, cond);
                         return true;
                     }
                 }
@@ -771,7 +763,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
 bool LootTemplate::isReference(uint32 id)
 {
     for (LootStoreItemList::const_iterator ieItr = Entries.begin(); ieItr != Entries.end(); ++ieItr)
-        if ((*ieItr)->itemid == id && (*ieItr)->reference > 0)
+        if (ieItr->itemid == id && ieItr->reference > 0)
             return true;
 
     return false;//not found or not reference
@@ -22,6 +22,7 @@
 #include "ConditionMgr.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include <limits>
 #include <list>
 #include <vector>
 
@@ -55,7 +56,7 @@ struct TC_GAME_API LootStoreItem
                                                             // Checks correctness of values
 };
 
-typedef std::list<LootStoreItem*> LootStoreItemList;
+typedef std::vector<LootStoreItem> LootStoreItemList;
 typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
 
 typedef std::set<uint32> LootIdSet;
@@ -98,15 +99,18 @@ class TC_GAME_API LootStore
 
 class TC_GAME_API LootTemplate
 {
-    class LootGroup;                                       // A set of loot definitions for items (refs are not allowed inside)
-    typedef std::vector<LootGroup*> LootGroups;
+    public:
+        class LootGroup;                                   // A set of loot definitions for items (refs are not allowed inside)
+
+    private:
+        typedef std::vector<LootGroup*> LootGroups;
 
     public:
         LootTemplate() { }
         ~LootTemplate();
 
         // Adds an entry to the group (at loading stage)
-        void AddEntry(LootStoreItem* item);
+        void AddEntry(LootStoreItem const& item);
         // Rolls for every item in the template and adds the rolled items the the loot
         void Process(Loot& loot, bool rate, uint16 lootMode, uint8 groupId = 0) const;
         void CopyConditions(ConditionContainer const& conditions);
@@ -132,6 +136,43 @@ class TC_GAME_API LootTemplate
         LootTemplate& operator=(LootTemplate const&) = delete;
 };
 
+class TC_GAME_API LootTemplate::LootGroup                   // A set of loot definitions for items (refs are not allowed)
+{
+    public:
+        LootGroup() : CommonLootMode(std::numeric_limits<uint16>::max()) { }
+
+        void AddEntry(LootStoreItem const& item);           // Adds an entry to the group (at loading stage)
+        bool HasQuestDrop() const;                          // True if group includes at least 1 quest drop entry
+        bool HasQuestDropForPlayer(Player const* player) const;
+                                                            // The same for active quests of the player
+        void Process(Loot& loot, uint16 lootMode) const;    // Rolls an item from the group (if any) and adds the item to the loot
+        float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
+        float TotalChance() const;                          // Overall chance for the group
+
+        void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
+        void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
+        LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
+        LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
+        void CopyConditions(ConditionContainer conditions);
+
+        // Rolls an item from the group with the given random values, returns NULL if all miss their chances
+        // roll is in range 0..100 and equalChancedRoll in range 0..1 (both exclusive), the latter selects among equal chanced entries
+        LootStoreItem const* Roll(Loot const& loot, uint16 lootMode, float roll, float equalChancedRoll) const;
+    private:
+        LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
+        LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        std::vector<float> ExplicitlyChancedCumulative;     // Running total of ExplicitlyChanced chances, for binary search rolls
+        std::vector<uint32> ItemIds;                        // Sorted ids of all entries, to check if the loot already holds any of them
+        uint16 CommonLootMode;                              // Loot mode bits shared by all entries
+
+        bool IsAnyEntryInvalid(Loot const& loot, uint16 lootMode) const;
+        LootStoreItem const* RollFiltered(Loot const& loot, uint16 lootMode, float roll, float equalChancedRoll) const;
+
+        // This class must never be copied - storing pointers
+        LootGroup(LootGroup const&) = delete;
+        LootGroup& operator=(LootGroup const&) = delete;
+};
+
 //=====================================================
 
 TC_GAME_API extern LootStore LootTemplates_Creature;
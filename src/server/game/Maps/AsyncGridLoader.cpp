@@ -0,0 +1,209 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncGridLoader.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <cstdio>
+
+void AsyncGridLoader::Start(std::size_t numThreads, std::string dataPath, bool compactHeights)
+{
+    Stop();
+
+    _dataPath = std::move(dataPath);
+    _compactHeights = compactHeights;
+    _stopping = false;
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&AsyncGridLoader::WorkerThread, this));
+}
+
+void AsyncGridLoader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+
+    _queueCondition.notify_all();
+    for (std::thread& thread : _workerThreads)
+        thread.join();
+
+    _workerThreads.clear();
+    _grids.clear();
+    _queue.clear();
+    _readyOrder.clear();
+}
+
+void AsyncGridLoader::Prefetch(uint32 mapId, int32 gx, int32 gy, float priority)
+{
+    if (!IsStarted())
+        return;
+
+    uint64 key = MakeKey(mapId, gx, gy);
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _grids.find(key);
+        if (itr == _grids.end())
+        {
+            Grid& grid = _grids[key];
+            grid.Priority = priority;
+            _queue.emplace(priority, key);
+        }
+        else if (itr->second.State == GridState::Queued && priority < itr->second.Priority)
+        {
+            // the grid got closer since it was requested
+            _queue.erase({ itr->second.Priority, key });
+            itr->second.Priority = priority;
+            _queue.emplace(priority, key);
+        }
+        else
+            return;
+    }
+
+    _queueCondition.notify_one();
+}
+
+std::unique_ptr<GridMap> AsyncGridLoader::Take(uint32 mapId, int32 gx, int32 gy, std::chrono::microseconds& stallTime)
+{
+    stallTime = std::chrono::microseconds::zero();
+    if (!IsStarted())
+        return nullptr;
+
+    uint64 key = MakeKey(mapId, gx, gy);
+    std::unique_lock<std::mutex> lock(_lock);
+    auto itr = _grids.find(key);
+    if (itr == _grids.end())
+        return nullptr;
+
+    if (itr->second.State == GridState::Queued)
+    {
+        // loading it on the calling thread is not slower than waiting for a worker to pick it up
+        _queue.erase({ itr->second.Priority, key });
+        _grids.erase(itr);
+        return nullptr;
+    }
+
+    // element references survive rehashing while other threads queue grids, iterators do not
+    Grid& grid = itr->second;
+    if (grid.State == GridState::Loading)
+    {
+        grid.Claimed = true;
+        std::chrono::steady_clock::time_point stallStart = std::chrono::steady_clock::now();
+        _loadedCondition.wait(lock, [&] { return _stopping || grid.State == GridState::Ready; });
+        stallTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stallStart);
+        if (_stopping)
+            return nullptr;
+    }
+
+    std::unique_ptr<GridMap> data = std::move(grid.Data);
+    _grids.erase(key);
+
+    // a stale key would evict the grid if it is prefetched again
+    auto readyItr = std::find(_readyOrder.begin(), _readyOrder.end(), key);
+    if (readyItr != _readyOrder.end())
+        _readyOrder.erase(readyItr);
+
+    if (data)
+        ++_stats.Taken;
+
+    return data;
+}
+
+AsyncGridLoader::Stats AsyncGridLoader::ConsumeStats()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+void AsyncGridLoader::WorkerThread()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (true)
+    {
+        _queueCondition.wait(lock, [&] { return _stopping || !_queue.empty(); });
+        if (_stopping)
+            return;
+
+        uint64 key = _queue.begin()->second;
+        _queue.erase(_queue.begin());
+
+        // entries being loaded are never erased by other threads, the reference stays valid while unlocked
+        Grid& grid = _grids[key];
+        grid.State = GridState::Loading;
+
+        lock.unlock();
+        std::unique_ptr<GridMap> data = LoadGrid(key);
+        lock.lock();
+
+        grid.Data = std::move(data);
+        grid.State = GridState::Ready;
+        ++_stats.Loaded;
+
+        _readyOrder.push_back(key);
+        while (_readyOrder.size() > MAX_READY_GRIDS)
+        {
+            auto itr = _grids.find(_readyOrder.front());
+            if (itr != _grids.end() && itr->second.State == GridState::Ready && !itr->second.Claimed)
+            {
+                _grids.erase(itr);
+                ++_stats.Discarded;
+            }
+
+            _readyOrder.pop_front();
+        }
+
+        _loadedCondition.notify_all();
+    }
+}
+
+std::unique_ptr<GridMap> AsyncGridLoader::LoadGrid(uint64 key) const
+{
+    uint32 mapId = uint32(key >> 16);
+    int32 gx = int32((key >> 8) & 0xFF);
+    int32 gy = int32(key & 0xFF);
+
+    std::unique_ptr<GridMap> grid = std::make_unique<GridMap>();
+    std::string fileName = Trinity::StringFormat("%smaps/%03u%02u%02u.map", _dataPath, mapId, gx, gy);
+    if (!grid->loadData(fileName.c_str(), _compactHeights))
+    {
+        // the map thread loads it again and reports the error
+        TC_LOG_DEBUG("maps", "AsyncGridLoader: could not load map file %s", fileName.c_str());
+        grid.reset();
+    }
+
+    WarmFile(_dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, gx, gy));
+    WarmFile(Trinity::StringFormat("%smmaps/%03i%02i%02i.mmtile", _dataPath, mapId, gx, gy));
+    return grid;
+}
+
+void AsyncGridLoader::WarmFile(std::string const& fileName) const
+{
+    FILE* file = fopen(fileName.c_str(), "rb");
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer))
+        ;
+
+    fclose(file);
+}
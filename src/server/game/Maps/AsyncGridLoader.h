@@ -0,0 +1,110 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _ASYNC_GRID_LOADER_H
+#define _ASYNC_GRID_LOADER_H
+
+#include "Define.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class GridMap;
+
+/*
+ * Loads grid terrain (.map files) on background threads before a map needs it, nearest requests first.
+ * The .vmtile and .mmtile files of the grid are read as well so the map thread finds them in the file
+ * system cache; vmap and mmap tiles are still added to their managers by the map thread, as are all
+ * creatures and gameobjects of the grid.
+ */
+class TC_GAME_API AsyncGridLoader
+{
+    public:
+        struct Stats
+        {
+            uint32 Loaded = 0;      // grids loaded by the workers
+            uint32 Taken = 0;       // prefetched grids handed to a map
+            uint32 Discarded = 0;   // prefetched grids dropped before any map asked for them
+        };
+
+        AsyncGridLoader() : _stopping(false) { }
+        ~AsyncGridLoader() { Stop(); }
+
+        AsyncGridLoader(AsyncGridLoader const&) = delete;
+        AsyncGridLoader& operator=(AsyncGridLoader const&) = delete;
+
+        void Start(std::size_t numThreads, std::string dataPath, bool compactHeights);
+        void Stop();
+        bool IsStarted() const { return !_workerThreads.empty(); }
+
+        // Queues loading of grid gx, gy (GridMaps indices) of the map, requests with a lower priority are loaded first
+        void Prefetch(uint32 mapId, int32 gx, int32 gy, float priority);
+
+        // Hands over the prefetched grid, waiting for it if a worker is loading it right now.
+        // Returns nullptr if the grid was not requested or not started yet, the caller must load it itself.
+        std::unique_ptr<GridMap> Take(uint32 mapId, int32 gx, int32 gy, std::chrono::microseconds& stallTime);
+
+        Stats ConsumeStats();
+
+        // Prefetched grids kept at most, the oldest ones are discarded first
+        static std::size_t constexpr MAX_READY_GRIDS = 64;
+
+    private:
+        enum class GridState
+        {
+            Queued,
+            Loading,
+            Ready
+        };
+
+        struct Grid
+        {
+            GridState State = GridState::Queued;
+            float Priority = 0.0f;
+            bool Claimed = false;   // a map thread is waiting for it
+            std::unique_ptr<GridMap> Data;
+        };
+
+        static uint64 MakeKey(uint32 mapId, int32 gx, int32 gy) { return (uint64(mapId) << 16) | (uint64(gx) << 8) | uint64(gy); }
+
+        void WorkerThread();
+        std::unique_ptr<GridMap> LoadGrid(uint64 key) const;
+        void WarmFile(std::string const& fileName) const;
+
+        std::string _dataPath;
+        bool _compactHeights = false;
+
+        std::unordered_map<uint64, Grid> _grids;
+        std::set<std::pair<float, uint64>> _queue;
+        std::deque<uint64> _readyOrder;
+        Stats _stats;
+
+        std::vector<std::thread> _workerThreads;
+        std::mutex _lock;
+        std::condition_variable _queueCondition;
+        std::condition_variable _loadedCondition;
+        bool _stopping;
+};
+
+#endif // _ASYNC_GRID_LOADER_H
@@ -16,6 +16,7 @@
  */
 
 #include "Map.h"
+#include "AsyncGridLoader.h"
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "DatabaseEnv.h"
@@ -40,6 +41,7 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "PoolMgr.h"
+#include "ScratchVector.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
 #include "Vehicle.h"
@@ -51,9 +53,6 @@
 #include <unordered_set>
 #include <vector>
 
-#include "Hacks/boost_1_74_fibonacci_heap.h"
-BOOST_1_74_FIBONACCI_HEAP_MSVC_COMPILE_FIX(RespawnListContainer::value_type)
-
 u_map_magic MapMagic        = { {'M','A','P','S'} };
 u_map_magic MapVersionMagic = { {'v','1','.','9'} };
 u_map_magic MapAreaMagic    = { {'A','R','E','A'} };
@@ -93,8 +92,6 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sMapMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapManager()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 bool Map::ExistMap(uint32 mapid, int gx, int gy)
@@ -218,6 +215,23 @@ void Map::LoadMap(int gx, int gy, bool reload)
         GridMaps[gx][gy]=nullptr;
     }
 
+    // terrain may already have been loaded in the background
+    if (!reload)
+    {
+        std::chrono::microseconds stallTime;
+        if (std::unique_ptr<GridMap> prefetched = sMapMgr->GetAsyncGridLoader().Take(GetId(), gx, gy, stallTime))
+        {
+            TC_LOG_DEBUG("maps", "Using prefetched map %03u%02u%02u.map", GetId(), gx, gy);
+            TC_METRIC_VALUE("map_grid_load_stall", std::chrono::nanoseconds(stallTime),
+                TC_METRIC_TAG("map_id", std::to_string(GetId())),
+                TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+            GridMaps[gx][gy] = prefetched.release();
+            sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
+            return;
+        }
+    }
+
     // map file name
     char* tmp = nullptr;
     int len = sWorld->GetDataPath().length() + strlen("maps/%03u%02u%02u.map") + 1;
@@ -226,7 +240,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
     TC_LOG_DEBUG("maps", "Loading map %s", tmp);
     // loading data
     GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
+    if (!GridMaps[gx][gy]->loadData(tmp, sWorld->getBoolConfig(CONFIG_MAP_COMPACT_HEIGHTS)))
         TC_LOG_ERROR("maps", "Error loading map file: \n %s\n", tmp);
     delete[] tmp;
 
@@ -235,6 +249,7 @@ void Map::LoadMap(int gx, int gy, bool reload)
 
 void Map::LoadMapAndVMap(int gx, int gy)
 {
+    _queryCache.NewEpoch();
     LoadMap(gx, gy);
    // Only load the data for the base map
     if (i_InstanceId == 0)
@@ -274,9 +289,12 @@ m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry),
-i_scriptLock(false), _respawnCheckTimer(0)
+i_scriptLock(false), _respawnCheckTimer(0), _respawnFlushTimer(0)
 {
     m_parentMap = (_parent ? _parent : this);
+
+    // start the respawn queue at the current time, loaded respawns would otherwise have to cascade through decades of empty rotations
+    _respawnTimes.Advance(uint64(GameTime::GetGameTime()));
     for (unsigned int idx=0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
         for (unsigned int j=0; j < MAX_NUMBER_OF_GRIDS; ++j)
@@ -507,7 +525,12 @@ void Map::EnsureGridCreated_i(GridCoord const& p)
         int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
 
         if (!GridMaps[gx][gy])
+        {
+            TC_METRIC_TIMER("map_grid_load_time",
+                TC_METRIC_TAG("map_id", std::to_string(GetId())),
+                TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
             LoadMapAndVMap(gx, gy);
+        }
     }
 }
 
@@ -540,6 +563,9 @@ bool Map::EnsureGridLoaded(Cell const& cell)
 
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
+        TC_METRIC_TIMER("map_grid_object_load_time",
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
         ObjectGridLoader loader(*grid, this, cell);
         loader.LoadN();
 
@@ -758,6 +784,8 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(uint32 t_diff)
 {
+    _queryCache.SetEnabled(sWorld->getBoolConfig(CONFIG_MAP_QUERY_CACHE));
+    _queryCache.NewEpoch();
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -781,6 +809,15 @@ void Map::Update(uint32 t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    /// write buffered respawn times
+    if (_respawnFlushTimer <= t_diff)
+    {
+        FlushRespawnWrites();
+        _respawnFlushTimer = sWorld->getIntConfig(CONFIG_RESPAWN_WRITEBEHINDINTERVAL);
+    }
+    else
+        _respawnFlushTimer -= t_diff;
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
@@ -905,6 +942,18 @@ void Map::Update(uint32 t_diff)
     TC_METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (_queryCache.IsEnabled())
+    {
+        MapQueryCache::Stats queryCacheStats = _queryCache.ConsumeStats();
+        TC_METRIC_VALUE("map_query_cache_hits", queryCacheStats.Hits,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        TC_METRIC_VALUE("map_query_cache_misses", queryCacheStats.Misses,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
 }
 
 struct ResetNotifier
@@ -1082,6 +1131,9 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     Cell old_cell(player->GetPositionX(), player->GetPositionY());
     Cell new_cell(x, y);
 
+    if (old_cell.DiffGrid(new_cell) || old_cell.DiffCell(new_cell))
+        PrefetchGridsAhead(player->GetPositionX(), player->GetPositionY(), x, y);
+
     player->Relocate(x, y, z, orientation);
     if (player->IsVehicle())
         player->GetVehicleKit()->RelocatePassengers();
@@ -1102,6 +1154,35 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float orie
     player->UpdateObjectVisibility(false);
 }
 
+void Map::PrefetchGridsAhead(float oldX, float oldY, float x, float y)
+{
+    AsyncGridLoader& loader = sMapMgr->GetAsyncGridLoader();
+    if (!loader.IsStarted() || Instanceable())
+        return;
+
+    float dx = x - oldX;
+    float dy = y - oldY;
+    float moved = std::sqrt(dx * dx + dy * dy);
+    if (moved < 0.1f)
+        return;
+
+    // queue the grids on the line the player is moving along, nearest first
+    std::lock_guard<std::mutex> lock(_gridLock);
+    float lookAhead = sWorld->getFloatConfig(CONFIG_MAP_ASYNC_GRID_LOAD_LOOKAHEAD);
+    for (float distance = SIZE_OF_GRIDS / 2; distance <= lookAhead; distance += SIZE_OF_GRIDS / 2)
+    {
+        float aheadX = x + dx / moved * distance;
+        float aheadY = y + dy / moved * distance;
+        if (!Trinity::IsValidMapCoord(aheadX, aheadY))
+            break;
+
+        int gx = (int)(CENTER_GRID_ID - aheadX / SIZE_OF_GRIDS);
+        int gy = (int)(CENTER_GRID_ID - aheadY / SIZE_OF_GRIDS);
+        if (!GridMaps[gx][gy])
+            loader.Prefetch(GetId(), gx, gy, distance);
+    }
+}
+
 void Map::CreatureRelocation(Creature* creature, float x, float y, float z, float ang, bool respawnRelocationOnFail)
 {
     ASSERT(CheckGridIntegrity(creature, false));
@@ -1717,6 +1798,7 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
             ((MapInstanced*)m_parentMap)->RemoveGridMapReference(GridCoord(gx, gy));
 
         GridMaps[gx][gy] = nullptr;
+        _queryCache.NewEpoch();
     }
     TC_LOG_DEBUG("maps", "Unloading grid[%u, %u] for map %u finished", x, y, GetId());
     return true;
@@ -1773,6 +1855,8 @@ void Map::UnloadAll()
     _corpsesByCell.clear();
     _corpsesByPlayer.clear();
     _corpseBones.clear();
+
+    FlushRespawnWrites(true);
 }
 
 // *****************************
@@ -1810,7 +1894,7 @@ GridMap::~GridMap()
     unloadData();
 }
 
-bool GridMap::loadData(char const* filename)
+bool GridMap::loadData(char const* filename, bool compactHeights /*= false*/)
 {
     // Unload old data if exist
     unloadData();
@@ -1837,7 +1921,7 @@ bool GridMap::loadData(char const* filename)
             return false;
         }
         // load up height data
-        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
+        if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize, compactHeights))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
             fclose(in);
@@ -1886,6 +1970,7 @@ void GridMap::unloadData()
     _liquidMap  = nullptr;
     _holes = nullptr;
     _gridGetHeight = &GridMap::getHeightFromFlat;
+    _flags &= ~GRID_MAP_COMPACT_HEIGHTS;
 }
 
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
@@ -1906,7 +1991,7 @@ bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/, bool compactHeights)
 {
     map_heightHeader header;
     fseek(in, offset, SEEK_SET);
@@ -1945,6 +2030,8 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
                 fread(m_V8, sizeof(float), 128*128, in) != 128*128)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
+            if (compactHeights)
+                compactHeightData();
         }
     }
     else
@@ -1995,6 +2082,35 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+bool GridMap::compactHeightData()
+{
+    float minHeight = std::min(*std::min_element(m_V9, m_V9 + 129 * 129), *std::min_element(m_V8, m_V8 + 128 * 128));
+    float maxHeight = std::max(*std::max_element(m_V9, m_V9 + 129 * 129), *std::max_element(m_V8, m_V8 + 128 * 128));
+    float step = (maxHeight - minHeight) / 65535;
+    if (!(step <= COMPACT_HEIGHT_MAX_STEP))
+        return false;
+
+    // same encoding as MAP_HEIGHT_AS_INT16 files, getHeightFromUint16 reads both
+    auto quantize = [&](float height) -> uint16
+    {
+        return step > 0.0f ? uint16(std::lround((height - minHeight) / step)) : 0;
+    };
+
+    uint16* V9 = new uint16[129 * 129];
+    uint16* V8 = new uint16[128 * 128];
+    std::transform(m_V9, m_V9 + 129 * 129, V9, quantize);
+    std::transform(m_V8, m_V8 + 128 * 128, V8, quantize);
+    delete[] m_V9;
+    delete[] m_V8;
+    m_uint16_V9 = V9;
+    m_uint16_V8 = V8;
+    _gridHeight = minHeight;
+    _gridIntHeightMultiplier = step;
+    _gridGetHeight = &GridMap::getHeightFromUint16;
+    _flags |= GRID_MAP_COMPACT_HEIGHTS;
+    return true;
+}
+
 bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
@@ -2284,6 +2400,26 @@ float GridMap::getHeightFromUint16(float x, float y) const
     return (float)((a * x) + (b * y) + c)*_gridIntHeightMultiplier + _gridHeight;
 }
 
+template<float(GridMap::*GetHeight)(float, float) const>
+void GridMap::getHeightsWith(float const* x, float const* y, float* heights, uint32 count) const
+{
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = (this->*GetHeight)(x[i], y[i]);
+}
+
+void GridMap::getHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    // GetHeight is a template argument here so every loop calls one known function that the compiler can inline
+    if (_gridGetHeight == &GridMap::getHeightFromUint16)
+        getHeightsWith<&GridMap::getHeightFromUint16>(x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8)
+        getHeightsWith<&GridMap::getHeightFromUint8>(x, y, heights, count);
+    else if (_gridGetHeight == &GridMap::getHeightFromFloat)
+        getHeightsWith<&GridMap::getHeightFromFloat>(x, y, heights, count);
+    else
+        std::fill_n(heights, count, _gridHeight);
+}
+
 bool GridMap::isHole(int row, int col) const
 {
     if (!_holes)
@@ -2479,10 +2615,21 @@ float Map::GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, fl
 }
 
 float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    return SelectHeight(x, y, z, GetGridHeight(x, y), checkVMap, maxSearchDist);
+}
+
+void Map::GetHeights(uint32 phasemask, float const* x, float const* y, float const* z, float* heights, uint32 count, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    GetGridHeights(x, y, heights, count);
+    for (uint32 i = 0; i < count; ++i)
+        heights[i] = std::max<float>(SelectHeight(x[i], y[i], z[i], heights[i], checkVMap, maxSearchDist), GetGameObjectFloor(phasemask, x[i], y[i], z[i], maxSearchDist));
+}
+
+float Map::SelectHeight(float x, float y, float z, float gridHeight, bool checkVMap, float maxSearchDist) const
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    float gridHeight = GetGridHeight(x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
@@ -2491,7 +2638,21 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
         if (vmgr->isHeightCalcEnabled())
-            vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+        {
+            if (_queryCache.IsEnabled())
+            {
+                MapQueryCache::PositionKey key = MapQueryCache::MakeHeightKey(x, y, z, maxSearchDist);
+                if (float const* cachedHeight = _queryCache.FindVMapHeight(key))
+                    vmapHeight = *cachedHeight;
+                else
+                {
+                    vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+                    _queryCache.StoreVMapHeight(key, vmapHeight);
+                }
+            }
+            else
+                vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);
+        }
     }
 
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
@@ -2524,6 +2685,27 @@ float Map::GetGridHeight(float x, float y) const
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
+void Map::GetGridHeights(float const* x, float const* y, float* heights, uint32 count) const
+{
+    // path and spline points are close together, hand every run of points within one grid to its GridMap at once
+    uint32 first = 0;
+    while (first < count)
+    {
+        int gx = (int)(CENTER_GRID_ID - x[first] / SIZE_OF_GRIDS);
+        int gy = (int)(CENTER_GRID_ID - y[first] / SIZE_OF_GRIDS);
+        uint32 last = first + 1;
+        while (last < count && (int)(CENTER_GRID_ID - x[last] / SIZE_OF_GRIDS) == gx && (int)(CENTER_GRID_ID - y[last] / SIZE_OF_GRIDS) == gy)
+            ++last;
+
+        if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x[first], y[first]))
+            gmap->getHeights(x + first, y + first, heights + first, last - first);
+        else
+            std::fill(heights + first, heights + last, VMAP_INVALID_HEIGHT_VALUE);
+
+        first = last;
+    }
+}
+
 float Map::GetMinHeight(float x, float y) const
 {
     if (GridMap const* grid = const_cast<Map*>(this)->GetGrid(x, y))
@@ -2736,7 +2918,25 @@ void Map::GetFullTerrainStatusForPosition(uint32 phaseMask, float x, float y, fl
     VMAP::AreaAndLiquidData dynData;
     VMAP::AreaAndLiquidData* wmoData = nullptr;
     GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y);
-    vmgr->getAreaAndLiquidData(GetId(), x, y, z, reqLiquidType, vmapData);
+    if (_queryCache.IsEnabled())
+    {
+        MapQueryCache::PositionKey key = MapQueryCache::MakeAreaAndLiquidKey(x, y, z, reqLiquidType);
+        if (VMAP::AreaAndLiquidData const* cachedData = _queryCache.FindVMapAreaAndLiquidData(key))
+        {
+            vmapData.floorZ = cachedData->floorZ;
+            if (cachedData->areaInfo)
+                vmapData.areaInfo.emplace(*cachedData->areaInfo);
+            if (cachedData->liquidInfo)
+                vmapData.liquidInfo.emplace(*cachedData->liquidInfo);
+        }
+        else
+        {
+            vmgr->getAreaAndLiquidData(GetId(), x, y, z, reqLiquidType, vmapData);
+            _queryCache.StoreVMapAreaAndLiquidData(key, vmapData);
+        }
+    }
+    else
+        vmgr->getAreaAndLiquidData(GetId(), x, y, z, reqLiquidType, vmapData);
     _dynamicTree.getAreaAndLiquidData(x, y, z, phaseMask, reqLiquidType, dynData);
 
     uint32 gridAreaId = 0;
@@ -2877,6 +3077,20 @@ float Map::GetWaterLevel(float x, float y) const
 }
 
 bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!_queryCache.IsEnabled())
+        return CheckLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+
+    MapQueryCache::LineOfSightKey key = MapQueryCache::MakeLineOfSightKey(x1, y1, z1, x2, y2, z2, phasemask, checks, uint32(ignoreFlags));
+    if (bool const* cachedResult = _queryCache.FindLineOfSight(key))
+        return *cachedResult;
+
+    bool result = CheckLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+    _queryCache.StoreLineOfSight(key, result);
+    return result;
+}
+
+bool Map::CheckLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if ((checks & LINEOFSIGHT_CHECK_VMAP)
       && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
@@ -2887,6 +3101,59 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
     return true;
 }
 
+void Map::isInLineOfSight(VMAP::LineOfSightRay* rays, uint32 const* phaseMasks, uint32 count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!_queryCache.IsEnabled())
+    {
+        CheckLineOfSight(rays, phaseMasks, count, checks, ignoreFlags);
+        return;
+    }
+
+    // only rays without a cached result are traced, as one batch
+    Trinity::ScratchVector<MapQueryCache::LineOfSightKey> missKeys;
+    Trinity::ScratchVector<VMAP::LineOfSightRay> missRays;
+    Trinity::ScratchVector<uint32> missPhaseMasks;
+    Trinity::ScratchVector<uint32> missIndexes;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        VMAP::LineOfSightRay& ray = rays[i];
+        MapQueryCache::LineOfSightKey key = MapQueryCache::MakeLineOfSightKey(ray.x1, ray.y1, ray.z1, ray.x2, ray.y2, ray.z2, phaseMasks[i], checks, uint32(ignoreFlags));
+        if (bool const* cachedResult = _queryCache.FindLineOfSight(key))
+            ray.inLineOfSight = *cachedResult;
+        else
+        {
+            missKeys->push_back(key);
+            missRays->push_back(ray);
+            missPhaseMasks->push_back(phaseMasks[i]);
+            missIndexes->push_back(i);
+        }
+    }
+
+    if (missRays->empty())
+        return;
+
+    CheckLineOfSight(missRays->data(), missPhaseMasks->data(), missRays->size(), checks, ignoreFlags);
+    for (std::size_t i = 0; i < missRays->size(); ++i)
+    {
+        rays[(*missIndexes)[i]].inLineOfSight = (*missRays)[i].inLineOfSight;
+        _queryCache.StoreLineOfSight((*missKeys)[i], (*missRays)[i].inLineOfSight);
+    }
+}
+
+void Map::CheckLineOfSight(VMAP::LineOfSightRay* rays, uint32 const* phaseMasks, uint32 count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(GetId(), rays, count, ignoreFlags);
+    else
+        for (uint32 i = 0; i < count; ++i)
+            rays[i].inLineOfSight = true;
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+        for (uint32 i = 0; i < count; ++i)
+            if (rays[i].inLineOfSight)
+                rays[i].inLineOfSight = _dynamicTree.isInLineOfSight(rays[i].x1, rays[i].y1, rays[i].z1, rays[i].x2, rays[i].y2, rays[i].z2, phaseMasks[i]);
+}
+
 bool Map::getObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
@@ -2997,16 +3264,40 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
+void Map::AddUpdateObject(Object* obj)
+{
+    obj->m_updateObjectIndex = uint32(_updateObjects.size());
+    _updateObjects.push_back(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
+{
+    // objects that are not (or no longer) in this map's list are ignored
+    uint32 index = obj->m_updateObjectIndex;
+    if (index >= _updateObjects.size() || _updateObjects[index] != obj)
+        return;
+
+    Object* last = _updateObjects.back();
+    _updateObjects[index] = last;
+    last->m_updateObjectIndex = index;
+    _updateObjects.pop_back();
+}
+
 void Map::SendObjectUpdates()
 {
     UpdateDataMapType update_players;
 
+    TC_METRIC_VALUE("map_dirty_objects", uint64(_updateObjects.size()),
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    // BuildUpdate may mark further objects as changed, those are appended and processed in the same pass
     while (!_updateObjects.empty())
     {
-        Object* obj = *_updateObjects.begin();
+        Object* obj = _updateObjects.back();
         ASSERT(obj->IsInWorld());
 
-        _updateObjects.erase(_updateObjects.begin());
+        _updateObjects.pop_back();
         obj->BuildUpdate(update_players);
     }
 
@@ -3097,7 +3388,8 @@ void Map::Respawn(RespawnInfo* info, CharacterDatabaseTransaction dbTrans)
     if (info->respawnTime <= GameTime::GetGameTime())
         return;
     info->respawnTime = GameTime::GetGameTime();
-    _respawnTimes.increase(info->handle);
+    _respawnTimes.Unschedule(info);
+    _respawnTimes.Schedule(info, uint64(info->respawnTime));
     SaveRespawnInfoDB(*info, dbTrans);
 }
 
@@ -3151,12 +3443,31 @@ bool Map::AddRespawnInfo(RespawnInfo const& info)
     else
         ABORT_MSG("Invalid respawn info for spawn id (%u,%u) being inserted", uint32(info.type), info.spawnId);
 
-    RespawnInfo * ri = new RespawnInfo(info);
-    ri->handle = _respawnTimes.push(ri);
+    RespawnInfo* ri = AllocateRespawnInfo(info);
+    _respawnTimes.Schedule(ri, uint64(ri->respawnTime));
     bySpawnIdMap.emplace(ri->spawnId, ri);
     return true;
 }
 
+RespawnInfo* Map::AllocateRespawnInfo(RespawnInfo const& info)
+{
+    if (_freeRespawnInfos.empty())
+    {
+        _respawnInfoStorage.emplace_back(info);
+        return &_respawnInfoStorage.back();
+    }
+
+    RespawnInfo* ri = _freeRespawnInfos.back();
+    _freeRespawnInfos.pop_back();
+    *ri = info;
+    return ri;
+}
+
+void Map::FreeRespawnInfo(RespawnInfo* info)
+{
+    _freeRespawnInfos.push_back(info);
+}
+
 static void PushRespawnInfoFrom(std::vector<RespawnInfo const*>& data, RespawnInfoMap const& map)
 {
     data.reserve(data.size() + map.size());
@@ -3183,11 +3494,19 @@ RespawnInfo* Map::GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawn
 
 void Map::UnloadAllRespawnInfos() // delete everything from memory
 {
-    for (RespawnInfo* info : _respawnTimes)
-        delete info;
-    _respawnTimes.clear();
-    _creatureRespawnTimesBySpawnId.clear();
-    _gameObjectRespawnTimesBySpawnId.clear();
+    // every scheduled respawn is in one of the spawn id stores
+    for (RespawnInfoMap* spawnMap : { &_creatureRespawnTimesBySpawnId, &_gameObjectRespawnTimesBySpawnId })
+    {
+        for (auto const& pair : *spawnMap)
+        {
+            _respawnTimes.Unschedule(pair.second);
+            FreeRespawnInfo(pair.second);
+        }
+        spawnMap->clear();
+    }
+
+    ASSERT(_respawnTimes.Empty());
+    // the storage is kept, scripts can get here from DoRespawn while ProcessRespawns still holds the entry it frees afterwards
 }
 
 void Map::DeleteRespawnInfo(RespawnInfo* info, CharacterDatabaseTransaction dbTrans)
@@ -3202,18 +3521,26 @@ void Map::DeleteRespawnInfo(RespawnInfo* info, CharacterDatabaseTransaction dbTr
     ASSERT(it != range.second, "Respawn stores inconsistent for map %u, spawnid %u (type %u)", GetId(), info->spawnId, uint32(info->type));
     spawnMap.erase(it);
 
-    // respawn heap
-    _respawnTimes.erase(info->handle);
+    // respawn queue
+    _respawnTimes.Unschedule(info);
 
     // database
     DeleteRespawnInfoFromDB(info->type, info->spawnId, dbTrans);
 
     // then cleanup the object
-    delete info;
+    FreeRespawnInfo(info);
 }
 
 void Map::DeleteRespawnInfoFromDB(SpawnObjectType type, ObjectGuid::LowType spawnId, CharacterDatabaseTransaction dbTrans)
 {
+    if (!dbTrans && sWorld->getIntConfig(CONFIG_RESPAWN_WRITEBEHINDINTERVAL))
+    {
+        _respawnWriteBuffer.Delete(type, spawnId);
+        return;
+    }
+
+    _respawnWriteBuffer.WrittenDirectly(type, spawnId, false);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_RESPAWN);
     stmt->setUInt16(0, type);
     stmt->setUInt32(1, spawnId);
@@ -3251,46 +3578,42 @@ void Map::DoRespawn(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 gr
 void Map::ProcessRespawns()
 {
     time_t now = GameTime::GetGameTime();
-    while (!_respawnTimes.empty())
+    _respawnTimes.Advance(uint64(now));
+    while (Trinity::TimerWheelNode* node = _respawnTimes.PopDue())
     {
-        RespawnInfo* next = _respawnTimes.top();
-        if (now < next->respawnTime) // done for this tick
-            break;
+        RespawnInfo* next = static_cast<RespawnInfo*>(node);
 
         if (uint32 poolId = sPoolMgr->IsPartOfAPool(next->type, next->spawnId)) // is this part of a pool?
         { // if yes, respawn will be handled by (external) pooling logic, just delete the respawn time
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes.pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
 
             // step 2: tell pooling logic to do its thing
             sPoolMgr->UpdatePool(poolId, next->type, next->spawnId);
 
             // step 3: get rid of the actual entry
-            delete next;
+            FreeRespawnInfo(next);
         }
         else if (CheckRespawn(next)) // see if we're allowed to respawn
         { // ok, respawn
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes.pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
 
             // step 2: do the respawn, which involves external logic
             DoRespawn(next->type, next->spawnId, next->gridId);
 
             // step 3: get rid of the actual entry
-            delete next;
+            FreeRespawnInfo(next);
         }
         else if (!next->respawnTime)
         { // just remove this respawn entry without rescheduling
-            _respawnTimes.pop();
             GetRespawnMapForType(next->type).erase(next->spawnId);
-            delete next;
+            FreeRespawnInfo(next);
         }
         else
-        { // new respawn time, update heap position
+        { // new respawn time, put it back into the queue
             ASSERT(now < next->respawnTime); // infinite loop guard
-            _respawnTimes.decrease(next->handle);
+            _respawnTimes.Schedule(next, uint64(next->respawnTime));
             SaveRespawnInfoDB(*next);
         }
     }
@@ -4427,6 +4750,14 @@ void Map::SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uin
 
 void Map::SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans)
 {
+    if (!dbTrans && sWorld->getIntConfig(CONFIG_RESPAWN_WRITEBEHINDINTERVAL))
+    {
+        _respawnWriteBuffer.Save(info.type, info.spawnId, info.respawnTime);
+        return;
+    }
+
+    _respawnWriteBuffer.WrittenDirectly(info.type, info.spawnId, true);
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_RESPAWN);
     stmt->setUInt16(0, info.type);
     stmt->setUInt32(1, info.spawnId);
@@ -4450,6 +4781,8 @@ void Map::LoadRespawnTimes()
             ObjectGuid::LowType spawnId = fields[1].GetUInt32();
             uint64 respawnTime = fields[2].GetUInt64();
 
+            _respawnWriteBuffer.SetPersisted(type, spawnId);
+
             if (SpawnData::TypeHasData(type))
             {
                 if (SpawnData const* data = sObjectMgr->GetSpawnData(type, spawnId))
@@ -4474,6 +4807,53 @@ void Map::LoadRespawnTimes()
     CharacterDatabase.Execute(stmt);
 }
 
+void Map::FlushRespawnWrites(bool synchronous /*= false*/)
+{
+    if (_respawnWriteBuffer.HasPending())
+    {
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        for (RespawnWriteBuffer::Write const& write : _respawnWriteBuffer.TakePending())
+        {
+            CharacterDatabasePreparedStatement* stmt;
+            if (write.RespawnTime)
+            {
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_RESPAWN);
+                stmt->setUInt16(0, write.Type);
+                stmt->setUInt32(1, write.SpawnId);
+                stmt->setUInt64(2, uint64(write.RespawnTime));
+                stmt->setUInt16(3, GetId());
+                stmt->setUInt32(4, GetInstanceId());
+            }
+            else
+            {
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_RESPAWN);
+                stmt->setUInt16(0, write.Type);
+                stmt->setUInt32(1, write.SpawnId);
+                stmt->setUInt16(2, GetId());
+                stmt->setUInt32(3, GetInstanceId());
+            }
+            trans->Append(stmt);
+        }
+
+        if (synchronous)
+            CharacterDatabase.DirectCommitTransaction(trans);
+        else
+            CharacterDatabase.CommitTransaction(trans);
+    }
+
+    RespawnWriteBuffer::Stats stats = _respawnWriteBuffer.ConsumeStats();
+    if (!stats.Requested)
+        return;
+
+    TC_METRIC_VALUE("map_respawn_writes", stats.Written,
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    TC_METRIC_VALUE("map_respawn_writes_coalesced", stats.Requested - stats.Written,
+        TC_METRIC_TAG("map_id", std::to_string(GetId())),
+        TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+}
+
 time_t Map::GetLinkedRespawnTime(ObjectGuid guid) const
 {
     ObjectGuid linkedGuid = sObjectMgr->GetLinkedRespawnGuid(guid);
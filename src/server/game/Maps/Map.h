@@ -24,16 +24,19 @@
 #include "DynamicTree.h"
 #include "GridDefines.h"
 #include "GridRefManager.h"
+#include "MapQueryCache.h"
 #include "MapRefManager.h"
 #include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include "RespawnWriteBuffer.h"
 #include "SharedDefines.h"
 #include "SpawnData.h"
 #include "Timer.h"
+#include "TimerWheel.h"
 #include "Transaction.h"
-#include <boost/heap/fibonacci_heap.hpp>
 #include <bitset>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -65,7 +68,7 @@ enum Difficulty : uint8;
 enum WeatherState : uint32;
 
 namespace Trinity { struct ObjectUpdater; }
-namespace VMAP { enum class ModelIgnoreFlags : uint32; }
+namespace VMAP { enum class ModelIgnoreFlags : uint32; struct LineOfSightRay; }
 namespace G3D { class Plane; }
 
 struct ScriptAction
@@ -191,6 +194,11 @@ struct PositionFullTerrainStatus
 
 class TC_GAME_API GridMap
 {
+    enum GridMapFlags : uint32
+    {
+        GRID_MAP_COMPACT_HEIGHTS = 0x1  // float height data was quantized to 16 bits on load
+    };
+
     uint32  _flags;
     union{
         float* m_V9;
@@ -226,7 +234,7 @@ class TC_GAME_API GridMap
     uint16* _holes;
 
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
+    bool loadHeightData(FILE* in, uint32 offset, uint32 size, bool compactHeights);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
     bool loadHolesData(FILE* in, uint32 offset, uint32 size);
     bool isHole(int row, int col) const;
@@ -238,15 +246,24 @@ class TC_GAME_API GridMap
     float getHeightFromUint16(float x, float y) const;
     float getHeightFromUint8(float x, float y) const;
     float getHeightFromFlat(float x, float y) const;
+    template<float(GridMap::*GetHeight)(float, float) const>
+    void getHeightsWith(float const* x, float const* y, float* heights, uint32 count) const;
+
+    // Float height data is stored as 16 bit heights when the quantization step is at most this many yards
+    static float constexpr COMPACT_HEIGHT_MAX_STEP = 0.01f;
+    bool compactHeightData();
 
 public:
     GridMap();
     ~GridMap();
-    bool loadData(char const* filename);
+    bool loadData(char const* filename, bool compactHeights = false);
     void unloadData();
 
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
+    // Same as getHeight for every point, the height storage format is resolved once for the whole batch
+    void getHeights(float const* x, float const* y, float* heights, uint32 count) const;
+    bool hasCompactHeights() const { return (_flags & GRID_MAP_COMPACT_HEIGHTS) != 0; }
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     ZLiquidStatus GetLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, LiquidData* data = 0, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
@@ -287,35 +304,33 @@ struct ZoneDynamicInfo
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 #define MAP_INVALID_ZONE      0xFFFFFFFF
 
-struct RespawnInfo; // forward declaration
-struct CompareRespawnInfo
-{
-    bool operator()(RespawnInfo const* a, RespawnInfo const* b) const;
-};
 using ZoneDynamicInfoMap = std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo>;
-using RespawnListContainer = boost::heap::fibonacci_heap<RespawnInfo*, boost::heap::compare<CompareRespawnInfo>>;
-using RespawnListHandle = RespawnListContainer::handle_type;
-using RespawnInfoMap = std::unordered_map<ObjectGuid::LowType, RespawnInfo*>;
-struct RespawnInfo
+
+// scheduled in the map's respawn queue through the TimerWheelNode base, copies only carry the respawn data
+struct RespawnInfo : public Trinity::TimerWheelNode
 {
+    RespawnInfo() = default;
+    RespawnInfo(RespawnInfo const& other) : TimerWheelNode(), type(other.type), spawnId(other.spawnId), entry(other.entry), respawnTime(other.respawnTime), gridId(other.gridId) { }
+    RespawnInfo& operator=(RespawnInfo const& other)
+    {
+        type = other.type;
+        spawnId = other.spawnId;
+        entry = other.entry;
+        respawnTime = other.respawnTime;
+        gridId = other.gridId;
+        return *this;
+    }
+
     SpawnObjectType type;
     ObjectGuid::LowType spawnId;
     uint32 entry;
     time_t respawnTime;
     uint32 gridId;
-    RespawnListHandle handle;
 };
-inline bool CompareRespawnInfo::operator()(RespawnInfo const* a, RespawnInfo const* b) const
-{
-    if (a == b)
-        return false;
-    if (a->respawnTime != b->respawnTime)
-        return (a->respawnTime > b->respawnTime);
-    if (a->spawnId != b->spawnId)
-        return a->spawnId < b->spawnId;
-    ASSERT(a->type != b->type, "Duplicate respawn entry for spawnId (%u,%u) found!", a->type, a->spawnId);
-    return a->type < b->type;
-}
+
+// one second buckets, 64^4 seconds (~194 days) before respawns go to the overflow list
+using RespawnListContainer = Trinity::TimerWheel<6, 4>;
+using RespawnInfoMap = std::unordered_map<ObjectGuid::LowType, RespawnInfo*>;
 
 class TC_GAME_API Map : public GridRefManager<NGridType>
 {
@@ -564,13 +579,18 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetMinHeight(float x, float y) const;
         float GetHeight(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetGridHeight(float x, float y) const;
+        // Batch versions of GetGridHeight and GetHeight(phasemask, ...), for paths and splines
+        void GetGridHeights(float const* x, float const* y, float* heights, uint32 count) const;
+        void GetHeights(uint32 phasemask, float const* x, float const* y, float const* z, float* heights, uint32 count, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetHeight(Position const& pos, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const { return GetHeight(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), vmap, maxSearchDist); }
         float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const { return std::max<float>(GetHeight(x, y, z, vmap, maxSearchDist), GetGameObjectFloor(phasemask, x, y, z, maxSearchDist)); }
         float GetHeight(uint32 phasemask, Position const& pos, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const { return GetHeight(phasemask, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), vmap, maxSearchDist); }
         bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        void isInLineOfSight(VMAP::LineOfSightRay* rays, uint32 const* phaseMasks, uint32 count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
         void Balance() { _dynamicTree.balance(); }
-        void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
-        void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
+        void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); _queryCache.InvalidateGameObjectModels(); }
+        void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); _queryCache.InvalidateGameObjectModels(); }
+        void GameObjectModelChanged() { _queryCache.InvalidateGameObjectModels(); }
         bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
         float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
         {
@@ -596,8 +616,11 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void SaveRespawnTime(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 entry, time_t respawnTime, uint32 gridId, CharacterDatabaseTransaction dbTrans = nullptr, bool startup = false);
         void SaveRespawnInfoDB(RespawnInfo const& info, CharacterDatabaseTransaction dbTrans = nullptr);
         void LoadRespawnTimes();
-        void DeleteRespawnTimes() { UnloadAllRespawnInfos(); DeleteRespawnTimesInDB(GetId(), GetInstanceId()); }
+        void DeleteRespawnTimes() { UnloadAllRespawnInfos(); _respawnWriteBuffer.Clear(); DeleteRespawnTimesInDB(GetId(), GetInstanceId()); }
         static void DeleteRespawnTimesInDB(uint16 mapId, uint32 instanceId);
+        // writes all buffered respawn time changes in a single transaction
+        // synchronous flushes block until it is committed, used when unloading as queued operations are dropped at shutdown
+        void FlushRespawnWrites(bool synchronous = false);
 
         void LoadCorpseData();
         void DeleteCorpseData();
@@ -633,15 +656,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
             return GetGuidSequenceGenerator<high>().GetNextAfterMaxUsed();
         }
 
-        void AddUpdateObject(Object* obj)
-        {
-            _updateObjects.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            _updateObjects.erase(obj);
-        }
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
 
         size_t GetActiveNonPlayersCount() const
         {
@@ -656,6 +672,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void LoadMap(int gx, int gy, bool reload = false);
         void LoadMMap(int gx, int gy);
         GridMap* GetGrid(float x, float y);
+        void PrefetchGridsAhead(float oldX, float oldY, float x, float y);
+        float SelectHeight(float x, float y, float z, float gridHeight, bool checkVMap, float maxSearchDist) const;
 
         void SetTimer(uint32 t) { i_gridExpiry = t < MIN_GRID_DELAY ? MIN_GRID_DELAY : t; }
 
@@ -704,6 +722,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void SendObjectUpdates();
 
+        // uncached collision queries behind isInLineOfSight
+        bool CheckLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        void CheckLineOfSight(VMAP::LineOfSightRay* rays, uint32 const* phaseMasks, uint32 count, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+
     protected:
         void SetUnloadReferenceLock(GridCoord const& p, bool on) { getNGrid(p.x_coord, p.y_coord)->setUnloadReferenceLock(on); }
 
@@ -716,6 +738,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 m_unloadTimer;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable MapQueryCache _queryCache;              // only used from the thread updating this map, const queries fill it too
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -851,6 +874,10 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         RespawnListContainer _respawnTimes;
         RespawnInfoMap       _creatureRespawnTimesBySpawnId;
         RespawnInfoMap       _gameObjectRespawnTimesBySpawnId;
+        std::deque<RespawnInfo> _respawnInfoStorage;   // keeps all respawn infos of the map in a few contiguous blocks
+        std::vector<RespawnInfo*> _freeRespawnInfos;
+        RespawnInfo* AllocateRespawnInfo(RespawnInfo const& info);
+        void FreeRespawnInfo(RespawnInfo* info);
         RespawnInfoMap& GetRespawnMapForType(SpawnObjectType type)
         {
             switch (type)
@@ -880,6 +907,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_set<uint32> _toggledSpawnGroupIds;
 
         uint32 _respawnCheckTimer;
+        RespawnWriteBuffer _respawnWriteBuffer;
+        uint32 _respawnFlushTimer;
         std::unordered_map<uint32, uint32> _zonePlayerCountMap;
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
@@ -903,7 +932,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::unordered_map<ObjectGuid, Corpse*> _corpsesByPlayer;
         std::unordered_set<Corpse*> _corpseBones;
 
-        std::unordered_set<Object*> _updateObjects;
+        std::vector<Object*> _updateObjects;
 
         MPSCQueue<FarSpellCallback> _farSpellCallbacks;
 };
@@ -19,6 +19,8 @@
 #include "InstanceSaveMgr.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
+#include "Metric.h"
+#include "MMapFactory.h"
 #include "ObjectAccessor.h"
 #include "Transport.h"
 #include "GridDefines.h"
@@ -51,6 +53,9 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 gridLoadThreads = sWorld->getIntConfig(CONFIG_MAP_ASYNC_GRID_LOAD_THREADS))
+        _asyncGridLoader.Start(gridLoadThreads, sWorld->GetDataPath(), sWorld->getBoolConfig(CONFIG_MAP_COMPACT_HEIGHTS));
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -226,6 +231,20 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    MMAP::MMapMemoryStats mmapStats = MMAP::MMapFactory::createOrGetMMapManager()->GetMemoryStats();
+    TC_METRIC_VALUE("mmap_tiles", mmapStats.LoadedTiles);
+    TC_METRIC_VALUE("mmap_tile_bytes", mmapStats.TileBytes);
+    TC_METRIC_VALUE("mmap_queries", mmapStats.NavMeshQueries);
+    TC_METRIC_VALUE("mmap_query_bytes", mmapStats.NavMeshQueryBytes);
+
+    if (_asyncGridLoader.IsStarted())
+    {
+        AsyncGridLoader::Stats gridLoaderStats = _asyncGridLoader.ConsumeStats();
+        TC_METRIC_VALUE("grid_prefetch_loaded", gridLoaderStats.Loaded);
+        TC_METRIC_VALUE("grid_prefetch_taken", gridLoaderStats.Taken);
+        TC_METRIC_VALUE("grid_prefetch_discarded", gridLoaderStats.Discarded);
+    }
+
     i_timer.SetCurrent(0);
 }
 
@@ -265,6 +284,8 @@ void MapManager::UnloadAll()
     if (m_updater.activated())
         m_updater.deactivate();
 
+    _asyncGridLoader.Stop();
+
     Map::DeleteStateMachine();
 }
 
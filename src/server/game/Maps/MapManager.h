@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "MapInstanced.h"
 #include "GridStates.h"
+#include "AsyncGridLoader.h"
 #include "MapUpdater.h"
 #include <boost/dynamic_bitset.hpp>
 
@@ -127,6 +128,7 @@ class TC_GAME_API MapManager
         void FreeInstanceId(uint32 instanceId);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        AsyncGridLoader& GetAsyncGridLoader() { return _asyncGridLoader; }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
@@ -163,6 +165,7 @@ class TC_GAME_API MapManager
         InstanceIds _freeInstanceIds;
         uint32 _nextInstanceId;
         MapUpdater m_updater;
+        AsyncGridLoader _asyncGridLoader;
 
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
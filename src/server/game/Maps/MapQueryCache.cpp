@@ -0,0 +1,112 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapQueryCache.h"
+#include "Hash.h"
+#include <cmath>
+
+namespace
+{
+    int32 Quantize(float value)
+    {
+        return int32(std::floor(value / MapQueryCache::QUANTIZATION_STEP));
+    }
+}
+
+void MapQueryCache::SetEnabled(bool enabled)
+{
+    _enabled = enabled;
+    if (!_enabled)
+        NewEpoch();
+}
+
+void MapQueryCache::NewEpoch()
+{
+    _lineOfSight.clear();
+    _vmapHeights.clear();
+    _vmapAreaAndLiquidData.clear();
+}
+
+MapQueryCache::LineOfSightKey MapQueryCache::MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks, uint32 ignoreFlags)
+{
+    return { { Quantize(x1), Quantize(y1), Quantize(z1), Quantize(x2), Quantize(y2), Quantize(z2) }, phaseMask, checks | (ignoreFlags << 16) };
+}
+
+MapQueryCache::PositionKey MapQueryCache::MakeHeightKey(float x, float y, float z, float maxSearchDist)
+{
+    return { { Quantize(x), Quantize(y), Quantize(z) }, uint32(Quantize(maxSearchDist)) };
+}
+
+MapQueryCache::PositionKey MapQueryCache::MakeAreaAndLiquidKey(float x, float y, float z, uint8 reqLiquidType)
+{
+    return { { Quantize(x), Quantize(y), Quantize(z) }, reqLiquidType };
+}
+
+template<typename Container>
+typename Container::mapped_type const* MapQueryCache::Find(Container const& container, typename Container::key_type const& key)
+{
+    auto itr = container.find(key);
+    if (itr == container.end())
+    {
+        ++_stats.Misses;
+        return nullptr;
+    }
+
+    ++_stats.Hits;
+    return &itr->second;
+}
+
+bool const* MapQueryCache::FindLineOfSight(LineOfSightKey const& key)
+{
+    return Find(_lineOfSight, key);
+}
+
+float const* MapQueryCache::FindVMapHeight(PositionKey const& key)
+{
+    return Find(_vmapHeights, key);
+}
+
+VMAP::AreaAndLiquidData const* MapQueryCache::FindVMapAreaAndLiquidData(PositionKey const& key)
+{
+    return Find(_vmapAreaAndLiquidData, key);
+}
+
+MapQueryCache::Stats MapQueryCache::ConsumeStats()
+{
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+std::size_t MapQueryCache::LineOfSightKeyHash::operator()(LineOfSightKey const& key) const
+{
+    std::size_t hashVal = 0;
+    for (int32 coord : key.Coords)
+        Trinity::hash_combine(hashVal, coord);
+    Trinity::hash_combine(hashVal, key.PhaseMask);
+    Trinity::hash_combine(hashVal, key.Flags);
+    return hashVal;
+}
+
+std::size_t MapQueryCache::PositionKeyHash::operator()(PositionKey const& key) const
+{
+    std::size_t hashVal = 0;
+    for (int32 coord : key.Coords)
+        Trinity::hash_combine(hashVal, coord);
+    Trinity::hash_combine(hashVal, key.Extra);
+    return hashVal;
+}
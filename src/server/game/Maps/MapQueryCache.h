@@ -0,0 +1,101 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MapQueryCache_h__
+#define MapQueryCache_h__
+
+#include "Define.h"
+#include "IVMapManager.h"
+#include <array>
+#include <unordered_map>
+
+/*
+ * Remembers results of collision queries made during one map update.
+ * Positions are quantized to QUANTIZATION_STEP so repeated queries between objects that did not move
+ * (or moved less than the step) reuse the previous result instead of tracing the vmap trees again.
+ * Entries are dropped at the start of every map update and line of sight results also whenever
+ * the gameobject models of the map change. Not thread safe, only used from the owning map's update.
+ */
+class TC_GAME_API MapQueryCache
+{
+    public:
+        static constexpr float QUANTIZATION_STEP = 0.125f;
+
+        struct LineOfSightKey
+        {
+            std::array<int32, 6> Coords;
+            uint32 PhaseMask;
+            uint32 Flags;
+
+            bool operator==(LineOfSightKey const& right) const { return Coords == right.Coords && PhaseMask == right.PhaseMask && Flags == right.Flags; }
+        };
+
+        struct PositionKey
+        {
+            std::array<int32, 3> Coords;
+            uint32 Extra;
+
+            bool operator==(PositionKey const& right) const { return Coords == right.Coords && Extra == right.Extra; }
+        };
+
+        struct Stats
+        {
+            uint64 Hits = 0;
+            uint64 Misses = 0;
+        };
+
+        MapQueryCache() : _enabled(false) { }
+
+        bool IsEnabled() const { return _enabled; }
+        void SetEnabled(bool enabled);
+
+        // starts a new update, all cached results are dropped
+        void NewEpoch();
+        // gameobject models were added, removed, moved or toggled
+        void InvalidateGameObjectModels() { _lineOfSight.clear(); }
+
+        static LineOfSightKey MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks, uint32 ignoreFlags);
+        static PositionKey MakeHeightKey(float x, float y, float z, float maxSearchDist);
+        static PositionKey MakeAreaAndLiquidKey(float x, float y, float z, uint8 reqLiquidType);
+
+        bool const* FindLineOfSight(LineOfSightKey const& key);
+        void StoreLineOfSight(LineOfSightKey const& key, bool inLineOfSight) { _lineOfSight.emplace(key, inLineOfSight); }
+
+        float const* FindVMapHeight(PositionKey const& key);
+        void StoreVMapHeight(PositionKey const& key, float height) { _vmapHeights.emplace(key, height); }
+
+        VMAP::AreaAndLiquidData const* FindVMapAreaAndLiquidData(PositionKey const& key);
+        void StoreVMapAreaAndLiquidData(PositionKey const& key, VMAP::AreaAndLiquidData const& data) { _vmapAreaAndLiquidData.emplace(key, data); }
+
+        // returns hits and misses since the previous call
+        Stats ConsumeStats();
+
+    private:
+        struct LineOfSightKeyHash { std::size_t operator()(LineOfSightKey const& key) const; };
+        struct PositionKeyHash { std::size_t operator()(PositionKey const& key) const; };
+
+        template<typename Container>
+        typename Container::mapped_type const* Find(Container const& container, typename Container::key_type const& key);
+
+        bool _enabled;
+        Stats _stats;
+        std::unordered_map<LineOfSightKey, bool, LineOfSightKeyHash> _lineOfSight;
+        std::unordered_map<PositionKey, float, PositionKeyHash> _vmapHeights;
+        std::unordered_map<PositionKey, VMAP::AreaAndLiquidData, PositionKeyHash> _vmapAreaAndLiquidData;
+};
+
+#endif // MapQueryCache_h__
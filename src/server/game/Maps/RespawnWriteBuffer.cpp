@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RespawnWriteBuffer.h"
+
+void RespawnWriteBuffer::Save(SpawnObjectType type, ObjectGuid::LowType spawnId, time_t respawnTime)
+{
+    ++_stats.Requested;
+    _pending[MakeKey(type, spawnId)] = respawnTime;
+}
+
+void RespawnWriteBuffer::Delete(SpawnObjectType type, ObjectGuid::LowType spawnId)
+{
+    ++_stats.Requested;
+
+    uint64 key = MakeKey(type, spawnId);
+    if (_persisted.count(key))
+        _pending[key] = 0;
+    else
+        _pending.erase(key); // row was never written, drop the pending save (if any)
+}
+
+void RespawnWriteBuffer::WrittenDirectly(SpawnObjectType type, ObjectGuid::LowType spawnId, bool persisted)
+{
+    uint64 key = MakeKey(type, spawnId);
+    _pending.erase(key);
+    if (persisted)
+        _persisted.insert(key);
+    else
+        _persisted.erase(key);
+}
+
+void RespawnWriteBuffer::Clear()
+{
+    _pending.clear();
+    _persisted.clear();
+}
+
+std::vector<RespawnWriteBuffer::Write> RespawnWriteBuffer::TakePending()
+{
+    std::vector<Write> writes;
+    writes.reserve(_pending.size());
+    for (auto const& pending : _pending)
+    {
+        writes.push_back({ SpawnObjectType(pending.first >> 32), ObjectGuid::LowType(pending.first & 0xFFFFFFFF), pending.second });
+        if (pending.second)
+            _persisted.insert(pending.first);
+        else
+            _persisted.erase(pending.first);
+    }
+
+    _stats.Written += writes.size();
+    _pending.clear();
+    return writes;
+}
+
+RespawnWriteBuffer::Stats RespawnWriteBuffer::ConsumeStats()
+{
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
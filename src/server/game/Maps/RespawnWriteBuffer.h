@@ -0,0 +1,84 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RespawnWriteBuffer_h__
+#define RespawnWriteBuffer_h__
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include "SpawnData.h"
+#include <ctime>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Collects respawn time writes of one map between two flushes so only the final state of every spawn reaches the database.
+ * A respawn time that is saved and deleted again before the next flush (a creature that died and respawned in between)
+ * produces no statement at all, repeated saves of the same spawn produce one.
+ * Remembers which spawns have a row in the database so deletes of rows that were never written can be skipped,
+ * this requires every respawn write of the map to be either buffered or reported through WrittenDirectly.
+ * Not thread safe, only used from the owning map's update.
+ */
+class TC_GAME_API RespawnWriteBuffer
+{
+    public:
+        struct Write
+        {
+            SpawnObjectType Type;
+            ObjectGuid::LowType SpawnId;
+            time_t RespawnTime; // 0 deletes the row
+        };
+
+        struct Stats
+        {
+            uint64 Requested = 0;
+            uint64 Written = 0;
+        };
+
+        RespawnWriteBuffer() = default;
+
+        // row found in the database when the map loaded its respawn times
+        void SetPersisted(SpawnObjectType type, ObjectGuid::LowType spawnId) { _persisted.insert(MakeKey(type, spawnId)); }
+
+        void Save(SpawnObjectType type, ObjectGuid::LowType spawnId, time_t respawnTime);
+        void Delete(SpawnObjectType type, ObjectGuid::LowType spawnId);
+
+        // a write bypassed the buffer (appended to a caller supplied transaction), it supersedes whatever was pending for the spawn
+        void WrittenDirectly(SpawnObjectType type, ObjectGuid::LowType spawnId, bool persisted);
+
+        // all respawn times of the map were deleted from the database
+        void Clear();
+
+        bool HasPending() const { return !_pending.empty(); }
+        std::size_t GetPendingCount() const { return _pending.size(); }
+
+        // returns the coalesced writes and assumes the caller executes them
+        std::vector<Write> TakePending();
+
+        // returns requested and actually written statements since the previous call
+        Stats ConsumeStats();
+
+    private:
+        static uint64 MakeKey(SpawnObjectType type, ObjectGuid::LowType spawnId) { return (uint64(type) << 32) | spawnId; }
+
+        std::unordered_map<uint64, time_t> _pending;
+        std::unordered_set<uint64> _persisted;
+        Stats _stats;
+};
+
+#endif // RespawnWriteBuffer_h__
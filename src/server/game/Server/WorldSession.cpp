@@ -69,7 +69,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_SESSION)
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -91,7 +91,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_SESSION)
         return true;
 
     //no player attached? -> our client! ^^
@@ -103,6 +103,14 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+bool ParallelSessionFilter::Process(WorldPacket* packet)
+{
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
+
+    //stop at the first packet that has to wait for World::UpdateSessions() so packet order is kept
+    return opHandle->ProcessingPlace == PROCESS_INPLACE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_SESSION;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, std::string&& name, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion, time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter):
     m_muteTime(mute_time),
@@ -278,6 +286,63 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     if (IsConnectionIdle() && !HasPermission(rbac::RBAC_PERM_IGNORE_IDLE_CONNECTION))
         m_Socket->CloseSocket();
 
+    time_t currentTime = GameTime::GetGameTime();
+
+    ProcessPackets(updater, currentTime);
+
+    if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
+    {
+        // Send time sync packet every 10s.
+        if (_timeSyncTimer > 0)
+        {
+            if (diff >= _timeSyncTimer)
+                SendTimeSync();
+            else
+                _timeSyncTimer -= diff;
+        }
+    }
+
+    ProcessQueryCallbacks();
+
+    //check if we are safe to proceed with logout
+    //logout procedure should happen only in World::UpdateSessions() method!!!
+    if (updater.ProcessUnsafe())
+    {
+        if (m_Socket && m_Socket->IsOpen() && _warden)
+            _warden->Update(diff);
+
+        ///- If necessary, log the player out
+        if (ShouldLogOut(currentTime) && !m_playerLoading)
+            LogoutPlayer(true);
+
+        ///- Cleanup socket pointer if need
+        if (m_Socket && !m_Socket->IsOpen())
+        {
+            if (GetPlayer() && _warden)
+                _warden->Update(diff);
+
+            expireTime -= expireTime > diff ? diff : expireTime;
+            if (expireTime < diff || forceExit || !GetPlayer())
+            {
+                m_Socket = nullptr;
+            }
+        }
+
+        if (!m_Socket)
+            return false;                                       //Will remove this session from the world session map
+    }
+
+    return true;
+}
+
+void WorldSession::ProcessParallelPackets()
+{
+    ParallelSessionFilter updater(this);
+    ProcessPackets(updater, GameTime::GetGameTime());
+}
+
+void WorldSession::ProcessPackets(PacketFilter& updater, time_t currentTime)
+{
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = nullptr;
@@ -285,7 +350,6 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     bool deletePacket = true;
     std::vector<WorldPacket*> requeuePackets;
     uint32 processedPackets = 0;
-    time_t currentTime = GameTime::GetGameTime();
 
     while (m_Socket && _recvQueue.next(packet, updater))
     {
@@ -418,50 +482,6 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
     _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
-
-    if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
-    {
-        // Send time sync packet every 10s.
-        if (_timeSyncTimer > 0)
-        {
-            if (diff >= _timeSyncTimer)
-                SendTimeSync();
-            else
-                _timeSyncTimer -= diff;
-        }
-    }
-
-    ProcessQueryCallbacks();
-
-    //check if we are safe to proceed with logout
-    //logout procedure should happen only in World::UpdateSessions() method!!!
-    if (updater.ProcessUnsafe())
-    {
-        if (m_Socket && m_Socket->IsOpen() && _warden)
-            _warden->Update(diff);
-
-        ///- If necessary, log the player out
-        if (ShouldLogOut(currentTime) && !m_playerLoading)
-            LogoutPlayer(true);
-
-        ///- Cleanup socket pointer if need
-        if (m_Socket && !m_Socket->IsOpen())
-        {
-            if (GetPlayer() && _warden)
-                _warden->Update(diff);
-
-            expireTime -= expireTime > diff ? diff : expireTime;
-            if (expireTime < diff || forceExit || !GetPlayer())
-            {
-                m_Socket = nullptr;
-            }
-        }
-
-        if (!m_Socket)
-            return false;                                       //Will remove this session from the world session map
-    }
-
-    return true;
 }
 
 /// %Log the player out
@@ -330,6 +330,18 @@ public:
     virtual bool Process(WorldPacket* packet) override;
 };
 
+//process only packets that may run concurrently with other sessions
+//used by World::UpdateSessions() worker threads for sessions without a player in world
+class ParallelSessionFilter : public PacketFilter
+{
+public:
+    explicit ParallelSessionFilter(WorldSession* pSession) : PacketFilter(pSession) { }
+    ~ParallelSessionFilter() { }
+
+    virtual bool Process(WorldPacket* packet) override;
+    virtual bool ProcessUnsafe() const override { return false; }
+};
+
 // Proxy structure to contain data passed to callback function,
 // only to prevent bloating the parameter list
 class CharacterCreateInfo
@@ -479,6 +491,9 @@ class TC_GAME_API WorldSession
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
 
+        /// Handles queued packets that are safe to process concurrently with other sessions, see ParallelSessionFilter
+        void ProcessParallelPackets();
+
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQueue(uint32 position);
 
@@ -1118,6 +1133,7 @@ class TC_GAME_API WorldSession
         SQLQueryHolderCallback& AddQueryHolderCallback(SQLQueryHolderCallback&& callback);
 
     private:
+        void ProcessPackets(PacketFilter& updater, time_t currentTime);
         void ProcessQueryCallbacks();
 
         QueryCallbackProcessor _queryProcessor;
@@ -2021,8 +2021,13 @@ void Aura::PrepareProcToTrigger(AuraApplication* aurApp, ProcEventInfo& eventInf
 
 uint8 Aura::GetProcEffectMask(AuraApplication* aurApp, ProcEventInfo& eventInfo, TimePoint now) const
 {
-    SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(GetId());
+    // most auras are rejected here, by the spell proc entry's proc flags, without touching more than the hot data of the spell
+    SpellInfoHotData const* hotData = sSpellMgr->GetSpellInfoHotData(GetId());
+    if (!hotData || !(eventInfo.GetTypeMask() & hotData->ProcFlags))
+        return 0;
+
     // only auras with spell proc entry can trigger proc
+    SpellProcEntry const* procEntry = hotData->ProcEntry;
     if (!procEntry)
         return 0;
 
@@ -2035,7 +2040,7 @@ uint8 Aura::GetProcEffectMask(AuraApplication* aurApp, ProcEventInfo& eventInfo,
 
         // check if aura can proc when spell is triggered (exception for hunter auto shot & wands)
         if (spell->IsTriggered() && !(procEntry->AttributesMask & PROC_ATTR_TRIGGERED_CAN_PROC) && !(eventInfo.GetTypeMask() & AUTO_ATTACK_PROC_FLAG_MASK))
-            if (!GetSpellInfo()->HasAttribute(SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED))
+            if (!hotData->HasAttribute(SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED))
                 return 0;
 
         if (spell->m_CastItem && (procEntry->AttributesMask & PROC_ATTR_CANT_PROC_FROM_ITEM_CAST))
@@ -2043,7 +2048,7 @@ uint8 Aura::GetProcEffectMask(AuraApplication* aurApp, ProcEventInfo& eventInfo,
     }
 
     // check don't break stealth attr present
-    if (m_spellInfo->HasAura(SPELL_AURA_MOD_STEALTH))
+    if (hotData->HasAura(SPELL_AURA_MOD_STEALTH))
     {
         if (SpellInfo const* spellInfo = eventInfo.GetSpellInfo())
             if (spellInfo->HasAttribute(SPELL_ATTR0_CU_DONT_BREAK_STEALTH))
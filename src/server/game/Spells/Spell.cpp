@@ -41,6 +41,7 @@
 #include "PathGenerator.h"
 #include "Pet.h"
 #include "Player.h"
+#include "ScratchVector.h"
 #include "ScriptMgr.h"
 #include "SharedDefines.h"
 #include "SpellAuraEffects.h"
@@ -1171,7 +1172,7 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
         ABORT_MSG("Spell::SelectImplicitConeTargets: received not implemented target reference type");
         return;
     }
-    std::list<WorldObject*> targets;
+    Trinity::ScratchVector<WorldObject*> targets;
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
     ConditionContainer* condList = m_spellInfo->Effects[effIndex].ImplicitTargetConditions;
@@ -1187,22 +1188,22 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     if (uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList))
     {
         Trinity::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
-        Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
+        Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> searcher(m_caster, *targets, check, containerTypeMask);
         SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
 
-        CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
+        CallScriptObjectAreaTargetSelectHandlers(*targets, effIndex, targetType);
 
-        if (!targets.empty())
+        if (!targets->empty())
         {
             // Other special target selection goes here
             if (uint32 maxTargets = m_spellValue->MaxAffectedTargets)
             {
                 if (Unit* unitCaster = m_caster->ToUnit())
                     maxTargets += unitCaster->GetTotalAuraModifierByAffectMask(SPELL_AURA_MOD_MAX_AFFECTED_TARGETS, m_spellInfo);
-                Trinity::Containers::RandomResize(targets, maxTargets);
+                Trinity::Containers::RandomResize(*targets, maxTargets);
             }
 
-            for (WorldObject* itr : targets)
+            for (WorldObject* itr : *targets)
             {
                 if (Unit* unit = itr->ToUnit())
                     AddUnitTarget(unit, effMask, false);
@@ -1266,7 +1267,7 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
              ABORT_MSG("Spell::SelectImplicitAreaTargets: received not implemented target reference type");
              return;
     }
-    std::list<WorldObject*> targets;
+    Trinity::ScratchVector<WorldObject*> targets;
     float radius = m_spellInfo->Effects[effIndex].CalcRadius(m_caster);
     // Workaround for some spells that don't have RadiusEntry set in dbc (but SpellRange instead)
     if (G3D::fuzzyEq(radius, 0.f))
@@ -1274,24 +1275,26 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
 
     radius *= m_spellValue->RadiusMod;
 
-    SearchAreaTargets(targets, radius, center, referer, targetType.GetObjectType(), targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
+    SearchAreaTargets(*targets, radius, center, referer, targetType.GetObjectType(), targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
 
-    CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
+    CallScriptObjectAreaTargetSelectHandlers(*targets, effIndex, targetType);
 
-    if (!targets.empty())
+    if (!targets->empty())
     {
         // Other special target selection goes here
         if (uint32 maxTargets = m_spellValue->MaxAffectedTargets)
         {
             if (Unit* unitCaster = m_caster->ToUnit())
                 maxTargets += unitCaster->GetTotalAuraModifierByAffectMask(SPELL_AURA_MOD_MAX_AFFECTED_TARGETS, m_spellInfo);
-            Trinity::Containers::RandomResize(targets, maxTargets);
+            Trinity::Containers::RandomResize(*targets, maxTargets);
         }
 
-        for (WorldObject* itr : targets)
+        bool const losChecked = RemoveAreaTargetsNotInLOS(*targets, effMask, *center);
+
+        for (WorldObject* itr : *targets)
         {
             if (Unit* unit = itr->ToUnit())
-                AddUnitTarget(unit, effMask, false, true, center);
+                AddUnitTarget(unit, effMask, false, true, center, losChecked);
             else if (GameObject* gObjTarget = itr->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
             else if (Corpse* corpse = itr->ToCorpse())
@@ -1580,15 +1583,15 @@ void Spell::SelectImplicitChainTargets(SpellEffIndex effIndex, SpellImplicitTarg
                 m_damageMultipliers[k] = 1.0f;
         m_applyMultiplierMask |= effMask;
 
-        std::list<WorldObject*> targets;
-        SearchChainTargets(targets, maxTargets - 1, target, targetType.GetObjectType(), targetType.GetCheckType()
+        Trinity::ScratchVector<WorldObject*> targets;
+        SearchChainTargets(*targets, maxTargets - 1, target, targetType.GetObjectType(), targetType.GetCheckType()
             , m_spellInfo->Effects[effIndex].ImplicitTargetConditions, targetType.GetTarget() == TARGET_UNIT_TARGET_CHAINHEAL_ALLY);
 
         // Chain primary target is added earlier
-        CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
+        CallScriptObjectAreaTargetSelectHandlers(*targets, effIndex, targetType);
 
-        for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
-            if (Unit* unit = (*itr)->ToUnit())
+        for (WorldObject* chainTarget : *targets)
+            if (Unit* unit = chainTarget->ToUnit())
                 AddUnitTarget(unit, effMask, false);
     }
 }
@@ -1618,14 +1621,14 @@ void Spell::SelectImplicitTrajTargets(SpellEffIndex effIndex, SpellImplicitTarge
     srcPos.SetOrientation(m_caster->GetOrientation());
     float srcToDestDelta = m_targets.GetDstPos()->m_positionZ - srcPos.m_positionZ;
 
-    std::list<WorldObject*> targets;
+    Trinity::ScratchVector<WorldObject*> targets;
     Trinity::WorldObjectSpellTrajTargetCheck check(dist2d, &srcPos, m_caster, m_spellInfo, targetType.GetCheckType(), m_spellInfo->Effects[effIndex].ImplicitTargetConditions);
-    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(m_caster, targets, check, GRID_MAP_TYPE_MASK_ALL);
+    Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(m_caster, *targets, check, GRID_MAP_TYPE_MASK_ALL);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> > (searcher, GRID_MAP_TYPE_MASK_ALL, m_caster, &srcPos, dist2d);
-    if (targets.empty())
+    if (targets->empty())
         return;
 
-    targets.sort(Trinity::ObjectDistanceOrderPred(m_caster));
+    std::stable_sort(targets->begin(), targets->end(), Trinity::ObjectDistanceOrderPred(m_caster));
 
     float b = tangent(m_targets.GetElevation());
     float a = (srcToDestDelta - dist2d * b) / (dist2d * dist2d);
@@ -1640,7 +1643,7 @@ void Spell::SelectImplicitTrajTargets(SpellEffIndex effIndex, SpellImplicitTarge
 
     // GameObjects don't cast traj
     Unit* unitCaster = ASSERT_NOTNULL(m_caster->ToUnit());
-    for (auto itr = targets.begin(); itr != targets.end(); ++itr)
+    for (auto itr = targets->begin(); itr != targets->end(); ++itr)
     {
         if (m_spellInfo->CheckTarget(unitCaster, *itr, true) != SPELL_CAST_OK)
             continue;
@@ -1860,7 +1863,7 @@ WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objec
     return target;
 }
 
-void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
+void Spell::SearchAreaTargets(std::vector<WorldObject*>& targets, float range, Position const* position, WorldObject* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer* condList)
 {
     uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList);
     if (!containerTypeMask)
@@ -1870,7 +1873,7 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range);
 }
 
-void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, ConditionContainer* condList, bool isChainHeal)
+void Spell::SearchChainTargets(std::vector<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, ConditionContainer* condList, bool isChainHeal)
 {
     // max dist for jump target selection
     float jumpRadius = 0.0f;
@@ -1905,31 +1908,25 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
     if (isBouncingFar)
         searchRadius *= chainTargets;
 
-    std::list<WorldObject*> tempTargets;
+    Trinity::ScratchVector<WorldObject*> scratchTargets;
+    std::vector<WorldObject*>& tempTargets = *scratchTargets;
     SearchAreaTargets(tempTargets, searchRadius, target, m_caster, objectType, selectType, condList);
-    tempTargets.remove(target);
+    tempTargets.erase(std::remove(tempTargets.begin(), tempTargets.end(), target), tempTargets.end());
 
     // remove targets which are always invalid for chain spells
     // for some spells allow only chain targets in front of caster (swipe for example)
     if (!isBouncingFar)
-    {
-        for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end();)
-        {
-            std::list<WorldObject*>::iterator checkItr = itr++;
-            if (!m_caster->HasInArc(static_cast<float>(M_PI), *checkItr))
-                tempTargets.erase(checkItr);
-        }
-    }
+        tempTargets.erase(std::remove_if(tempTargets.begin(), tempTargets.end(), [&](WorldObject* tempTarget) { return !m_caster->HasInArc(static_cast<float>(M_PI), tempTarget); }), tempTargets.end());
 
     while (chainTargets)
     {
         // try to get unit for next chain jump
-        std::list<WorldObject*>::iterator foundItr = tempTargets.end();
+        std::vector<WorldObject*>::iterator foundItr = tempTargets.end();
         // get unit with highest hp deficit in dist
         if (isChainHeal)
         {
             uint32 maxHPDeficit = 0;
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
+            for (std::vector<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
             {
                 if (Unit* unit = (*itr)->ToUnit())
                 {
@@ -1945,7 +1942,7 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         // get closest object
         else
         {
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
+            for (std::vector<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
             {
                 if (foundItr == tempTargets.end())
                 {
@@ -2074,10 +2071,10 @@ class ProcReflectDelayed : public BasicEvent
         ObjectGuid _casterGuid;
 };
 
-void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*= true*/, bool implicit /*= true*/, Position const* losPosition /*= nullptr*/)
+void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*= true*/, bool implicit /*= true*/, Position const* losPosition /*= nullptr*/, bool losChecked /*= false*/)
 {
     for (uint32 effIndex = 0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
-        if (!m_spellInfo->Effects[effIndex].IsEffect() || !CheckEffectTarget(target, effIndex, losPosition))
+        if (!m_spellInfo->Effects[effIndex].IsEffect() || !CheckEffectTarget(target, effIndex, losPosition, losChecked))
             effectMask &= ~(1 << effIndex);
 
     // no effects left
@@ -2172,6 +2169,51 @@ void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*=
     m_UniqueTargetInfo.emplace_back(std::move(targetInfo));
 }
 
+// Traces the line of sight of all unit targets of an area effect together, as done one by one by CheckEffectTarget
+// Returns false if the targets still have to be checked by CheckEffectTarget
+bool Spell::RemoveAreaTargetsNotInLOS(std::vector<WorldObject*>& targets, uint32 effMask, Position const& losPosition) const
+{
+    if (IsTargetLOSCheckIgnored())
+        return false;
+
+    // these effects have their own line of sight rules
+    for (uint32 effIndex = 0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
+        if (effMask & (1 << effIndex))
+            if (m_spellInfo->Effects[effIndex].IsEffect(SPELL_EFFECT_RESURRECT_NEW) || m_spellInfo->Effects[effIndex].IsEffect(SPELL_EFFECT_SKIN_PLAYER_CORPSE))
+                return false;
+
+    Trinity::ScratchVector<VMAP::LineOfSightRay> rays;
+    Trinity::ScratchVector<uint32> phaseMasks;
+    for (WorldObject* target : targets)
+    {
+        // units outside of the world are always in line of sight
+        Unit* unit = target->ToUnit();
+        if (!unit || !unit->IsInWorld())
+            continue;
+
+        rays->emplace_back();
+        unit->GetLineOfSightRay(losPosition.GetPositionX(), losPosition.GetPositionY(), losPosition.GetPositionZ(), rays->back());
+        phaseMasks->push_back(unit->GetPhaseMask());
+    }
+
+    if (rays->empty())
+        return true;
+
+    m_caster->GetMap()->isInLineOfSight(rays->data(), phaseMasks->data(), uint32(rays->size()), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2);
+
+    auto ray = rays->begin();
+    targets.erase(std::remove_if(targets.begin(), targets.end(), [&](WorldObject* target)
+    {
+        Unit* unit = target->ToUnit();
+        if (!unit || !unit->IsInWorld())
+            return false;
+
+        return !(ray++)->inLineOfSight;
+    }), targets.end());
+
+    return true;
+}
+
 void Spell::AddGOTarget(GameObject* go, uint32 effectMask)
 {
     for (uint32 effIndex = 0; effIndex < MAX_SPELL_EFFECTS; ++effIndex)
@@ -7280,7 +7322,7 @@ CurrentSpellTypes Spell::GetCurrentContainer() const
     return CURRENT_GENERIC_SPELL;
 }
 
-bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* losPosition) const
+bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* losPosition, bool losChecked /*= false*/) const
 {
     switch (m_spellInfo->Effects[eff].ApplyAuraName)
     {
@@ -7302,17 +7344,7 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* lo
             break;
     }
 
-    // check for ignore LOS on the effect itself
-    if (m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, nullptr, SPELL_DISABLE_LOS))
-        return true;
-
-    // check if gameobject ignores LOS
-    if (GameObject const* gobCaster = m_caster->ToGameObject())
-        if (gobCaster->GetGOInfo()->IsIgnoringLOSChecks())
-            return true;
-
-    // if spell is triggered, need to check for LOS disable on the aura triggering it and inherit that behaviour
-    if (IsTriggered() && m_triggeredByAuraSpell && (m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_triggeredByAuraSpell->Id, nullptr, SPELL_DISABLE_LOS)))
+    if (IsTargetLOSCheckIgnored())
         return true;
 
     /// @todo shit below shouldn't be here, but it's temporary
@@ -7366,6 +7398,9 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* lo
         }
         default:                                            // normal case
         {
+            if (losChecked)
+                break;
+
             if (losPosition)
                 return target->IsWithinLOS(losPosition->GetPositionX(), losPosition->GetPositionY(), losPosition->GetPositionZ(), LINEOFSIGHT_ALL_CHECKS, VMAP::ModelIgnoreFlags::M2);
             else
@@ -7386,6 +7421,24 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff, Position const* lo
     return true;
 }
 
+bool Spell::IsTargetLOSCheckIgnored() const
+{
+    // check for ignore LOS on the effect itself
+    if (m_spellInfo->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_spellInfo->Id, nullptr, SPELL_DISABLE_LOS))
+        return true;
+
+    // check if gameobject ignores LOS
+    if (GameObject const* gobCaster = m_caster->ToGameObject())
+        if (gobCaster->GetGOInfo()->IsIgnoringLOSChecks())
+            return true;
+
+    // if spell is triggered, need to check for LOS disable on the aura triggering it and inherit that behaviour
+    if (IsTriggered() && m_triggeredByAuraSpell && (m_triggeredByAuraSpell->HasAttribute(SPELL_ATTR2_CAN_TARGET_NOT_IN_LOS) || DisableMgr::IsDisabledFor(DISABLE_TYPE_SPELL, m_triggeredByAuraSpell->Id, nullptr, SPELL_DISABLE_LOS)))
+        return true;
+
+    return false;
+}
+
 bool Spell::IsTriggered() const
 {
     return (_triggeredCastFlags & TRIGGERED_FULL_MASK) != 0;
@@ -7977,18 +8030,30 @@ void Spell::CallScriptAfterHitHandlers()
     }
 }
 
-void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
+void Spell::CallScriptObjectAreaTargetSelectHandlers(std::vector<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    // hooks take a std::list, only built when a script actually handles this effect
+    Optional<std::list<WorldObject*>> scriptTargets;
     for (auto scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT);
         auto hookItrEnd = (*scritr)->OnObjectAreaTargetSelect.end(), hookItr = (*scritr)->OnObjectAreaTargetSelect.begin();
         for (; hookItr != hookItrEnd; ++hookItr)
+        {
             if (hookItr->IsEffectAffected(m_spellInfo, effIndex) && targetType.GetTarget() == hookItr->GetTarget())
-                hookItr->Call(*scritr, targets);
+            {
+                if (!scriptTargets)
+                    scriptTargets.emplace(targets.begin(), targets.end());
+
+                hookItr->Call(*scritr, *scriptTargets);
+            }
+        }
 
         (*scritr)->_FinishScriptCall();
     }
+
+    if (scriptTargets)
+        targets.assign(scriptTargets->begin(), scriptTargets->end());
 }
 
 void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
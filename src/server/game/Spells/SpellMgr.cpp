@@ -1875,6 +1875,9 @@ void SpellMgr::LoadSpellProcs()
         ++count;
     }
 
+    // reload case, hot data still points to the cleared entries
+    LinkSpellInfoHotDataProcEntries();
+
     TC_LOG_INFO("server.loading", ">> Generated spell proc data for %u spells in %u ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -2592,6 +2595,7 @@ void SpellMgr::UnloadSpellInfoStore()
         delete mSpellInfoMap[i];
 
     mSpellInfoMap.clear();
+    mSpellInfoHotData.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -5064,3 +5068,47 @@ void SpellMgr::LoadSpellInfoImmunities()
 
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo immunity infos in %u ms", GetMSTimeDiffToNow(oldMSTime));
 }
+
+SpellInfoHotData::SpellInfoHotData(SpellInfo const* spellInfo) : ProcEntry(nullptr), ProcFlags(0),
+    Attributes({ spellInfo->Attributes, spellInfo->AttributesEx, spellInfo->AttributesEx2, spellInfo->AttributesEx3,
+        spellInfo->AttributesEx4, spellInfo->AttributesEx5, spellInfo->AttributesEx6, spellInfo->AttributesEx7 })
+{
+    for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        EffectAuraTypes[i] = spellInfo->Effects[i].IsAura() ? uint16(spellInfo->Effects[i].ApplyAuraName) : 0;
+}
+
+void SpellMgr::LoadSpellInfoHotData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    mSpellInfoHotData.assign(GetSpellInfoStoreSize(), SpellInfoHotData());
+    for (SpellInfo const* spellInfo : mSpellInfoMap)
+    {
+        if (!spellInfo)
+            continue;
+
+        mSpellInfoHotData[spellInfo->Id] = SpellInfoHotData(spellInfo);
+    }
+
+    LinkSpellInfoHotDataProcEntries();
+
+    TC_LOG_INFO("server.loading", ">> Loaded SpellInfo hot data in %u ms", GetMSTimeDiffToNow(oldMSTime));
+}
+
+void SpellMgr::LinkSpellInfoHotDataProcEntries()
+{
+    for (SpellInfoHotData& hotData : mSpellInfoHotData)
+    {
+        hotData.ProcEntry = nullptr;
+        hotData.ProcFlags = 0;
+    }
+
+    for (SpellProcMap::value_type const& procEntry : mSpellProcMap)
+    {
+        if (procEntry.first >= mSpellInfoHotData.size())
+            continue;
+
+        mSpellInfoHotData[procEntry.first].ProcEntry = &procEntry.second;
+        mSpellInfoHotData[procEntry.first].ProcFlags = procEntry.second.ProcFlags;
+    }
+}
@@ -26,6 +26,7 @@
 #include "SharedDefines.h"
 #include "Util.h"
 
+#include <array>
 #include <map>
 #include <set>
 #include <vector>
@@ -37,6 +38,7 @@ class Player;
 class ProcEventInfo;
 class WorldObject;
 struct SkillLineAbilityEntry;
+enum AuraType : uint32;
 
 // only used in code
 enum SpellCategories
@@ -553,6 +555,40 @@ typedef std::vector<bool> EnchantCustomAttribute;
 
 typedef std::vector<SpellInfo*> SpellInfoMap;
 
+// Copy of the SpellInfo fields read on every proc check, one cache line per spell id
+// so checks against many spells (e.g. all auras of a unit) do not pull whole SpellInfo objects into cache
+struct alignas(64) SpellInfoHotData
+{
+    SpellInfoHotData() : ProcEntry(nullptr), ProcFlags(0), Attributes(), EffectAuraTypes() { }
+    explicit SpellInfoHotData(SpellInfo const* spellInfo);
+
+    SpellProcEntry const* ProcEntry;
+    uint32 ProcFlags;                                       // of ProcEntry, 0 if the spell cannot proc
+    std::array<uint32, 8> Attributes;                       // Attributes to AttributesEx7
+    std::array<uint16, MAX_SPELL_EFFECTS> EffectAuraTypes;  // 0 for effects that do not apply an aura
+
+    bool HasAttribute(SpellAttr0 attribute) const { return !!(Attributes[0] & attribute); }
+    bool HasAttribute(SpellAttr1 attribute) const { return !!(Attributes[1] & attribute); }
+    bool HasAttribute(SpellAttr2 attribute) const { return !!(Attributes[2] & attribute); }
+    bool HasAttribute(SpellAttr3 attribute) const { return !!(Attributes[3] & attribute); }
+    bool HasAttribute(SpellAttr4 attribute) const { return !!(Attributes[4] & attribute); }
+    bool HasAttribute(SpellAttr5 attribute) const { return !!(Attributes[5] & attribute); }
+    bool HasAttribute(SpellAttr6 attribute) const { return !!(Attributes[6] & attribute); }
+    bool HasAttribute(SpellAttr7 attribute) const { return !!(Attributes[7] & attribute); }
+
+    bool HasAura(AuraType aura) const
+    {
+        for (uint16 auraType : EffectAuraTypes)
+            if (auraType && auraType == aura)
+                return true;
+        return false;
+    }
+};
+
+static_assert(sizeof(SpellInfoHotData) == 64, "SpellInfoHotData must fit one cache line");
+
+typedef std::vector<SpellInfoHotData> SpellInfoHotDataStore;
+
 typedef std::unordered_map<int32, std::vector<int32>> SpellLinkedMap;
 
 bool IsPrimaryProfessionSkill(uint32 skill);
@@ -666,6 +702,7 @@ class TC_GAME_API SpellMgr
             return spellInfo;
         }
         uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
+        SpellInfoHotData const* GetSpellInfoHotData(uint32 spellId) const { return spellId < mSpellInfoHotData.size() ? &mSpellInfoHotData[spellId] : nullptr; }
 
     private:
         SpellInfo* _GetSpellInfo(uint32 spellId) { return spellId < GetSpellInfoStoreSize() ?  mSpellInfoMap[spellId] : nullptr; }
@@ -702,8 +739,11 @@ class TC_GAME_API SpellMgr
         void LoadSpellInfoSpellSpecificAndAuraState();
         void LoadSpellInfoDiminishing();
         void LoadSpellInfoImmunities();
+        void LoadSpellInfoHotData();
 
     private:
+        void LinkSpellInfoHotDataProcEntries();
+
         SpellDifficultySearcherMap mSpellDifficultySearcherMap;
         SpellChainMap              mSpellChains;
         SpellsRequiringSpellMap    mSpellsReqSpell;
@@ -731,6 +771,7 @@ class TC_GAME_API SpellMgr
         PetLevelupSpellMap         mPetLevelupSpellMap;
         PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
         SpellInfoMap               mSpellInfoMap;
+        SpellInfoHotDataStore      mSpellInfoHotData;
 
     friend class UnitTestDataLoader;
 };
@@ -42,6 +42,7 @@
 #include "DatabaseEnv.h"
 #include "DisableMgr.h"
 #include "GameEventMgr.h"
+#include "GameObject.h"
 #include "GameObjectModel.h"
 #include "GameTime.h"
 #include "GitRevision.h"
@@ -75,8 +76,10 @@
 #include "ServerMotd.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
+#include "SlabPool.h"
 #include "SmartScriptMgr.h"
 #include "SpellMgr.h"
+#include "TemporarySummon.h"
 #include "TicketMgr.h"
 #include "TransportMgr.h"
 #include "Unit.h"
@@ -106,6 +109,42 @@ TC_GAME_API int32 World::m_visibility_notify_periodInInstances  = DEFAULT_VISIBI
 TC_GAME_API int32 World::m_visibility_notify_periodInBG         = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 TC_GAME_API int32 World::m_visibility_notify_periodInArenas     = DEFAULT_VISIBILITY_NOTIFY_PERIOD;
 
+template<class T>
+static void UpdateDatabasePool(DatabaseWorkerPool<T>& pool)
+{
+    pool.UpdateAutoScaling();
+
+    std::string const& database = pool.GetConnectionInfo()->database;
+    TC_METRIC_VALUE("db_async_connections", uint64(pool.GetAsyncConnectionCount()), TC_METRIC_TAG("db", database));
+
+    for (SQLOperationPriority priority : { SQL_PRIORITY_NORMAL, SQL_PRIORITY_INTERACTIVE })
+    {
+        // always consumed so the stats only cover one update interval
+        SQLOperationQueueStats stats = pool.ConsumeQueueStats(priority);
+        if (!sMetric->IsEnabled())
+            continue;
+
+        std::string lane = priority == SQL_PRIORITY_INTERACTIVE ? "interactive" : "normal";
+        TC_METRIC_VALUE("db_queue_depth", uint64(stats.Depth), TC_METRIC_TAG("db", database), TC_METRIC_TAG("lane", lane));
+        TC_METRIC_VALUE("db_queue_max_wait_time", stats.MaxWaitTime, TC_METRIC_TAG("db", database), TC_METRIC_TAG("lane", lane));
+        if (stats.Executed)
+            TC_METRIC_VALUE("db_queue_wait_time", stats.TotalWaitTime / stats.Executed, TC_METRIC_TAG("db", database), TC_METRIC_TAG("lane", lane));
+    }
+}
+
+static void UpdateAllocationPoolMetrics(Trinity::SlabPool const& pool)
+{
+    if (!sMetric->IsEnabled())
+        return;
+
+    Trinity::SlabPool::Stats stats = pool.GetStats();
+    TC_METRIC_VALUE("allocation_pool_objects", uint64(stats.Live), TC_METRIC_TAG("pool", pool.GetName()));
+    TC_METRIC_VALUE("allocation_pool_capacity", uint64(stats.Capacity), TC_METRIC_TAG("pool", pool.GetName()));
+    TC_METRIC_VALUE("allocation_pool_fragmented", uint64(stats.FreeInUsedSlabs), TC_METRIC_TAG("pool", pool.GetName()));
+    TC_METRIC_VALUE("allocation_pool_bytes", uint64(stats.ReservedBytes), TC_METRIC_TAG("pool", pool.GetName()));
+    TC_METRIC_VALUE("allocation_pool_allocations", stats.Allocations, TC_METRIC_TAG("pool", pool.GetName()));
+}
+
 /// World constructor
 World::World()
 {
@@ -150,6 +189,8 @@ World::World()
 /// World destructor
 World::~World()
 {
+    _sessionUpdateThreads.Stop();
+
     ///- Empty the kicked session set
     while (!m_sessions.empty())
     {
@@ -726,6 +767,8 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetMapUpdateInterval(m_int_configs[CONFIG_INTERVAL_MAPUPDATE]);
 
+    m_int_configs[CONFIG_DEFERRED_UPDATE_BUDGET] = sConfigMgr->GetIntDefault("DeferredUpdateBudget", 5);
+
     m_int_configs[CONFIG_INTERVAL_CHANGEWEATHER] = sConfigMgr->GetIntDefault("ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (reload)
@@ -1207,6 +1250,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_ARENA_RATING_DISCARD_TIMER]                 = sConfigMgr->GetIntDefault ("Arena.RatingDiscardTimer", 10 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER]         = sConfigMgr->GetIntDefault ("Arena.PreviousOpponentsDiscardTimer", 2 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_ARENA_RATED_UPDATE_TIMER]                   = sConfigMgr->GetIntDefault ("Arena.RatedUpdateTimer", 5 * IN_MILLISECONDS);
+    m_int_configs[CONFIG_BATTLEGROUND_QUEUE_UPDATE_THREADS]          = sConfigMgr->GetIntDefault ("Battleground.QueueUpdateThreads", 0);
     m_bool_configs[CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS]              = sConfigMgr->GetBoolDefault("Arena.AutoDistributePoints", false);
     m_int_configs[CONFIG_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS]        = sConfigMgr->GetIntDefault ("Arena.AutoDistributeInterval", 7);
     m_bool_configs[CONFIG_ARENA_QUEUE_ANNOUNCER_ENABLE]              = sConfigMgr->GetBoolDefault("Arena.QueueAnnouncer.Enable", false);
@@ -1327,6 +1371,7 @@ void World::LoadConfigSettings(bool reload)
 
     // Respawn Settings
     m_int_configs[CONFIG_RESPAWN_MINCHECKINTERVALMS] = sConfigMgr->GetIntDefault("Respawn.MinCheckIntervalMS", 5000);
+    m_int_configs[CONFIG_RESPAWN_WRITEBEHINDINTERVAL] = sConfigMgr->GetIntDefault("Respawn.WriteBehindInterval", 10000);
     m_int_configs[CONFIG_RESPAWN_DYNAMICMODE] = sConfigMgr->GetIntDefault("Respawn.DynamicMode", 0);
     if (m_int_configs[CONFIG_RESPAWN_DYNAMICMODE] > 1)
     {
@@ -1431,6 +1476,13 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+
+    // Background loading of grid terrain in the direction players are moving
+    m_int_configs[CONFIG_MAP_ASYNC_GRID_LOAD_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.AsyncGridLoad.Threads", 0);
+    m_float_configs[CONFIG_MAP_ASYNC_GRID_LOAD_LOOKAHEAD] = sConfigMgr->GetFloatDefault("MapUpdate.AsyncGridLoad.LookAhead", SIZE_OF_GRIDS);
+
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = sConfigMgr->GetIntDefault("SessionUpdate.Threads", 0);
+
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1539,6 +1591,12 @@ void World::LoadConfigSettings(bool reload)
     // Whether to use LoS from game objects
     m_bool_configs[CONFIG_CHECK_GOBJECT_LOS] = sConfigMgr->GetBoolDefault("CheckGameObjectLoS", true);
 
+    // Whether maps remember line of sight and vmap height results during an update
+    m_bool_configs[CONFIG_MAP_QUERY_CACHE] = sConfigMgr->GetBoolDefault("Map.QueryCache.Enable", false);
+
+    // Whether float height data of map files is stored as 16 bit heights
+    m_bool_configs[CONFIG_MAP_COMPACT_HEIGHTS] = sConfigMgr->GetBoolDefault("Map.CompactHeights", false);
+
     // call ScriptMgr if we're reloading the configuration
     if (reload)
         sScriptMgr->OnConfigLoad(reload);
@@ -1735,6 +1793,9 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Spell Proc conditions and data...");
     sSpellMgr->LoadSpellProcs();
 
+    TC_LOG_INFO("server.loading", "Loading SpellInfo hot data...");
+    sSpellMgr->LoadSpellInfoHotData();                           // must be after LoadSpellProcs
+
     TC_LOG_INFO("server.loading", "Loading Spell Bonus Data...");
     sSpellMgr->LoadSpellBonuses();
 
@@ -2123,12 +2184,21 @@ void World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_PINGDB].SetInterval(getIntConfig(CONFIG_DB_PING_INTERVAL)*MINUTE*IN_MILLISECONDS);    // Mysql ping time in minutes
 
+    m_timers[WUPDATE_DB_AUTOSCALING].SetInterval(IN_MILLISECONDS); // check database queue load every second
+
+    m_timers[WUPDATE_METRIC_SNAPSHOTS].SetInterval(10 * IN_MILLISECONDS);
+
     m_timers[WUPDATE_CHECK_FILECHANGES].SetInterval(500);
 
     m_timers[WUPDATE_WHO_LIST].SetInterval(5 * IN_MILLISECONDS); // update who list cache every 5 seconds
 
     m_timers[WUPDATE_CHANNEL_SAVE].SetInterval(getIntConfig(CONFIG_PRESERVE_CUSTOM_CHANNEL_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
+    InitDeferredUpdates();
+
+    if (uint32 sessionUpdateThreads = getIntConfig(CONFIG_SESSION_UPDATE_THREADS))
+        _sessionUpdateThreads.Start(sessionUpdateThreads);
+
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
     //one second is 1000 -(tested on win system)
@@ -2171,6 +2241,7 @@ void World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Starting Battleground System");
     sBattlegroundMgr->LoadBattlegroundTemplates();
     sBattlegroundMgr->InitAutomaticArenaPointDistribution();
+    sBattlegroundMgr->InitializeQueueUpdateThreads();
 
     ///- Initialize outdoor pvp
     TC_LOG_INFO("server.loading", "Starting Outdoor PvP System");
@@ -2322,12 +2393,14 @@ void World::Update(uint32 diff)
             m_timers[i].SetCurrent(0);
     }
 
-    ///- Update Who List Storage
-    if (m_timers[WUPDATE_WHO_LIST].Passed())
+    ///- Queue deferrable updates, they run at the end of the tick within CONFIG_DEFERRED_UPDATE_BUDGET
+    for (WorldTimers timer : { WUPDATE_WHO_LIST, WUPDATE_AUCTIONS_PENDING, WUPDATE_AHBOT, WUPDATE_UPTIME, WUPDATE_CORPSES, WUPDATE_DELETECHARS })
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update who list"));
-        m_timers[WUPDATE_WHO_LIST].Reset();
-        sWhoListStorageMgr->Update();
+        if (m_timers[timer].Passed())
+        {
+            m_timers[timer].Reset();
+            _updateScheduler.Queue(timer);
+        }
     }
 
     if (IsStopped() || m_timers[WUPDATE_CHANNEL_SAVE].Passed())
@@ -2371,35 +2444,19 @@ void World::Update(uint32 diff)
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update expired auctions"));
         m_timers[WUPDATE_AUCTIONS].Reset();
 
         ///- Update mails (return old mails with item, or delete them)
         //(tested... works on win)
         if (++mail_timer > mail_timer_expires)
         {
+            TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Return old mails"));
             mail_timer = 0;
             sObjectMgr->ReturnOrDeleteOldMails(true);
         }
 
         ///- Handle expired auctions
-        sAuctionMgr->Update();
-    }
-
-    if (m_timers[WUPDATE_AUCTIONS_PENDING].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending auctions"));
-        m_timers[WUPDATE_AUCTIONS_PENDING].Reset();
-
-        sAuctionMgr->UpdatePendingAuctions();
-    }
-
-    /// <li> Handle AHBot operations
-    if (m_timers[WUPDATE_AHBOT].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update AHBot"));
-        sAuctionBot->Update();
-        m_timers[WUPDATE_AHBOT].Reset();
+        _updateScheduler.Queue(WUPDATE_AUCTIONS);
     }
 
     /// <li> Handle file changes
@@ -2416,25 +2473,6 @@ void World::Update(uint32 diff)
         UpdateSessions(diff);
     }
 
-    /// <li> Update uptime table
-    if (m_timers[WUPDATE_UPTIME].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
-        uint32 tmpDiff = GameTime::GetUptime();
-        uint32 maxOnlinePlayers = GetMaxPlayerCount();
-
-        m_timers[WUPDATE_UPTIME].Reset();
-
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
-
-        stmt->setUInt32(0, tmpDiff);
-        stmt->setUInt16(1, uint16(maxOnlinePlayers));
-        stmt->setUInt32(2, realm.Id.Realm);
-        stmt->setUInt32(3, uint32(GameTime::GetStartTime()));
-
-        LoginDatabase.Execute(stmt);
-    }
-
     /// <li> Clean logs table
     if (sWorld->getIntConfig(CONFIG_LOGDB_CLEARTIME) > 0) // if not enabled, ignore the timer
     {
@@ -2485,14 +2523,6 @@ void World::Update(uint32 diff)
         sBattlefieldMgr->Update(diff);
     }
 
-    ///- Delete all characters which have been deleted X days before
-    if (m_timers[WUPDATE_DELETECHARS].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Delete old characters"));
-        m_timers[WUPDATE_DELETECHARS].Reset();
-        Player::DeleteOldCharacters();
-    }
-
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update groups"));
         sGroupMgr->Update(diff);
@@ -2509,17 +2539,6 @@ void World::Update(uint32 diff)
         ProcessQueryCallbacks();
     }
 
-    ///- Erase corpses once every 20 minutes
-    if (m_timers[WUPDATE_CORPSES].Passed())
-    {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Remove old corpses"));
-        m_timers[WUPDATE_CORPSES].Reset();
-        sMapMgr->DoForAllMaps([](Map* map)
-        {
-            map->RemoveOldCorpses();
-        });
-    }
-
     ///- Process Game events when necessary
     if (m_timers[WUPDATE_EVENTS].Passed())
     {
@@ -2541,6 +2560,25 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    ///- Adjust async database connections to queue load
+    if (m_timers[WUPDATE_DB_AUTOSCALING].Passed())
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update MySQL autoscaling"));
+        m_timers[WUPDATE_DB_AUTOSCALING].Reset();
+        UpdateDatabasePool(CharacterDatabase);
+        UpdateDatabasePool(LoginDatabase);
+        UpdateDatabasePool(WorldDatabase);
+    }
+
+    if (m_timers[WUPDATE_METRIC_SNAPSHOTS].Passed())
+    {
+        m_timers[WUPDATE_METRIC_SNAPSHOTS].Reset();
+        UpdateAllocationPoolMetrics(Creature::GetAllocationPool());
+        UpdateAllocationPoolMetrics(TempSummon::GetAllocationPool());
+        UpdateAllocationPoolMetrics(GameObject::GetAllocationPool());
+        LogDeferredUpdateStats();
+    }
+
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update instance reset times"));
         // update the instance reset times
@@ -2557,6 +2595,12 @@ void World::Update(uint32 diff)
             SendGuidWarning();
     }
 
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Deferred updates"));
+        _updateScheduler.SetTickBudget(std::chrono::milliseconds(getIntConfig(CONFIG_DEFERRED_UPDATE_BUDGET)));
+        _updateScheduler.Update();
+    }
+
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Process cli commands"));
         // And last, but not least handle the issued cli commands
@@ -2576,6 +2620,88 @@ void World::Update(uint32 diff)
     }
 }
 
+void World::InitDeferredUpdates()
+{
+    _updateScheduler.AddTask(WUPDATE_WHO_LIST, "Update who list", std::chrono::milliseconds(2), [](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update who list"));
+        sWhoListStorageMgr->Update();
+        return true;
+    });
+
+    _updateScheduler.AddTask(WUPDATE_AUCTIONS, "Update expired auctions", std::chrono::milliseconds(5), [](TimePoint deadline)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update expired auctions"));
+        return sAuctionMgr->Update(deadline);
+    });
+
+    _updateScheduler.AddTask(WUPDATE_AUCTIONS_PENDING, "Update pending auctions", std::chrono::milliseconds(2), [](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending auctions"));
+        sAuctionMgr->UpdatePendingAuctions();
+        return true;
+    });
+
+    _updateScheduler.AddTask(WUPDATE_AHBOT, "Update AHBot", std::chrono::milliseconds(5), [](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update AHBot"));
+        sAuctionBot->Update();
+        return true;
+    });
+
+    _updateScheduler.AddTask(WUPDATE_UPTIME, "Update uptime", std::chrono::milliseconds(1), [this](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update uptime"));
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_UPTIME_PLAYERS);
+        stmt->setUInt32(0, GameTime::GetUptime());
+        stmt->setUInt16(1, uint16(GetMaxPlayerCount()));
+        stmt->setUInt32(2, realm.Id.Realm);
+        stmt->setUInt32(3, uint32(GameTime::GetStartTime()));
+        LoginDatabase.Execute(stmt);
+        return true;
+    });
+
+    _updateScheduler.AddTask(WUPDATE_CORPSES, "Remove old corpses", std::chrono::milliseconds(5), [](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Remove old corpses"));
+        sMapMgr->DoForAllMaps([](Map* map)
+        {
+            map->RemoveOldCorpses();
+        });
+        return true;
+    });
+
+    _updateScheduler.AddTask(WUPDATE_DELETECHARS, "Delete old characters", std::chrono::milliseconds(1), [](TimePoint /*deadline*/)
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Delete old characters"));
+        Player::DeleteOldCharacters();
+        return true;
+    });
+}
+
+void World::LogDeferredUpdateStats()
+{
+    _updateScheduler.ConsumeStats([this](uint32 id, WorldUpdateScheduler::TaskStats const& stats)
+    {
+        if (!sMetric->IsEnabled() || (!stats.Runs && !stats.Deferred))
+            return;
+
+        std::string const& type = _updateScheduler.GetTaskName(id);
+        for (std::size_t i = 0; i < stats.RunTimes.size(); ++i)
+        {
+            if (!stats.RunTimes[i])
+                continue;
+
+            // histogram buckets, le is the upper bound of the run time in microseconds
+            std::string bound = i < WorldUpdateScheduler::HistogramBounds.size() ? std::to_string(WorldUpdateScheduler::HistogramBounds[i]) : "inf";
+            TC_METRIC_VALUE("world_update_task_time", stats.RunTimes[i], TC_METRIC_TAG("type", type), TC_METRIC_TAG("le", bound));
+        }
+
+        TC_METRIC_VALUE("world_update_task_unfinished", stats.Unfinished, TC_METRIC_TAG("type", type));
+        TC_METRIC_VALUE("world_update_task_deferred", stats.Deferred, TC_METRIC_TAG("type", type));
+    });
+}
+
 void World::ForceGameEventUpdate()
 {
     m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
@@ -3094,6 +3220,36 @@ void World::UpdateSessions(uint32 diff)
             AddSession_(sess);
     }
 
+    ///- Handle packets of sessions without a player in world (character select, login queue, loading) that
+    ///  only touch their own session on worker threads, everything else is processed below as before
+    if (_sessionUpdateThreads.IsStarted())
+    {
+        TC_METRIC_DETAILED_NO_THRESHOLD_TIMER("world_update_time",
+            TC_METRIC_TAG("type", "Parallel session packets"),
+            TC_METRIC_TAG("parent_type", "Update sessions"));
+
+        std::vector<WorldSession*> sessions;
+        for (SessionMap::value_type const& pair : m_sessions)
+        {
+            Player* player = pair.second->GetPlayer();
+            if (!player || !player->IsInWorld())
+                sessions.push_back(pair.second);
+        }
+
+        // a few more shards than threads so one busy session does not hold back a whole thread's share
+        std::size_t shardCount = std::min(sessions.size(), _sessionUpdateThreads.GetThreadCount() * 4);
+        for (std::size_t shard = 0; shard < shardCount; ++shard)
+        {
+            _sessionUpdateThreads.PostWork([&sessions, shard, shardCount]()
+            {
+                for (std::size_t i = shard; i < sessions.size(); i += shardCount)
+                    sessions[i]->ProcessParallelPackets();
+            });
+        }
+
+        _sessionUpdateThreads.Wait();
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -28,7 +28,9 @@
 #include "LockedQueue.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include "ThreadPool.h"
 #include "Timer.h"
+#include "WorldUpdateScheduler.h"
 
 #include <atomic>
 #include <list>
@@ -82,6 +84,8 @@ enum WorldTimers
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_WHO_LIST,
     WUPDATE_CHANNEL_SAVE,
+    WUPDATE_DB_AUTOSCALING,
+    WUPDATE_METRIC_SNAPSHOTS,
     WUPDATE_COUNT
 };
 
@@ -176,6 +180,8 @@ enum WorldBoolConfigs
     CONFIG_PREVENT_RENAME_CUSTOMIZATION,
     CONFIG_CACHE_DATA_QUERIES,
     CONFIG_CHECK_GOBJECT_LOS,
+    CONFIG_MAP_QUERY_CACHE,
+    CONFIG_MAP_COMPACT_HEIGHTS,
     CONFIG_RESPAWN_DYNAMIC_ESCORTNPC,
     CONFIG_REGEN_HP_CANNOT_REACH_TARGET_IN_RAID,
     BOOL_CONFIG_VALUE_COUNT
@@ -203,6 +209,7 @@ enum WorldFloatConfigs
     CONFIG_ARENA_MATCHMAKER_RATING_MODIFIER,
     CONFIG_RESPAWN_DYNAMICRATE_CREATURE,
     CONFIG_RESPAWN_DYNAMICRATE_GAMEOBJECT,
+    CONFIG_MAP_ASYNC_GRID_LOAD_LOOKAHEAD,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -212,6 +219,7 @@ enum WorldIntConfigs
     CONFIG_INTERVAL_SAVE,
     CONFIG_INTERVAL_GRIDCLEAN,
     CONFIG_INTERVAL_MAPUPDATE,
+    CONFIG_DEFERRED_UPDATE_BUDGET,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
     CONFIG_PORT_WORLD,
@@ -315,6 +323,7 @@ enum WorldIntConfigs
     CONFIG_ARENA_RATING_DISCARD_TIMER,
     CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER,
     CONFIG_ARENA_RATED_UPDATE_TIMER,
+    CONFIG_BATTLEGROUND_QUEUE_UPDATE_THREADS,
     CONFIG_ARENA_AUTO_DISTRIBUTE_INTERVAL_DAYS,
     CONFIG_ARENA_SEASON_ID,
     CONFIG_ARENA_START_RATING,
@@ -328,6 +337,8 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_ASYNC_GRID_LOAD_THREADS,
+    CONFIG_SESSION_UPDATE_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -388,6 +399,7 @@ enum WorldIntConfigs
     CONFIG_AUCTION_SEARCH_DELAY,
     CONFIG_TALENTS_INSPECTING,
     CONFIG_RESPAWN_MINCHECKINTERVALMS,
+    CONFIG_RESPAWN_WRITEBEHINDINTERVAL,
     CONFIG_RESPAWN_DYNAMICMODE,
     CONFIG_RESPAWN_GUIDWARNLEVEL,
     CONFIG_RESPAWN_GUIDALERTLEVEL,
@@ -786,6 +798,9 @@ class TC_GAME_API World
         void ResetRandomBG();
         void CalendarDeleteOldEvents();
         void ResetGuildCap();
+
+        void InitDeferredUpdates();
+        void LogDeferredUpdateStats();
     private:
         World();
         ~World();
@@ -800,10 +815,12 @@ class TC_GAME_API World
         bool m_isClosed;
 
         IntervalTimer m_timers[WUPDATE_COUNT];
+        WorldUpdateScheduler _updateScheduler;
         time_t mail_timer;
         time_t mail_timer_expires;
 
         SessionMap m_sessions;
+        Trinity::ThreadPool _sessionUpdateThreads;
         typedef std::unordered_map<uint32, time_t> DisconnectMap;
         DisconnectMap m_disconnects;
         uint32 m_maxActiveSessionCount;
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldUpdateScheduler.h"
+#include "Errors.h"
+#include <algorithm>
+
+void WorldUpdateScheduler::AddTask(uint32 id, std::string name, std::chrono::microseconds budget, TaskFunction function)
+{
+    Task& task = _tasks[id];
+    ASSERT(!task.Function, "World update task %u added twice", id);
+    task.Name = std::move(name);
+    task.Budget = budget;
+    task.Function = std::move(function);
+}
+
+void WorldUpdateScheduler::Queue(uint32 id)
+{
+    Task& task = _tasks.at(id);
+    if (task.Queued)
+        return;
+
+    task.Queued = true;
+    _queue.push_back(id);
+}
+
+bool WorldUpdateScheduler::IsQueued(uint32 id) const
+{
+    auto itr = _tasks.find(id);
+    return itr != _tasks.end() && itr->second.Queued;
+}
+
+void WorldUpdateScheduler::Update()
+{
+    bool limited = _tickBudget > std::chrono::microseconds::zero();
+    TimePoint tickEnd = std::chrono::steady_clock::now() + _tickBudget;
+
+    // tasks queued again during this update wait for the next one
+    std::size_t count = _queue.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        uint32 id = _queue.front();
+        Task& task = _tasks.at(id);
+
+        TimePoint now = std::chrono::steady_clock::now();
+        if (limited && i > 0 && now >= tickEnd)
+        {
+            // budget used up, everything left keeps its place in the queue
+            for (std::size_t j = 0; j < count - i; ++j)
+                ++_tasks.at(_queue[j]).Stats.Deferred;
+            return;
+        }
+
+        _queue.pop_front();
+        task.Queued = false;
+
+        TimePoint deadline = now + task.Budget;
+        if (limited && i > 0)
+            deadline = std::min(deadline, tickEnd);
+
+        bool done = task.Function(deadline);
+
+        std::chrono::microseconds runTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - now);
+        ++task.Stats.Runs;
+        ++task.Stats.RunTimes[GetHistogramBucket(runTime)];
+
+        if (!done)
+        {
+            ++task.Stats.Unfinished;
+            Queue(id);
+        }
+    }
+}
+
+std::size_t WorldUpdateScheduler::GetHistogramBucket(std::chrono::microseconds runTime)
+{
+    return std::lower_bound(HistogramBounds.begin(), HistogramBounds.end(), runTime.count()) - HistogramBounds.begin();
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WorldUpdateScheduler_h__
+#define WorldUpdateScheduler_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+/*
+ * Runs deferrable world update tasks (auction expiration, who list rebuilds, database housekeeping...)
+ * within a shared time budget per world tick.
+ * Queued tasks run in queue order until the tick budget is used up, the rest waits for the next tick.
+ * Every task gets its own budget as deadline and may stop early by returning false, it is then queued
+ * again behind the other tasks and continues in a later tick. The first queued task always runs so
+ * a long running task can delay the others but never starve them.
+ */
+class TC_GAME_API WorldUpdateScheduler
+{
+    public:
+        // returns true when all work is done, false to continue in a later tick
+        using TaskFunction = std::function<bool(TimePoint deadline)>;
+
+        // upper bounds of the run time histogram buckets, the last bucket takes everything above
+        static constexpr std::array<std::chrono::microseconds::rep, 8> HistogramBounds = { 100, 250, 500, 1000, 2500, 5000, 10000, 25000 };
+
+        struct TaskStats
+        {
+            std::array<uint32, HistogramBounds.size() + 1> RunTimes = { };
+            uint32 Runs = 0;
+            uint32 Unfinished = 0; // runs that returned false
+            uint32 Deferred = 0;   // ticks the task was queued but did not run because the tick budget was used up
+        };
+
+        WorldUpdateScheduler() : _tickBudget(std::chrono::microseconds::zero()) { }
+
+        void AddTask(uint32 id, std::string name, std::chrono::microseconds budget, TaskFunction function);
+
+        // no effect if the task is already queued
+        void Queue(uint32 id);
+        bool IsQueued(uint32 id) const;
+
+        // zero runs every queued task each tick
+        void SetTickBudget(std::chrono::microseconds budget) { _tickBudget = budget; }
+        void Update();
+
+        std::string const& GetTaskName(uint32 id) const { return _tasks.at(id).Name; }
+
+        // calls the function with id and stats of every task and resets the stats
+        template<typename Func>
+        void ConsumeStats(Func&& func)
+        {
+            for (auto& pair : _tasks)
+            {
+                func(pair.first, static_cast<TaskStats const&>(pair.second.Stats));
+                pair.second.Stats = TaskStats();
+            }
+        }
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            std::chrono::microseconds Budget;
+            TaskFunction Function;
+            bool Queued = false;
+            TaskStats Stats;
+        };
+
+        static std::size_t GetHistogramBucket(std::chrono::microseconds runTime);
+
+        std::unordered_map<uint32, Task> _tasks;
+        std::deque<uint32> _queue;
+        std::chrono::microseconds _tickBudget;
+};
+
+#endif // WorldUpdateScheduler_h__
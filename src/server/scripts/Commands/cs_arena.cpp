@@ -195,7 +195,7 @@ public:
         }
 
         CharacterCacheEntry const* oldCaptainNameData = sCharacterCache->GetCharacterCacheByGuid(arena->GetCaptain());
-        char const* oldCaptainName = oldCaptainNameData ? oldCaptainNameData->Name.c_str() : "<unknown>";
+        char const* oldCaptainName = oldCaptainNameData ? oldCaptainNameData->Name.data() : "<unknown>";
 
         arena->SetCaptain(target->GetGUID());
         handler->PSendSysMessage(LANG_ARENA_CAPTAIN, arena->GetName().c_str(), arena->GetId(), oldCaptainName, target->GetName().c_str());
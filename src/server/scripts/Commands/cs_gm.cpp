@@ -117,7 +117,7 @@ public:
         bool first = true;
         bool footer = false;
 
-        std::shared_lock<std::shared_mutex> lock(*HashMapHolder<Player>::GetLock());
+        std::shared_lock<HashMapHolder<Player>::LockType> lock(*HashMapHolder<Player>::GetLock());
         for (auto const [playerGuid, player] : ObjectAccessor::GetPlayers())
         {
             AccountTypes playerSec = player->GetSession()->GetSecurity();
@@ -254,7 +254,8 @@ extern int main(int argc, char** argv)
 
     std::shared_ptr<void> mapManagementHandle(nullptr, [](void*)
     {
-        // unload battleground templates before different singletons destroyed
+        // join matchmaking workers and unload battleground templates before different singletons destroyed
+        sBattlegroundMgr->StopQueueUpdateThreads();
         sBattlegroundMgr->DeleteAllBattlegrounds();
 
         sInstanceSaveMgr->Unload();
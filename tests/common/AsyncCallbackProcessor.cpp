@@ -0,0 +1,182 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AsyncCallbackProcessor.h"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestCallback
+    {
+        explicit TestCallback(AsyncFuture<int>&& future) : Future(std::move(future)) { }
+
+        bool InvokeIfReady()
+        {
+            if (!Future.IsReady())
+                return false;
+
+            AsyncFuture<int> ready(std::move(Future));
+            std::function<void(TestCallback&, int)> callback(std::move(Callback));
+            callback(*this, ready.Get());
+            // chain aborted when callback did not set next future
+            return !Future.Valid();
+        }
+
+        void NotifyOnReady(std::shared_ptr<AsyncCompletionQueue> queue, uint64 token)
+        {
+            if (Future.Valid())
+                Future.NotifyOnReady(std::move(queue), token);
+        }
+
+        AsyncFuture<int> Future;
+        std::function<void(TestCallback&, int)> Callback;
+    };
+}
+
+TEST_CASE("Async callbacks run once their result is set", "[AsyncCallbackProcessor]")
+{
+    AsyncCallbackProcessor<TestCallback> processor;
+    std::vector<int> results;
+
+    AsyncPromise<int> first;
+    AsyncPromise<int> second;
+    processor.AddCallback(TestCallback(first.GetFuture())).Callback = [&](TestCallback&, int value) { results.push_back(value); };
+    processor.AddCallback(TestCallback(second.GetFuture())).Callback = [&](TestCallback&, int value) { results.push_back(value); };
+
+    processor.ProcessReadyCallbacks();
+    REQUIRE(results.empty());
+    REQUIRE(processor.GetPendingCallbackCount() == 2);
+
+    second.SetValue(2);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(results == std::vector<int>{ 2 });
+    REQUIRE(processor.GetPendingCallbackCount() == 1);
+
+    first.SetValue(1);
+    processor.ProcessReadyCallbacks();
+    processor.ProcessReadyCallbacks();
+    REQUIRE(results == std::vector<int>{ 2, 1 });
+    REQUIRE(processor.GetPendingCallbackCount() == 0);
+}
+
+TEST_CASE("Async callback with result set before it was added", "[AsyncCallbackProcessor]")
+{
+    AsyncCallbackProcessor<TestCallback> processor;
+    AsyncPromise<int> promise;
+    AsyncFuture<int> future = promise.GetFuture();
+    promise.SetValue(7);
+
+    int result = 0;
+    processor.AddCallback(TestCallback(std::move(future))).Callback = [&](TestCallback&, int value) { result = value; };
+    processor.ProcessReadyCallbacks();
+    REQUIRE(result == 7);
+    REQUIRE(processor.GetPendingCallbackCount() == 0);
+}
+
+TEST_CASE("Chained async callbacks", "[AsyncCallbackProcessor]")
+{
+    AsyncCallbackProcessor<TestCallback> processor;
+    AsyncPromise<int> first;
+    AsyncPromise<int> second;
+    std::vector<int> results;
+
+    processor.AddCallback(TestCallback(first.GetFuture())).Callback = [&](TestCallback& callback, int value)
+    {
+        results.push_back(value);
+        callback.Future = second.GetFuture();
+        callback.Callback = [&](TestCallback&, int next) { results.push_back(next); };
+    };
+
+    first.SetValue(1);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(results == std::vector<int>{ 1 });
+    REQUIRE(processor.GetPendingCallbackCount() == 1);
+
+    second.SetValue(2);
+    processor.ProcessReadyCallbacks();
+    REQUIRE(results == std::vector<int>{ 1, 2 });
+    REQUIRE(processor.GetPendingCallbackCount() == 0);
+}
+
+TEST_CASE("Async callbacks added from a running callback", "[AsyncCallbackProcessor]")
+{
+    AsyncCallbackProcessor<TestCallback> processor;
+    std::vector<std::unique_ptr<AsyncPromise<int>>> promises;
+    uint32 invoked = 0;
+
+    std::function<void(TestCallback&, int)> spawn = [&](TestCallback&, int value)
+    {
+        ++invoked;
+        if (value == 0)
+            return;
+
+        // enough insertions to force the callback storage to rehash while this callback runs
+        for (int i = 0; i < 64; ++i)
+        {
+            promises.push_back(std::make_unique<AsyncPromise<int>>());
+            processor.AddCallback(TestCallback(promises.back()->GetFuture())).Callback = spawn;
+            promises.back()->SetValue(value - 1);
+        }
+    };
+
+    AsyncPromise<int> root;
+    processor.AddCallback(TestCallback(root.GetFuture())).Callback = spawn;
+    root.SetValue(1);
+
+    processor.ProcessReadyCallbacks();
+    processor.ProcessReadyCallbacks();
+    REQUIRE(invoked == 65);
+    REQUIRE(processor.GetPendingCallbackCount() == 0);
+}
+
+TEST_CASE("Async results completed from other threads", "[AsyncCallbackProcessor]")
+{
+    constexpr uint32 ThreadCount = 4;
+    constexpr uint32 ResultsPerThread = 2000;
+
+    AsyncCallbackProcessor<TestCallback> processor;
+    std::vector<std::unique_ptr<AsyncPromise<int>>> promises;
+    uint64 sum = 0;
+    for (uint32 i = 0; i < ThreadCount * ResultsPerThread; ++i)
+    {
+        promises.push_back(std::make_unique<AsyncPromise<int>>());
+        processor.AddCallback(TestCallback(promises.back()->GetFuture())).Callback = [&](TestCallback&, int value) { sum += value; };
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (uint32 i = 0; i < ResultsPerThread; ++i)
+                promises[t * ResultsPerThread + i]->SetValue(1);
+        });
+    }
+
+    while (processor.GetPendingCallbackCount())
+        processor.ProcessReadyCallbacks();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    REQUIRE(sum == ThreadCount * ResultsPerThread);
+}
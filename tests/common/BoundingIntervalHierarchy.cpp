@@ -0,0 +1,123 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchy.h"
+#include <utility>
+#include <vector>
+
+namespace
+{
+    void GetBoxBounds(G3D::AABox const& box, G3D::AABox& out) { out = box; }
+
+    struct BoxRayCallback
+    {
+        BoxRayCallback(std::vector<G3D::AABox> const& boxes) : Boxes(boxes) { }
+
+        bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirstHit*/) const
+        {
+            float time = ray.intersectionTime(Boxes[entry]);
+            if (time == G3D::finf() || time > distance)
+                return false;
+
+            distance = time;
+            return true;
+        }
+
+        std::vector<G3D::AABox> const& Boxes;
+    };
+
+    // 10x10 pillars of 2x2x10 yards, 10 yards apart starting at the origin
+    struct PillarScene
+    {
+        PillarScene()
+        {
+            for (uint32 x = 0; x < 10; ++x)
+                for (uint32 y = 0; y < 10; ++y)
+                    Boxes.emplace_back(G3D::Vector3(x * 10.0f, y * 10.0f, 0.0f), G3D::Vector3(x * 10.0f + 2.0f, y * 10.0f + 2.0f, 10.0f));
+
+            Tree.build(Boxes, GetBoxBounds);
+        }
+
+        G3D::Ray MakeRay(G3D::Vector3 const& start, G3D::Vector3 const& end, float& maxDist) const
+        {
+            maxDist = (end - start).magnitude();
+            return G3D::Ray::fromOriginAndDirection(start, (end - start) / maxDist);
+        }
+
+        bool IsHit(G3D::Vector3 const& start, G3D::Vector3 const& end) const
+        {
+            float maxDist;
+            G3D::Ray ray = MakeRay(start, end, maxDist);
+            BoxRayCallback callback(Boxes);
+            float distance = maxDist;
+            Tree.intersectRay(ray, callback, distance, true);
+            return distance < maxDist;
+        }
+
+        uint32 GetHits(std::vector<std::pair<G3D::Vector3, G3D::Vector3>> const& segments) const
+        {
+            G3D::Ray rays[BIH::RAY_PACKET_SIZE];
+            float maxDists[BIH::RAY_PACKET_SIZE];
+            for (uint32 i = 0; i < segments.size(); ++i)
+                rays[i] = MakeRay(segments[i].first, segments[i].second, maxDists[i]);
+
+            BoxRayCallback callback(Boxes);
+            return Tree.intersectRayPacket(rays, maxDists, uint32(segments.size()), callback);
+        }
+
+        std::vector<G3D::AABox> Boxes;
+        BIH Tree;
+    };
+}
+
+TEST_CASE("BIH ray packets", "[BIH]")
+{
+    PillarScene scene;
+
+    std::vector<std::pair<G3D::Vector3, G3D::Vector3>> segments =
+    {
+        { { -5.0f, 5.0f, 5.0f }, { 105.0f, 5.0f, 5.0f } },      // between two rows of pillars
+        { { -5.0f, 1.0f, 5.0f }, { 105.0f, 1.0f, 5.0f } },      // through a row of pillars
+        { { -5.0f, 1.0f, 15.0f }, { 105.0f, 1.0f, 15.0f } },    // above a row of pillars
+        { { 1.0f, 1.0f, 20.0f }, { 1.0f, 1.0f, -5.0f } },       // straight down onto a pillar
+        { { 5.0f, 5.0f, 20.0f }, { 5.0f, 5.0f, -5.0f } },       // straight down between pillars
+        { { 5.0f, 5.0f, 5.0f }, { 25.0f, 25.0f, 5.0f } },       // diagonal through a pillar
+        { { 4.0f, 1.0f, 5.0f }, { 9.0f, 1.0f, 5.0f } },         // ends in front of a pillar
+        { { 13.0f, 1.0f, 5.0f }, { 19.0f, 1.0f, 5.0f } }        // starts and ends between two pillars
+    };
+    REQUIRE(segments.size() == BIH::RAY_PACKET_SIZE);
+
+    SECTION("Rays stop at their first hit within their distance")
+    {
+        REQUIRE(scene.GetHits(segments) == 0b00101010);
+    }
+
+    SECTION("Packets hit the same as single rays")
+    {
+        uint32 hits = scene.GetHits(segments);
+        for (uint32 i = 0; i < segments.size(); ++i)
+            REQUIRE(((hits & (1 << i)) != 0) == scene.IsHit(segments[i].first, segments[i].second));
+    }
+
+    SECTION("Partial packets")
+    {
+        segments.resize(3);
+        REQUIRE(scene.GetHits(segments) == 0b010);
+    }
+}
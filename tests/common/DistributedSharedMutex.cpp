@@ -0,0 +1,158 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DistributedSharedMutex.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // lookups from all threads into a map of online players, like ObjectAccessor::FindPlayer
+    template<typename Mutex>
+    uint64 ConcurrentLookups(std::unordered_map<uint64, uint64> const& players, Mutex& mutex, uint32 threadCount, uint32 lookupsPerThread)
+    {
+        std::atomic<uint64> found(0);
+        std::vector<std::thread> threads;
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]()
+            {
+                uint64 localFound = 0;
+                for (uint32 i = 0; i < lookupsPerThread; ++i)
+                {
+                    std::shared_lock<Mutex> lock(mutex);
+                    auto itr = players.find((i * 7 + t) % (players.size() * 2));
+                    if (itr != players.end())
+                        localFound += itr->second;
+                }
+
+                found += localFound;
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return found;
+    }
+}
+
+TEST_CASE("Exclusive ownership excludes shared owners", "[DistributedSharedMutex]")
+{
+    Trinity::DistributedSharedMutex mutex;
+
+    {
+        std::shared_lock<Trinity::DistributedSharedMutex> first(mutex);
+
+        // second shared owner on another thread and therefore another slot
+        bool sharedLocked = false;
+        std::thread([&]()
+        {
+            sharedLocked = mutex.try_lock_shared();
+            if (sharedLocked)
+                mutex.unlock_shared();
+        }).join();
+        REQUIRE(sharedLocked);
+
+        bool locked = true;
+        std::thread([&]() { locked = mutex.try_lock(); }).join();
+        REQUIRE(!locked);
+    }
+
+    std::unique_lock<Trinity::DistributedSharedMutex> exclusive(mutex, std::try_to_lock);
+    REQUIRE(exclusive.owns_lock());
+
+    bool sharedLocked = true;
+    std::thread([&]() { sharedLocked = mutex.try_lock_shared(); }).join();
+    REQUIRE(!sharedLocked);
+}
+
+TEST_CASE("Readers see consistent data while a writer modifies it", "[DistributedSharedMutex]")
+{
+    constexpr uint32 ReaderCount = 6;
+
+    Trinity::DistributedSharedMutex mutex;
+    std::unordered_map<uint64, uint64> players;
+    std::atomic<bool> stop(false);
+    std::atomic<uint32> inconsistent(0);
+
+    std::vector<std::thread> readers;
+    for (uint32 t = 0; t < ReaderCount; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                std::shared_lock<Trinity::DistributedSharedMutex> lock(mutex);
+                // writer always inserts and removes pairs of keys
+                if (players.size() % 2)
+                    ++inconsistent;
+                for (auto const& [key, value] : players)
+                    if (key != value)
+                        ++inconsistent;
+            }
+        });
+    }
+
+    for (uint64 i = 0; i < 2000; ++i)
+    {
+        std::unique_lock<Trinity::DistributedSharedMutex> lock(mutex);
+        if (i % 3 == 2)
+            players.clear();
+        else
+        {
+            players[i * 2] = i * 2;
+            players[i * 2 + 1] = i * 2 + 1;
+        }
+    }
+
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    REQUIRE(inconsistent == 0);
+}
+
+TEST_CASE("Player lookup contention benchmark", "[!benchmark][DistributedSharedMutex]")
+{
+    constexpr uint32 LookupsPerThread = 100000;
+
+    std::unordered_map<uint64, uint64> players;
+    for (uint64 i = 0; i < 5000; ++i)
+        players[i] = i;
+
+    std::shared_mutex sharedMutex;
+    Trinity::DistributedSharedMutex distributedMutex;
+
+    for (uint32 threadCount : { 1, 4, 8 })
+    {
+        BENCHMARK("std::shared_mutex, " + std::to_string(threadCount) + " readers")
+        {
+            return ConcurrentLookups(players, sharedMutex, threadCount, LookupsPerThread);
+        };
+
+        BENCHMARK("DistributedSharedMutex, " + std::to_string(threadCount) + " readers")
+        {
+            return ConcurrentLookups(players, distributedMutex, threadCount, LookupsPerThread);
+        };
+    }
+}
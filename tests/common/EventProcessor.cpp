@@ -0,0 +1,151 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "EventProcessor.h"
+#include <vector>
+
+namespace
+{
+    class RecordingEvent : public BasicEvent
+    {
+    public:
+        RecordingEvent(std::vector<uint32>& executed, uint32 id) : _executed(executed), _id(id) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            _executed.push_back(_id);
+            return true;
+        }
+
+    private:
+        std::vector<uint32>& _executed;
+        uint32 _id;
+    };
+
+    class CountingEvent : public BasicEvent
+    {
+    public:
+        explicit CountingEvent(uint32& counter) : _counter(counter) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            ++_counter;
+            return true;
+        }
+
+    private:
+        uint32& _counter;
+    };
+}
+
+TEST_CASE("Events execute in time order", "[EventProcessor]")
+{
+    EventProcessor events;
+    std::vector<uint32> executed;
+
+    events.AddEventAtOffset(new RecordingEvent(executed, 3), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 1), 100ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2), 200ms);
+
+    events.Update(150);
+    REQUIRE(executed == std::vector<uint32>{ 1 });
+
+    events.Update(1000);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2, 3 });
+}
+
+TEST_CASE("Events with the same time execute in insertion order", "[EventProcessor]")
+{
+    EventProcessor events;
+    std::vector<uint32> executed;
+
+    // spread across levels of the wheel so some of them are cascaded before firing
+    events.AddEventAtOffset(new RecordingEvent(executed, 1), 5s);
+    events.Update(4990);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2), 10ms);
+    events.AddEventAtOffset(new RecordingEvent(executed, 3), 10ms);
+    events.Update(10);
+
+    REQUIRE(executed == std::vector<uint32>{ 1, 2, 3 });
+}
+
+TEST_CASE("Events added while executing that are already due run in the same update", "[EventProcessor]")
+{
+    EventProcessor events;
+    std::vector<uint32> executed;
+
+    events.AddEventAtOffset(new RecordingEvent(executed, 3), 80ms);
+    events.AddEventAtOffset([&]()
+    {
+        executed.push_back(1);
+        events.AddEvent(new RecordingEvent(executed, 2), events.CalculateTime(-50ms));
+        events.AddEvent(new RecordingEvent(executed, 4), events.CalculateTime(0ms));
+    }, 50ms);
+
+    events.Update(100);
+
+    REQUIRE(executed == std::vector<uint32>{ 1, 2, 3, 4 });
+}
+
+TEST_CASE("Modify event time", "[EventProcessor]")
+{
+    EventProcessor events;
+    std::vector<uint32> executed;
+
+    RecordingEvent* event = new RecordingEvent(executed, 1);
+    events.AddEventAtOffset(event, 10min);
+    events.AddEventAtOffset(new RecordingEvent(executed, 2), 1s);
+
+    events.ModifyEventTime(event, events.CalculateTime(500ms));
+
+    events.Update(500);
+    REQUIRE(executed == std::vector<uint32>{ 1 });
+
+    events.Update(500);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2 });
+}
+
+TEST_CASE("Events far in the future", "[EventProcessor]")
+{
+    EventProcessor events;
+    uint32 counter = 0;
+
+    events.AddEventAtOffset(new CountingEvent(counter), 2h);
+
+    for (uint32 i = 0; i < 7199; ++i)
+        events.Update(1000);
+
+    REQUIRE(counter == 0);
+
+    events.Update(1000);
+    REQUIRE(counter == 1);
+}
+
+TEST_CASE("Kill all events", "[EventProcessor]")
+{
+    EventProcessor events;
+    uint32 counter = 0;
+
+    events.AddEventAtOffset(new CountingEvent(counter), 1s);
+    events.AddEventAtOffset(new CountingEvent(counter), 1h);
+    events.KillAllEvents(false);
+
+    events.Update(3600 * 1000);
+    REQUIRE(counter == 0);
+}
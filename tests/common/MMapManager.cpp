@@ -0,0 +1,109 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MMapManager.h"
+#include "StringFormat.h"
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+    // temporary data directory with an empty .mmap navmesh for every map
+    struct MMapTestData
+    {
+        explicit MMapTestData(uint32 mapCount)
+        {
+            Path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("tc-mmaps-%%%%-%%%%");
+            boost::filesystem::create_directories(Path / "mmaps");
+
+            dtNavMeshParams params = { };
+            params.tileWidth = 533.33333f;
+            params.tileHeight = 533.33333f;
+            params.maxTiles = 64;
+            params.maxPolys = 1024;
+            for (uint32 mapId = 0; mapId < mapCount; ++mapId)
+            {
+                std::string fileName = Trinity::StringFormat("%s/mmaps/%03u.mmap", Path.string(), mapId);
+                FILE* file = fopen(fileName.c_str(), "wb");
+                fwrite(&params, sizeof(params), 1, file);
+                fclose(file);
+            }
+        }
+
+        ~MMapTestData()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(Path, ec);
+        }
+
+        std::string MMapPath() const { return (Path / "mmaps").string(); }
+
+        boost::filesystem::path Path;
+    };
+}
+
+TEST_CASE("MMapManager pools navmesh queries per thread", "[MMapManager]")
+{
+    uint32 const mapCount = MMAP::MMapManager::MAX_THREAD_NAVMESH_QUERIES + 1;
+    MMapTestData data(mapCount);
+
+    MMAP::MMapManager manager;
+    for (uint32 mapId = 0; mapId < mapCount; ++mapId)
+    {
+        manager.loadMap(data.MMapPath(), mapId, 0, 0);   // there are no tiles, only the navmesh gets loaded
+        REQUIRE(manager.GetNavMesh(mapId));
+    }
+
+    REQUIRE(manager.GetMemoryStats().LoadedMaps == mapCount);
+
+    uint32 queriesBefore = manager.GetMemoryStats().NavMeshQueries;
+    dtNavMeshQuery const* query = manager.GetNavMeshQuery(0);
+    REQUIRE(query);
+    REQUIRE(query->getAttachedNavMesh() == manager.GetNavMesh(0));
+    REQUIRE(manager.GetNavMeshQuery(0) == query);
+
+    SECTION("Other threads get their own queries")
+    {
+        dtNavMeshQuery const* otherQuery = nullptr;
+        std::thread([&]() { otherQuery = manager.GetNavMeshQuery(0); }).join();
+        REQUIRE(otherQuery);
+        REQUIRE(otherQuery != query);
+        REQUIRE(manager.GetMemoryStats().NavMeshQueries <= queriesBefore + 1);
+    }
+
+    SECTION("Threads keep a bounded number of queries")
+    {
+        for (uint32 mapId = 0; mapId < mapCount; ++mapId)
+            REQUIRE(manager.GetNavMeshQuery(mapId)->getAttachedNavMesh() == manager.GetNavMesh(mapId));
+
+        REQUIRE(manager.GetMemoryStats().NavMeshQueries <= MMAP::MMapManager::MAX_THREAD_NAVMESH_QUERIES);
+        REQUIRE(manager.GetMemoryStats().NavMeshQueryBytes > 0);
+
+        // map 0 was the least recently used, its query now belongs to the last map
+        REQUIRE(manager.GetNavMeshQuery(0)->getAttachedNavMesh() == manager.GetNavMesh(0));
+    }
+
+    SECTION("Queries are rebound to reloaded navmeshes")
+    {
+        REQUIRE(manager.unloadMap(0));
+        manager.loadMap(data.MMapPath(), 0, 0, 0);
+        REQUIRE(manager.GetNavMeshQuery(0)->getAttachedNavMesh() == manager.GetNavMesh(0));
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ScratchVector.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("ScratchVector reuses vectors", "[ScratchVector]")
+{
+    std::vector<uint32>* first = nullptr;
+    {
+        Trinity::ScratchVector<uint32> vector;
+        REQUIRE(vector->empty());
+        vector->assign(100, 1);
+        first = &*vector;
+    }
+
+    {
+        Trinity::ScratchVector<uint32> vector;
+        REQUIRE(&*vector == first);
+        REQUIRE(vector->empty());
+        REQUIRE(vector->capacity() >= 100);
+
+        // nested scopes, like a spell cast from inside a target selection hook, get their own vector
+        Trinity::ScratchVector<uint32> nested;
+        REQUIRE(&*nested != first);
+        nested->push_back(2);
+        vector->push_back(1);
+        REQUIRE(vector->size() == 1);
+        REQUIRE(nested->size() == 1);
+    }
+
+    SECTION("Other threads have their own pool")
+    {
+        std::vector<uint32>* other = nullptr;
+        std::thread([&]()
+        {
+            Trinity::ScratchVector<uint32> vector;
+            other = &*vector;
+        }).join();
+        REQUIRE(other != first);
+    }
+}
@@ -0,0 +1,251 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "SlabPool.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // roughly the footprint of a creature, several kilobytes plus a few member containers allocating on their own
+    struct HeapObject
+    {
+        HeapObject(uint32 id) : Id(id)
+        {
+            Payload.fill(uint8(id));
+            Auras.emplace(id, id);
+            Targets.resize(4);
+        }
+
+        virtual ~HeapObject() = default;
+
+        uint32 Id;
+        std::array<uint8, 3000> Payload;
+        std::unordered_map<uint32, uint32> Auras;
+        std::vector<uint64> Targets;
+    };
+
+    struct PooledObject : HeapObject
+    {
+        using HeapObject::HeapObject;
+
+        static Trinity::SlabPool& GetPool()
+        {
+            static Trinity::SlabPool pool("test");
+            return pool;
+        }
+
+        void* operator new(size_t size) { return GetPool().Allocate(size); }
+        void operator delete(void* ptr) { Trinity::SlabPool::Deallocate(ptr); }
+    };
+
+    struct LargerPooledObject : PooledObject
+    {
+        using PooledObject::PooledObject;
+
+        std::array<uint8, 512> Extra;
+    };
+}
+
+TEST_CASE("SlabPool reuses freed slots", "[SlabPool]")
+{
+    Trinity::SlabPool pool("test", 4);
+
+    std::vector<void*> slots;
+    for (uint32 i = 0; i < 6; ++i)
+    {
+        slots.push_back(pool.Allocate(100));
+        std::memset(slots.back(), int(i), 100);
+    }
+
+    Trinity::SlabPool::Stats stats = pool.GetStats();
+    REQUIRE(stats.Slabs == 2);
+    REQUIRE(stats.Live == 6);
+    REQUIRE(stats.Capacity == 8);
+    REQUIRE(stats.FreeInUsedSlabs == 2);
+
+    for (void* slot : slots)
+        REQUIRE(uintptr_t(slot) % alignof(std::max_align_t) == 0);
+
+    Trinity::SlabPool::Deallocate(slots[1]);
+    REQUIRE(pool.Allocate(100) == slots[1]);
+
+    SECTION("Empty slabs are released except one")
+    {
+        for (void* slot : slots)
+            Trinity::SlabPool::Deallocate(slot);
+
+        stats = pool.GetStats();
+        REQUIRE(stats.Live == 0);
+        REQUIRE(stats.Slabs == 1);
+        REQUIRE(stats.FreeInUsedSlabs == 0);
+
+        // cached slab is reused
+        slots.assign(1, pool.Allocate(100));
+        REQUIRE(pool.GetStats().Slabs == 1);
+        Trinity::SlabPool::Deallocate(slots[0]);
+    }
+
+    SECTION("Different sizes use separate slabs")
+    {
+        void* large = pool.Allocate(1000);
+        stats = pool.GetStats();
+        REQUIRE(stats.Slabs == 3);
+        REQUIRE(stats.Live == 7);
+        Trinity::SlabPool::Deallocate(large);
+
+        for (void* slot : slots)
+            Trinity::SlabPool::Deallocate(slot);
+    }
+}
+
+TEST_CASE("SlabPool backs class operator new", "[SlabPool]")
+{
+    std::size_t liveBefore = PooledObject::GetPool().GetStats().Live;
+
+    std::vector<PooledObject*> objects;
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        if (i % 3)
+            objects.push_back(new PooledObject(i));
+        else
+            objects.push_back(new LargerPooledObject(i));
+    }
+
+    REQUIRE(PooledObject::GetPool().GetStats().Live == liveBefore + 100);
+
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        REQUIRE(objects[i]->Id == i);
+        REQUIRE(objects[i]->Payload[2999] == uint8(i));
+        delete objects[i];
+    }
+
+    REQUIRE(PooledObject::GetPool().GetStats().Live == liveBefore);
+}
+
+TEST_CASE("SlabPool used from multiple threads", "[SlabPool]")
+{
+    Trinity::SlabPool pool("test", 16, 2);
+    REQUIRE(pool.GetArenaCount() == 2);
+
+    std::array<std::vector<uint32*>, 4> kept;
+    std::vector<std::thread> threads;
+    for (uint32 t = 0; t < kept.size(); ++t)
+    {
+        threads.emplace_back([&pool, &kept, t]()
+        {
+            std::vector<uint32*> values;
+            for (uint32 round = 0; round < 200; ++round)
+            {
+                for (uint32 i = 0; i < 50; ++i)
+                {
+                    values.push_back(static_cast<uint32*>(pool.Allocate(sizeof(uint32) * 8)));
+                    *values.back() = t;
+                }
+
+                for (uint32* value : values)
+                    Trinity::SlabPool::Deallocate(value);
+                values.clear();
+            }
+
+            // objects of the last round outlive the thread that allocated them
+            for (uint32 i = 0; i < 50; ++i)
+            {
+                kept[t].push_back(static_cast<uint32*>(pool.Allocate(sizeof(uint32) * 8)));
+                *kept[t].back() = t;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    REQUIRE(pool.GetStats().Live == kept.size() * 50);
+
+    // and are freed here by another thread, into the arenas of their slabs
+    for (uint32 t = 0; t < kept.size(); ++t)
+    {
+        for (uint32* value : kept[t])
+        {
+            REQUIRE(*value == t);
+            Trinity::SlabPool::Deallocate(value);
+        }
+    }
+
+    REQUIRE(pool.GetStats().Live == 0);
+    REQUIRE(pool.GetStats().Allocations == kept.size() * (200 * 50 + 50));
+}
+
+TEST_CASE("SlabPool concurrent churn benchmark", "[!benchmark][SlabPool]")
+{
+    // every thread is a map loading and unloading a grid with a few hundred spawns
+    constexpr uint32 ObjectsPerGrid = 300;
+    constexpr uint32 GridsPerThread = 20;
+
+    auto churn = [](uint32 threadCount, auto create)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<uint64> sum(0);
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&]()
+            {
+                std::vector<HeapObject*> grid(ObjectsPerGrid);
+                uint64 localSum = 0;
+                for (uint32 round = 0; round < GridsPerThread; ++round)
+                {
+                    for (uint32 i = 0; i < ObjectsPerGrid; ++i)
+                        grid[i] = create(i);
+
+                    for (HeapObject* object : grid)
+                    {
+                        localSum += object->Payload[object->Id % 3000];
+                        delete object;
+                    }
+                }
+
+                sum += localSum;
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return sum.load();
+    };
+
+    for (uint32 threadCount : { 1, 4, 8 })
+    {
+        BENCHMARK("Global heap, " + std::to_string(threadCount) + " threads")
+        {
+            return churn(threadCount, [](uint32 id) { return new HeapObject(id); });
+        };
+
+        BENCHMARK("Slab pool, " + std::to_string(threadCount) + " threads")
+        {
+            return churn(threadCount, [](uint32 id) -> HeapObject* { return new PooledObject(id); });
+        };
+    }
+}
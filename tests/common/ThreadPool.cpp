@@ -0,0 +1,79 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("ThreadPool", "[ThreadPool]")
+{
+    Trinity::ThreadPool pool;
+
+    SECTION("Work runs on the calling thread when not started")
+    {
+        std::thread::id workerId;
+        pool.PostWork([&workerId]() { workerId = std::this_thread::get_id(); });
+
+        REQUIRE_FALSE(pool.IsStarted());
+        REQUIRE(workerId == std::this_thread::get_id());
+    }
+
+    SECTION("Work runs on the worker threads")
+    {
+        pool.Start(2);
+        REQUIRE(pool.IsStarted());
+        REQUIRE(pool.GetThreadCount() == 2);
+
+        std::thread::id const callingThreadId = std::this_thread::get_id();
+        std::atomic<uint32> executed(0);
+        std::atomic<bool> onCallingThread(false);
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            pool.PostWork([&]()
+            {
+                if (std::this_thread::get_id() == callingThreadId)
+                    onCallingThread = true;
+                ++executed;
+            });
+        }
+
+        pool.Wait();
+        REQUIRE(executed == 100);
+        REQUIRE_FALSE(onCallingThread);
+    }
+
+    SECTION("Stop finishes posted work and joins the workers")
+    {
+        pool.Start(2);
+
+        std::atomic<uint32> executed(0);
+        for (uint32 i = 0; i < 10; ++i)
+            pool.PostWork([&executed]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); ++executed; });
+
+        pool.Stop();
+        REQUIRE(executed == 10);
+        REQUIRE_FALSE(pool.IsStarted());
+        REQUIRE(pool.GetThreadCount() == 0);
+
+        // stopping again and destroying a stopped pool are harmless
+        pool.Stop();
+        REQUIRE_FALSE(pool.IsStarted());
+    }
+}
@@ -0,0 +1,225 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchy.h"
+#include "MapTree.h"
+#include "ModelInstance.h"
+#include "VMapDefinitions.h"
+#include "VMapManager2.h"
+#include "WorldModel.h"
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    void GetSpawnBounds(VMAP::ModelSpawn const* const& spawn, G3D::AABox& out) { out = spawn->getBounds(); }
+
+    // Writes tiled maps in the vmap format, spawns use the shared models in turn, every tile
+    // also references the first spawn of the previous tile like models crossing tile borders do
+    struct VMapTestData
+    {
+        VMapTestData(uint32 mapCount, uint32 tilesPerSide, uint32 modelCount, uint32 spawnsPerTile) : TilesPerSide(tilesPerSide), ModelCount(modelCount)
+        {
+            Path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("tc-vmaps-%%%%-%%%%");
+            boost::filesystem::create_directories(Path);
+            BasePath = Path.string() + "/";
+
+            for (uint32 i = 0; i < modelCount; ++i)
+            {
+                VMAP::WorldModel model;
+                model.setRootWmoID(i);
+                model.writeFile(BasePath + GetModelName(i) + ".vmo");
+            }
+
+            for (uint32 mapId = 0; mapId < mapCount; ++mapId)
+            {
+                std::vector<VMAP::ModelSpawn> spawns;
+                std::vector<std::vector<uint32>> tileSpawns(tilesPerSide * tilesPerSide);
+                for (uint32 tile = 0; tile < tileSpawns.size(); ++tile)
+                {
+                    for (uint32 i = 0; i < spawnsPerTile; ++i)
+                    {
+                        VMAP::ModelSpawn spawn;
+                        spawn.flags = VMAP::MOD_HAS_BOUND;
+                        spawn.adtId = 0;
+                        spawn.ID = spawns.size();
+                        spawn.iPos = G3D::Vector3(float(tile * 100 + i), float(tile * 100), 0.0f);
+                        spawn.iRot = G3D::Vector3::zero();
+                        spawn.iScale = 1.0f;
+                        spawn.iBound = G3D::AABox(spawn.iPos, spawn.iPos + G3D::Vector3(10.0f, 10.0f, 10.0f));
+                        spawn.name = GetModelName(spawn.ID % modelCount);
+                        tileSpawns[tile].push_back(spawns.size());
+                        spawns.push_back(spawn);
+                    }
+
+                    if (tile > 0)
+                        tileSpawns[tile].push_back(tileSpawns[tile - 1].front());
+                }
+
+                std::vector<VMAP::ModelSpawn const*> spawnPtrs;
+                for (VMAP::ModelSpawn const& spawn : spawns)
+                    spawnPtrs.push_back(&spawn);
+
+                BIH tree;
+                tree.build(spawnPtrs, GetSpawnBounds);
+
+                FILE* treeFile = fopen((BasePath + VMAP::VMapManager2::getMapFileName(mapId)).c_str(), "wb");
+                char tiled = 1;
+                fwrite(VMAP::VMAP_MAGIC, 1, 8, treeFile);
+                fwrite(&tiled, sizeof(char), 1, treeFile);
+                fwrite("NODE", 1, 4, treeFile);
+                tree.writeToFile(treeFile);
+                fwrite("GOBJ", 1, 4, treeFile);
+                fclose(treeFile);
+
+                for (uint32 tile = 0; tile < tileSpawns.size(); ++tile)
+                {
+                    FILE* tileFile = fopen((BasePath + VMAP::StaticMapTree::getTileFileName(mapId, tile / tilesPerSide, tile % tilesPerSide)).c_str(), "wb");
+                    uint32 numSpawns = tileSpawns[tile].size();
+                    fwrite(VMAP::VMAP_MAGIC, 1, 8, tileFile);
+                    fwrite(&numSpawns, sizeof(uint32), 1, tileFile);
+                    for (uint32 spawnIndex : tileSpawns[tile])
+                    {
+                        VMAP::ModelSpawn::writeToFile(tileFile, spawns[spawnIndex]);
+                        fwrite(&spawnIndex, sizeof(uint32), 1, tileFile);
+                    }
+                    fclose(tileFile);
+                }
+
+                MapIds.push_back(mapId);
+            }
+        }
+
+        ~VMapTestData()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(Path, ec);
+        }
+
+        static std::string GetModelName(uint32 index) { return "model" + std::to_string(index); }
+
+        boost::filesystem::path Path;
+        std::string BasePath;
+        std::vector<uint32> MapIds;
+        uint32 TilesPerSide;
+        uint32 ModelCount;
+    };
+}
+
+TEST_CASE("VMapManager2 shares loaded models", "[VMapManager2]")
+{
+    VMapTestData data(2, 2, 4, 3);
+    VMAP::VMapManager2 manager;
+    manager.InitializeThreadUnsafe(data.MapIds);
+
+    VMAP::WorldModel* model = manager.acquireModelInstance(data.BasePath, VMapTestData::GetModelName(0));
+    REQUIRE(model);
+    REQUIRE(manager.acquireModelInstance(data.BasePath, VMapTestData::GetModelName(0)) == model);
+    REQUIRE(manager.getLoadedModelCount() == 1);
+    REQUIRE_FALSE(manager.acquireModelInstance(data.BasePath, "missing"));
+
+    manager.releaseModelInstance(VMapTestData::GetModelName(0));
+    REQUIRE(manager.getLoadedModelCount() == 1);
+    manager.releaseModelInstance(VMapTestData::GetModelName(0));
+    REQUIRE(manager.getLoadedModelCount() == 0);
+
+    for (uint32 mapId : data.MapIds)
+        for (uint32 x = 0; x < data.TilesPerSide; ++x)
+            for (uint32 y = 0; y < data.TilesPerSide; ++y)
+                REQUIRE(manager.loadMap(data.BasePath.c_str(), mapId, x, y) == VMAP::VMAP_LOAD_RESULT_OK);
+
+    REQUIRE(manager.getLoadedModelCount() == data.ModelCount);
+
+    for (uint32 mapId : data.MapIds)
+        for (uint32 x = 0; x < data.TilesPerSide; ++x)
+            for (uint32 y = 0; y < data.TilesPerSide; ++y)
+                manager.unloadMap(mapId, x, y);
+
+    REQUIRE(manager.getLoadedModelCount() == 0);
+}
+
+TEST_CASE("VMapManager2 loads tiles of different maps in parallel", "[VMapManager2]")
+{
+    uint32 const threadCount = std::max(4u, std::thread::hardware_concurrency());
+    VMapTestData data(threadCount, 4, 32, 6);
+    VMAP::VMapManager2 manager;
+    manager.InitializeThreadUnsafe(data.MapIds);
+
+    // pinned models must keep their instance no matter how often other references come and go
+    std::vector<VMAP::WorldModel*> pinned;
+    for (uint32 i = 0; i < 4; ++i)
+        pinned.push_back(manager.acquireModelInstance(data.BasePath, VMapTestData::GetModelName(i)));
+
+    std::atomic<uint32> failures(0);
+    std::vector<std::thread> threads;
+
+    // one thread per map like map updates do, tiles are unloaded in the order they were loaded
+    for (uint32 mapId : data.MapIds)
+    {
+        threads.emplace_back([&, mapId]()
+        {
+            std::vector<std::pair<uint32, uint32>> tiles;
+            for (uint32 x = 0; x < data.TilesPerSide; ++x)
+                for (uint32 y = 0; y < data.TilesPerSide; ++y)
+                    tiles.emplace_back(x, y);
+
+            for (uint32 round = 0; round < 25; ++round)
+            {
+                for (std::pair<uint32, uint32> const& tile : tiles)
+                    if (manager.loadMap(data.BasePath.c_str(), mapId, tile.first, tile.second) != VMAP::VMAP_LOAD_RESULT_OK)
+                        ++failures;
+
+                for (std::pair<uint32, uint32> const& tile : tiles)
+                    manager.unloadMap(mapId, tile.first, tile.second);
+            }
+        });
+    }
+
+    // and gameobject models acquired directly from other threads at the same time
+    for (uint32 t = 0; t < 2; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (uint32 i = 0; i < 5000; ++i)
+            {
+                uint32 index = i % data.ModelCount;
+                std::string name = VMapTestData::GetModelName(index);
+                VMAP::WorldModel* model = manager.acquireModelInstance(data.BasePath, name);
+                if (!model || (index < pinned.size() && model != pinned[index]))
+                    ++failures;
+
+                manager.releaseModelInstance(name);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    REQUIRE(failures == 0);
+    REQUIRE(manager.getLoadedModelCount() == pinned.size());
+
+    for (uint32 i = 0; i < pinned.size(); ++i)
+        manager.releaseModelInstance(VMapTestData::GetModelName(i));
+
+    REQUIRE(manager.getLoadedModelCount() == 0);
+}
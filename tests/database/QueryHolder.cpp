@@ -0,0 +1,111 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "PreparedStatement.h"
+#include "QueryHolder.h"
+#include "QueryResult.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // answers every statement with an empty result set claiming statement index + 1 rows, no connection needed
+    class TestQueryHolderTask : public SQLQueryHolderTask
+    {
+    public:
+        using SQLQueryHolderTask::SQLQueryHolderTask;
+
+    protected:
+        PreparedResultSet* Query(PreparedStatementBase* stmt) override
+        {
+            return new PreparedResultSet(nullptr, nullptr, stmt->GetIndex() + 1, 0);
+        }
+    };
+
+    std::shared_ptr<SQLQueryHolderBase> MakeHolder(uint32 queryCount)
+    {
+        std::shared_ptr<SQLQueryHolder<CharacterDatabaseConnection>> holder = std::make_shared<SQLQueryHolder<CharacterDatabaseConnection>>();
+        holder->SetSize(queryCount);
+        for (uint32 i = 0; i < queryCount; ++i)
+            holder->SetPreparedQuery(i, new PreparedStatement<CharacterDatabaseConnection>(i * 10, 0));
+        return holder;
+    }
+}
+
+TEST_CASE("Query holder task count", "[QueryHolder]")
+{
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(35, 1, 8) == 1);
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(35, 4, 8) == 4);
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(35, 4, 4) == 2);
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(35, 4, 1) == 1);
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(3, 4, 16) == 3);
+    REQUIRE(SQLQueryHolderTask::GetTaskCount(0, 4, 16) == 1);
+}
+
+TEST_CASE("Split query holders", "[QueryHolder]")
+{
+    constexpr uint32 QueryCount = 11;
+    constexpr uint32 TaskCount = 3;
+
+    std::shared_ptr<SQLQueryHolderBase> holder = MakeHolder(QueryCount);
+    std::shared_ptr<SQLQueryHolderTask::SharedResult> sharedResult = std::make_shared<SQLQueryHolderTask::SharedResult>(TaskCount);
+    SQLQueryHolderCallback callback(std::shared_ptr<SQLQueryHolderBase>(holder), sharedResult->Result.GetFuture());
+
+    uint32 invoked = 0;
+    callback.AfterComplete([&](SQLQueryHolderBase const& completed)
+    {
+        ++invoked;
+        REQUIRE(&completed == holder.get());
+    });
+
+    std::vector<std::unique_ptr<TestQueryHolderTask>> tasks;
+    for (uint32 i = 0; i < TaskCount; ++i)
+        tasks.push_back(std::make_unique<TestQueryHolderTask>(holder, sharedResult, i, TaskCount));
+
+    SECTION("Callback waits for the last task")
+    {
+        tasks[2]->Execute();
+        tasks[0]->Execute();
+        REQUIRE_FALSE(callback.InvokeIfReady());
+
+        tasks[1]->Execute();
+        REQUIRE(callback.InvokeIfReady());
+    }
+
+    SECTION("Tasks running on different threads")
+    {
+        std::vector<std::thread> threads;
+        for (std::unique_ptr<TestQueryHolderTask>& task : tasks)
+            threads.emplace_back([&task]() { task->Execute(); });
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        REQUIRE(callback.InvokeIfReady());
+    }
+
+    REQUIRE(invoked == 1);
+    for (uint32 i = 0; i < QueryCount; ++i)
+    {
+        PreparedQueryResult result = holder->GetPreparedResult(i);
+        REQUIRE(result);
+        REQUIRE(result->GetRowCount() == i * 10 + 1);
+    }
+}
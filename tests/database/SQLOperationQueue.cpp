@@ -0,0 +1,149 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "SQLOperationQueue.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct TestOperation : SQLOperation
+    {
+        TestOperation(uint32 id, uint32* destroyed = nullptr) : Id(id), Destroyed(destroyed) { }
+        ~TestOperation() { if (Destroyed) ++*Destroyed; }
+
+        bool Execute() override { return true; }
+
+        uint32 Id;
+        uint32* Destroyed;
+    };
+
+    uint32 PopId(SQLOperationQueue& queue)
+    {
+        std::atomic<bool> cancel(false);
+        SQLOperation* operation = queue.WaitAndPop(cancel);
+        REQUIRE(operation);
+        uint32 id = static_cast<TestOperation*>(operation)->Id;
+        delete operation;
+        return id;
+    }
+}
+
+TEST_CASE("Interactive operations overtake normal ones", "[SQLOperationQueue]")
+{
+    SQLOperationQueue queue;
+    queue.Push(new TestOperation(1), SQL_PRIORITY_NORMAL);
+    queue.Push(new TestOperation(2), SQL_PRIORITY_NORMAL);
+    queue.Push(new TestOperation(3), SQL_PRIORITY_INTERACTIVE);
+    REQUIRE(queue.GetDepth() == 3);
+
+    REQUIRE(PopId(queue) == 3);
+    REQUIRE(PopId(queue) == 1);
+    REQUIRE(PopId(queue) == 2);
+    REQUIRE(queue.GetDepth() == 0);
+}
+
+TEST_CASE("Normal operations are not starved", "[SQLOperationQueue]")
+{
+    SQLOperationQueue queue;
+    queue.Push(new TestOperation(0), SQL_PRIORITY_NORMAL);
+    for (uint32 i = 1; i <= SQLOperationQueue::MAX_INTERACTIVE_STREAK * 2; ++i)
+        queue.Push(new TestOperation(i), SQL_PRIORITY_INTERACTIVE);
+
+    for (uint32 i = 1; i <= SQLOperationQueue::MAX_INTERACTIVE_STREAK; ++i)
+        REQUIRE(PopId(queue) == i);
+
+    REQUIRE(PopId(queue) == 0);
+    REQUIRE(PopId(queue) == SQLOperationQueue::MAX_INTERACTIVE_STREAK + 1);
+}
+
+TEST_CASE("Queue stats are collected per lane", "[SQLOperationQueue]")
+{
+    SQLOperationQueue queue;
+    queue.Push(new TestOperation(1), SQL_PRIORITY_NORMAL);
+    queue.Push(new TestOperation(2), SQL_PRIORITY_NORMAL);
+    queue.Push(new TestOperation(3), SQL_PRIORITY_INTERACTIVE);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    REQUIRE(queue.GetOldestWaitTime() >= std::chrono::milliseconds(2));
+
+    PopId(queue);
+    PopId(queue);
+
+    SQLOperationQueueStats normal = queue.ConsumeStats(SQL_PRIORITY_NORMAL);
+    REQUIRE(normal.Depth == 1);
+    REQUIRE(normal.Executed == 1);
+    REQUIRE(normal.MaxWaitTime >= std::chrono::milliseconds(2));
+
+    SQLOperationQueueStats interactive = queue.ConsumeStats(SQL_PRIORITY_INTERACTIVE);
+    REQUIRE(interactive.Depth == 0);
+    REQUIRE(interactive.Executed == 1);
+    REQUIRE(interactive.TotalWaitTime == interactive.MaxWaitTime);
+
+    REQUIRE(queue.ConsumeStats(SQL_PRIORITY_INTERACTIVE).Executed == 0);
+}
+
+TEST_CASE("Stopping one worker does not affect others", "[SQLOperationQueue]")
+{
+    SQLOperationQueue queue;
+    std::atomic<bool> stopFirst(false);
+    std::atomic<bool> stopSecond(false);
+    std::atomic<uint32> executedBySecond(0);
+    SQLOperation* poppedByFirst = nullptr;
+
+    std::thread first([&]()
+    {
+        poppedByFirst = queue.WaitAndPop(stopFirst);
+    });
+
+    std::thread second([&]()
+    {
+        while (SQLOperation* operation = queue.WaitAndPop(stopSecond))
+        {
+            ++executedBySecond;
+            delete operation;
+        }
+    });
+
+    stopFirst = true;
+    queue.WakeAll();
+    first.join();
+    REQUIRE(!poppedByFirst);
+
+    queue.Push(new TestOperation(1), SQL_PRIORITY_NORMAL);
+    while (!executedBySecond)
+        std::this_thread::yield();
+
+    stopSecond = true;
+    queue.WakeAll();
+    second.join();
+    REQUIRE(executedBySecond == 1);
+}
+
+TEST_CASE("Cancelling the queue deletes queued operations", "[SQLOperationQueue]")
+{
+    uint32 destroyed = 0;
+    SQLOperationQueue queue;
+    queue.Push(new TestOperation(1, &destroyed), SQL_PRIORITY_NORMAL);
+    queue.Push(new TestOperation(2, &destroyed), SQL_PRIORITY_INTERACTIVE);
+    queue.Cancel();
+    REQUIRE(destroyed == 2);
+
+    std::atomic<bool> cancel(false);
+    REQUIRE(!queue.WaitAndPop(cancel));
+}
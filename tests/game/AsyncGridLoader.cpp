@@ -0,0 +1,140 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AsyncGridLoader.h"
+#include "Map.h"
+#include "StringFormat.h"
+#include <boost/filesystem/operations.hpp>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // temporary data directory, WriteGrid adds flat .map files for grids of map 0
+    struct TempDataDir
+    {
+        TempDataDir()
+        {
+            Path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+            boost::filesystem::create_directories(Path / "maps");
+        }
+
+        ~TempDataDir()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove_all(Path, ec);
+        }
+
+        void WriteGrid(int32 gx, int32 gy, float height)
+        {
+            map_fileheader header = { };
+            header.mapMagic = { { 'M','A','P','S' } };
+            header.versionMagic = { { 'v','1','.','9' } };
+            header.heightMapOffset = sizeof(map_fileheader);
+            header.heightMapSize = sizeof(map_heightHeader);
+
+            map_heightHeader heightHeader = { };
+            heightHeader.fourcc = u_map_magic{ { 'M','H','G','T' } }.asUInt;
+            heightHeader.flags = MAP_HEIGHT_NO_HEIGHT;
+            heightHeader.gridHeight = height;
+            heightHeader.gridMaxHeight = height;
+
+            std::string fileName = Trinity::StringFormat("%s/maps/%03u%02u%02u.map", Path.string(), 0, gx, gy);
+            FILE* file = fopen(fileName.c_str(), "wb");
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(&heightHeader, sizeof(heightHeader), 1, file);
+            fclose(file);
+        }
+
+        std::string DataPath() const { return Path.string() + "/"; }
+
+        boost::filesystem::path Path;
+    };
+
+    AsyncGridLoader::Stats WaitForLoads(AsyncGridLoader& loader, uint32 count)
+    {
+        AsyncGridLoader::Stats total;
+        while (total.Loaded < count)
+        {
+            AsyncGridLoader::Stats stats = loader.ConsumeStats();
+            total.Loaded += stats.Loaded;
+            total.Taken += stats.Taken;
+            total.Discarded += stats.Discarded;
+            std::this_thread::yield();
+        }
+
+        return total;
+    }
+}
+
+TEST_CASE("AsyncGridLoader prefetches grids", "[AsyncGridLoader]")
+{
+    TempDataDir dataDir;
+    dataDir.WriteGrid(30, 31, 12.0f);
+    dataDir.WriteGrid(30, 32, 24.0f);
+
+    AsyncGridLoader loader;
+    std::chrono::microseconds stallTime;
+    loader.Prefetch(0, 30, 31, 0.0f);
+    REQUIRE_FALSE(loader.Take(0, 30, 31, stallTime));
+
+    loader.Start(2, dataDir.DataPath(), false);
+    loader.Prefetch(0, 30, 31, 100.0f);
+    loader.Prefetch(0, 30, 32, 50.0f);
+    WaitForLoads(loader, 2);
+
+    std::unique_ptr<GridMap> grid = loader.Take(0, 30, 32, stallTime);
+    REQUIRE(grid);
+    REQUIRE(grid->getHeight(-300.0f, -100.0f) == 24.0f);
+    REQUIRE(loader.ConsumeStats().Taken == 1);
+
+    SECTION("Grids are handed over once")
+    {
+        REQUIRE_FALSE(loader.Take(0, 30, 32, stallTime));
+        REQUIRE(loader.Take(0, 30, 31, stallTime));
+    }
+
+    SECTION("Unclaimed grids are discarded")
+    {
+        // missing files are loaded as empty grids, just like on the map thread
+        for (int32 gx = 0; gx < 64; ++gx)
+            loader.Prefetch(0, gx, 0, float(gx));
+        REQUIRE(WaitForLoads(loader, 64).Discarded == 1);
+
+        REQUIRE_FALSE(loader.Take(0, 30, 31, stallTime));
+        REQUIRE(loader.Take(0, 63, 0, stallTime));
+    }
+
+    SECTION("Grids prefetched again after being taken are discarded in load order")
+    {
+        loader.Prefetch(0, 30, 32, 0.0f);
+        WaitForLoads(loader, 1);
+
+        for (int32 gx = 0; gx < 63; ++gx)
+            loader.Prefetch(0, gx, 5, float(gx));
+        REQUIRE(WaitForLoads(loader, 63).Discarded == 1);
+
+        REQUIRE_FALSE(loader.Take(0, 30, 31, stallTime));
+        REQUIRE(loader.Take(0, 30, 32, stallTime));
+    }
+
+    loader.Stop();
+    REQUIRE_FALSE(loader.IsStarted());
+}
@@ -0,0 +1,130 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "CharacterCacheStorage.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    ObjectGuid PlayerGuid(uint32 counter)
+    {
+        return ObjectGuid(HighGuid::Player, counter);
+    }
+
+    // unique names of letters only, first one uppercase like normalized player names
+    std::vector<std::string> MakeNames(uint32 count)
+    {
+        std::vector<std::string> names;
+        names.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            std::string name = "A";
+            for (uint32 n = i; n; n /= 26)
+                name += char('a' + n % 26);
+            names.push_back(std::move(name) + "ra");
+        }
+
+        return names;
+    }
+}
+
+TEST_CASE("Character cache entries are found by guid and name", "[CharacterCacheStorage]")
+{
+    CharacterCacheStorage storage;
+    CharacterCacheEntry* arthas = storage.Add(PlayerGuid(1), "Arthas");
+    arthas->Level = 80;
+    storage.Add(PlayerGuid(2), "Jaina");
+
+    REQUIRE(storage.GetSize() == 2);
+    REQUIRE(storage.FindByGuid(PlayerGuid(1)) == arthas);
+    REQUIRE(storage.FindByGuid(PlayerGuid(3)) == nullptr);
+    REQUIRE(storage.FindByGuid(ObjectGuid(HighGuid::Unit, uint32(1), ObjectGuid::LowType(1))) == nullptr);
+
+    REQUIRE(storage.FindByName("Arthas") == arthas);
+    REQUIRE(storage.FindByName("arTHAS") == arthas);
+    REQUIRE(storage.FindByName("Art") == nullptr);
+    REQUIRE(storage.FindByName("Jaina")->Guid == PlayerGuid(2));
+
+    // null terminated for c string users
+    REQUIRE(arthas->Name.data()[arthas->Name.size()] == '\0');
+
+    // adding an existing guid keeps the entry
+    REQUIRE(storage.Add(PlayerGuid(1), "Arthas") == arthas);
+    REQUIRE(arthas->Level == 80);
+    REQUIRE(storage.GetSize() == 2);
+}
+
+TEST_CASE("Renamed and removed characters", "[CharacterCacheStorage]")
+{
+    CharacterCacheStorage storage;
+    CharacterCacheEntry* entry = storage.Add(PlayerGuid(7), "Thrall");
+    std::string_view oldName = entry->Name;
+
+    REQUIRE(storage.Rename(PlayerGuid(7), "Garrosh") == entry);
+    REQUIRE(storage.FindByName("Thrall") == nullptr);
+    REQUIRE(storage.FindByName("Garrosh") == entry);
+    REQUIRE(oldName == "Thrall");
+
+    REQUIRE(storage.Remove(PlayerGuid(7)));
+    REQUIRE(!storage.Remove(PlayerGuid(7)));
+    REQUIRE(storage.FindByGuid(PlayerGuid(7)) == nullptr);
+    REQUIRE(storage.FindByName("Garrosh") == nullptr);
+    REQUIRE(storage.GetSize() == 0);
+    REQUIRE(storage.GetMemoryStats().UnusedNameBytes == oldName.size() + 1 + std::string_view("Garrosh").size() + 1);
+
+    // removed entries are reused
+    REQUIRE(storage.Add(PlayerGuid(8), "Sylvanas") == entry);
+}
+
+TEST_CASE("Character cache survives heavy churn", "[CharacterCacheStorage]")
+{
+    constexpr uint32 Count = 20000;
+
+    std::vector<std::string> names = MakeNames(Count * 2);
+    CharacterCacheStorage storage;
+    for (uint32 i = 0; i < Count; ++i)
+        storage.Add(PlayerGuid(i + 1), names[i])->AccountId = i;
+
+    // remove every third character and rename every fifth, exercises deletion from clustered index slots
+    for (uint32 i = 0; i < Count; i += 3)
+        REQUIRE(storage.Remove(PlayerGuid(i + 1)));
+    for (uint32 i = 1; i < Count; i += 5)
+        if (i % 3)
+            storage.Rename(PlayerGuid(i + 1), names[Count + i]);
+
+    for (uint32 i = 0; i < Count; ++i)
+    {
+        CharacterCacheEntry const* byGuid = storage.FindByGuid(PlayerGuid(i + 1));
+        if (i % 3 == 0)
+        {
+            REQUIRE(!byGuid);
+            REQUIRE(!storage.FindByName(names[i]));
+            continue;
+        }
+
+        REQUIRE(byGuid);
+        REQUIRE(byGuid->AccountId == i);
+        bool renamed = i % 5 == 1;
+        REQUIRE(byGuid->Name == (renamed ? names[Count + i] : names[i]));
+        REQUIRE(storage.FindByName(byGuid->Name) == byGuid);
+        if (renamed)
+            REQUIRE(!storage.FindByName(names[i]));
+    }
+}
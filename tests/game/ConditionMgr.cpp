@@ -0,0 +1,117 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ConditionMgr.h"
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // ConditionValue1 is used as the result of the check so lists can be evaluated without any world objects
+    bool Passes(Condition const* condition)
+    {
+        return condition->ConditionValue1 != 0;
+    }
+
+    struct ConditionListFixture
+    {
+        Condition* Add(ConditionContainer& conditions, uint32 elseGroup, bool passes, bool loaded = true)
+        {
+            Condition* cond = Storage.emplace_back(std::make_unique<Condition>()).get();
+            cond->ElseGroup = elseGroup;
+            cond->ConditionType = loaded ? CONDITION_AURA : CONDITION_NONE;
+            cond->ConditionValue1 = passes ? 1 : 0;
+            ConditionMgr::AddToConditionList(conditions, cond);
+            return cond;
+        }
+
+        std::vector<std::unique_ptr<Condition>> Storage;
+    };
+}
+
+TEST_CASE("Condition lists keep ElseGroups together", "[ConditionMgr]")
+{
+    ConditionListFixture fixture;
+    ConditionContainer conditions;
+    Condition* a = fixture.Add(conditions, 0, true);
+    Condition* b = fixture.Add(conditions, 1, true);
+    Condition* c = fixture.Add(conditions, 0, true);
+    Condition* d = fixture.Add(conditions, 2, true);
+    Condition* e = fixture.Add(conditions, 1, true);
+
+    REQUIRE(conditions == ConditionContainer{ a, c, b, e, d });
+}
+
+TEST_CASE("Condition list evaluation", "[ConditionMgr]")
+{
+    ConditionListFixture fixture;
+
+    SECTION("All conditions of a single group must pass")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, true);
+        fixture.Add(conditions, 0, false);
+        REQUIRE_FALSE(ConditionMgr::EvaluateConditionList(conditions, Passes));
+    }
+
+    SECTION("Any passing ElseGroup is enough")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, false);
+        fixture.Add(conditions, 1, true);
+        fixture.Add(conditions, 0, true);
+        REQUIRE(ConditionMgr::EvaluateConditionList(conditions, Passes));
+    }
+
+    SECTION("Evaluation stops at the first passing ElseGroup")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, true);
+        fixture.Add(conditions, 1, false);
+        uint32 checks = 0;
+        REQUIRE(ConditionMgr::EvaluateConditionList(conditions, [&](Condition const* condition) { ++checks; return Passes(condition); }));
+        REQUIRE(checks == 1);
+    }
+
+    SECTION("Lists without loaded conditions do not pass")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, true, false);
+        REQUIRE_FALSE(ConditionMgr::EvaluateConditionList(conditions, Passes));
+    }
+
+    SECTION("Unloaded conditions are skipped")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, true);
+        fixture.Add(conditions, 0, false, false);
+        REQUIRE(ConditionMgr::EvaluateConditionList(conditions, Passes));
+    }
+
+    SECTION("Failed ElseGroups are not checked further")
+    {
+        ConditionContainer conditions;
+        fixture.Add(conditions, 0, false);
+        fixture.Add(conditions, 0, true);
+        fixture.Add(conditions, 1, true);
+        uint32 checks = 0;
+        REQUIRE(ConditionMgr::EvaluateConditionList(conditions, [&](Condition const* condition) { ++checks; return Passes(condition); }));
+        REQUIRE(checks == 2);
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Map.h"
+#include <boost/filesystem/operations.hpp>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // .map file of grid 32, 32 with float heights on the plane slopeX * row + slopeY * column of the height map
+    struct PlaneMapFile
+    {
+        PlaneMapFile(float slopeX, float slopeY) : SlopeX(slopeX), SlopeY(slopeY)
+        {
+            Path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%-%%%%.map")).string();
+
+            std::vector<float> V9(129 * 129), V8(128 * 128);
+            for (uint32 x = 0; x < 129; ++x)
+                for (uint32 y = 0; y < 129; ++y)
+                    V9[x * 129 + y] = x * SlopeX + y * SlopeY;
+            // V8 holds the heights of the cell centers
+            for (uint32 x = 0; x < 128; ++x)
+                for (uint32 y = 0; y < 128; ++y)
+                    V8[x * 128 + y] = (x + 0.5f) * SlopeX + (y + 0.5f) * SlopeY;
+
+            map_fileheader header = { };
+            header.mapMagic = { { 'M','A','P','S' } };
+            header.versionMagic = { { 'v','1','.','9' } };
+            header.heightMapOffset = sizeof(map_fileheader);
+            header.heightMapSize = sizeof(map_heightHeader) + (V9.size() + V8.size()) * sizeof(float);
+
+            map_heightHeader heightHeader = { };
+            heightHeader.fourcc = u_map_magic{ { 'M','H','G','T' } }.asUInt;
+
+            FILE* file = fopen(Path.c_str(), "wb");
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(&heightHeader, sizeof(heightHeader), 1, file);
+            fwrite(V9.data(), sizeof(float), V9.size(), file);
+            fwrite(V8.data(), sizeof(float), V8.size(), file);
+            fclose(file);
+        }
+
+        ~PlaneMapFile()
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(Path, ec);
+        }
+
+        // grid 32, 32 covers world coordinates (-533.33, 0], row and column grow towards -533.33
+        float Height(float x, float y) const
+        {
+            return -x / SIZE_OF_GRIDS * MAP_RESOLUTION * SlopeX - y / SIZE_OF_GRIDS * MAP_RESOLUTION * SlopeY;
+        }
+
+        std::string Path;
+        float SlopeX;
+        float SlopeY;
+    };
+}
+
+TEST_CASE("GridMap compact heights", "[GridMap]")
+{
+    PlaneMapFile file(1.5f, -1.0f);
+
+    std::vector<float> x, y;
+    for (uint32 i = 0; i < 100; ++i)
+    {
+        x.push_back(-1.0f - i * 5.3f);
+        y.push_back(-2.0f - i * 4.1f);
+    }
+
+    GridMap floatHeights;
+    REQUIRE(floatHeights.loadData(file.Path.c_str()));
+    REQUIRE_FALSE(floatHeights.hasCompactHeights());
+
+    GridMap compactHeights;
+    REQUIRE(compactHeights.loadData(file.Path.c_str(), true));
+    REQUIRE(compactHeights.hasCompactHeights());
+
+    for (uint32 i = 0; i < x.size(); ++i)
+    {
+        REQUIRE(floatHeights.getHeight(x[i], y[i]) == Approx(file.Height(x[i], y[i])).margin(0.01f));
+        REQUIRE(compactHeights.getHeight(x[i], y[i]) == Approx(file.Height(x[i], y[i])).margin(0.02f));
+    }
+
+    SECTION("Batch queries match single queries")
+    {
+        std::vector<float> heights(x.size());
+        for (GridMap const* grid : { &floatHeights, &compactHeights })
+        {
+            grid->getHeights(x.data(), y.data(), heights.data(), uint32(x.size()));
+            for (uint32 i = 0; i < x.size(); ++i)
+                REQUIRE(heights[i] == grid->getHeight(x[i], y[i]));
+        }
+    }
+
+    SECTION("Grids with too large height range keep float heights")
+    {
+        PlaneMapFile tallFile(20.0f, 0.0f);
+        GridMap tall;
+        REQUIRE(tall.loadData(tallFile.Path.c_str(), true));
+        REQUIRE_FALSE(tall.hasCompactHeights());
+    }
+}
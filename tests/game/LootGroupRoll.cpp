@@ -0,0 +1,124 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Loot.h"
+#include "LootMgr.h"
+#include <initializer_list>
+
+namespace
+{
+    LootStoreItem Entry(uint32 itemId, float chance, uint16 lootMode = LOOT_MODE_DEFAULT)
+    {
+        return LootStoreItem(itemId, 0, chance, false, lootMode, 1, 1, 1);
+    }
+
+    void AddEntries(LootTemplate::LootGroup& group, std::initializer_list<LootStoreItem> entries)
+    {
+        for (LootStoreItem const& entry : entries)
+            group.AddEntry(entry);
+    }
+
+    uint32 RollItem(LootTemplate::LootGroup const& group, Loot const& loot, float roll, float equalChancedRoll = 0.0f, uint16 lootMode = LOOT_MODE_DEFAULT)
+    {
+        LootStoreItem const* item = group.Roll(loot, lootMode, roll, equalChancedRoll);
+        return item ? item->itemid : 0;
+    }
+
+    void AddLootItem(Loot& loot, uint32 itemId)
+    {
+        loot.items.emplace_back();
+        loot.items.back().itemid = itemId;
+    }
+}
+
+TEST_CASE("Loot group rolls", "[LootGroup]")
+{
+    Loot loot;
+
+    SECTION("Explicit chances below 100")
+    {
+        LootTemplate::LootGroup group;
+        AddEntries(group, { Entry(1, 10.0f), Entry(2, 25.0f), Entry(3, 40.0f) });
+        REQUIRE(RollItem(group, loot, 0.0f) == 1);
+        REQUIRE(RollItem(group, loot, 9.5f) == 1);
+        REQUIRE(RollItem(group, loot, 10.0f) == 2);
+        REQUIRE(RollItem(group, loot, 34.5f) == 2);
+        REQUIRE(RollItem(group, loot, 35.0f) == 3);
+        REQUIRE(RollItem(group, loot, 74.5f) == 3);
+        REQUIRE(RollItem(group, loot, 75.0f) == 0);
+        REQUIRE(RollItem(group, loot, 99.5f) == 0);
+    }
+
+    SECTION("Equal chanced entries")
+    {
+        LootTemplate::LootGroup group;
+        AddEntries(group, { Entry(1, 20.0f), Entry(2, 0.0f), Entry(3, 0.0f), Entry(4, 0.0f) });
+        REQUIRE(RollItem(group, loot, 10.0f, 0.5f) == 1);
+        REQUIRE(RollItem(group, loot, 50.0f, 0.0f) == 2);
+        REQUIRE(RollItem(group, loot, 50.0f, 0.5f) == 3);
+        REQUIRE(RollItem(group, loot, 50.0f, 0.99999994f) == 4);
+
+        LootTemplate::LootGroup equalOnly;
+        AddEntries(equalOnly, { Entry(1, 0.0f), Entry(2, 0.0f) });
+        REQUIRE(RollItem(equalOnly, loot, 0.0f, 0.25f) == 1);
+        REQUIRE(RollItem(equalOnly, loot, 0.0f, 0.75f) == 2);
+    }
+
+    SECTION("Total chance over 100")
+    {
+        LootTemplate::LootGroup group;
+        AddEntries(group, { Entry(1, 60.0f), Entry(2, 70.0f), Entry(3, 0.0f) });
+        REQUIRE(RollItem(group, loot, 59.5f) == 1);
+        REQUIRE(RollItem(group, loot, 60.0f) == 2);
+        REQUIRE(RollItem(group, loot, 99.5f) == 2);
+
+        LootTemplate::LootGroup guaranteed;
+        AddEntries(guaranteed, { Entry(1, 35.0f), Entry(2, 100.0f), Entry(3, 50.0f) });
+        REQUIRE(RollItem(guaranteed, loot, 10.0f) == 1);
+        REQUIRE(RollItem(guaranteed, loot, 35.0f) == 2);
+        REQUIRE(RollItem(guaranteed, loot, 99.5f) == 2);
+    }
+
+    SECTION("Loot mode filtering")
+    {
+        LootTemplate::LootGroup group;
+        AddEntries(group, { Entry(1, 20.0f, 0x1), Entry(2, 30.0f, 0x2), Entry(3, 0.0f, 0x1), Entry(4, 0.0f, 0x2) });
+        REQUIRE(RollItem(group, loot, 10.0f, 0.0f, 0x1) == 1);
+        REQUIRE(RollItem(group, loot, 25.0f, 0.0f, 0x1) == 3);
+        REQUIRE(RollItem(group, loot, 10.0f, 0.0f, 0x2) == 2);
+        REQUIRE(RollItem(group, loot, 35.0f, 0.0f, 0x2) == 4);
+        REQUIRE(RollItem(group, loot, 10.0f, 0.0f, 0x4) == 0);
+    }
+
+    SECTION("Items already in the loot")
+    {
+        LootTemplate::LootGroup group;
+        AddEntries(group, { Entry(1, 20.0f), Entry(2, 30.0f), Entry(3, 0.0f), Entry(4, 0.0f) });
+        AddLootItem(loot, 1);
+        REQUIRE(RollItem(group, loot, 10.0f) == 2);
+        REQUIRE(RollItem(group, loot, 35.0f) == 3);
+
+        AddLootItem(loot, 3);
+        REQUIRE(RollItem(group, loot, 35.0f) == 4);
+
+        loot.maxDuplicates = 2;
+        REQUIRE(RollItem(group, loot, 10.0f) == 1);
+        REQUIRE(RollItem(group, loot, 55.0f) == 3);
+    }
+}
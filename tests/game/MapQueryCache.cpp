@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MapQueryCache.h"
+
+TEST_CASE("MapQueryCache line of sight", "[MapQueryCache]")
+{
+    MapQueryCache cache;
+    cache.SetEnabled(true);
+
+    MapQueryCache::LineOfSightKey key = MapQueryCache::MakeLineOfSightKey(100.0f, 200.0f, 10.0f, 120.0f, 210.0f, 12.0f, 1, 3, 0);
+    REQUIRE_FALSE(cache.FindLineOfSight(key));
+    cache.StoreLineOfSight(key, true);
+    REQUIRE(cache.FindLineOfSight(key));
+    REQUIRE(*cache.FindLineOfSight(key));
+
+    SECTION("Positions within one step share results")
+    {
+        REQUIRE(cache.FindLineOfSight(MapQueryCache::MakeLineOfSightKey(100.05f, 200.1f, 10.0f, 120.0f, 210.0f, 12.1f, 1, 3, 0)));
+        REQUIRE_FALSE(cache.FindLineOfSight(MapQueryCache::MakeLineOfSightKey(100.2f, 200.0f, 10.0f, 120.0f, 210.0f, 12.0f, 1, 3, 0)));
+    }
+
+    SECTION("Phases and checks are part of the key")
+    {
+        REQUIRE_FALSE(cache.FindLineOfSight(MapQueryCache::MakeLineOfSightKey(100.0f, 200.0f, 10.0f, 120.0f, 210.0f, 12.0f, 2, 3, 0)));
+        REQUIRE_FALSE(cache.FindLineOfSight(MapQueryCache::MakeLineOfSightKey(100.0f, 200.0f, 10.0f, 120.0f, 210.0f, 12.0f, 1, 1, 0)));
+        REQUIRE_FALSE(cache.FindLineOfSight(MapQueryCache::MakeLineOfSightKey(100.0f, 200.0f, 10.0f, 120.0f, 210.0f, 12.0f, 1, 3, 1)));
+    }
+
+    SECTION("Gameobject model changes drop line of sight but not heights")
+    {
+        MapQueryCache::PositionKey heightKey = MapQueryCache::MakeHeightKey(100.0f, 200.0f, 10.0f, 50.0f);
+        cache.StoreVMapHeight(heightKey, 8.5f);
+        cache.InvalidateGameObjectModels();
+        REQUIRE_FALSE(cache.FindLineOfSight(key));
+        REQUIRE(cache.FindVMapHeight(heightKey));
+        REQUIRE(*cache.FindVMapHeight(heightKey) == 8.5f);
+    }
+
+    SECTION("New epoch drops everything")
+    {
+        MapQueryCache::PositionKey heightKey = MapQueryCache::MakeHeightKey(100.0f, 200.0f, 10.0f, 50.0f);
+        cache.StoreVMapHeight(heightKey, 8.5f);
+        cache.NewEpoch();
+        REQUIRE_FALSE(cache.FindLineOfSight(key));
+        REQUIRE_FALSE(cache.FindVMapHeight(heightKey));
+    }
+}
+
+TEST_CASE("MapQueryCache area and liquid data", "[MapQueryCache]")
+{
+    MapQueryCache cache;
+    cache.SetEnabled(true);
+
+    VMAP::AreaAndLiquidData data;
+    data.floorZ = 4.0f;
+    data.areaInfo.emplace(1, 2, 3, 8);
+
+    MapQueryCache::PositionKey key = MapQueryCache::MakeAreaAndLiquidKey(-50.0f, 25.0f, 5.0f, 0x1F);
+    cache.StoreVMapAreaAndLiquidData(key, data);
+    REQUIRE_FALSE(cache.FindVMapAreaAndLiquidData(MapQueryCache::MakeAreaAndLiquidKey(-50.0f, 25.0f, 5.0f, 0x01)));
+
+    VMAP::AreaAndLiquidData const* cached = cache.FindVMapAreaAndLiquidData(key);
+    REQUIRE(cached);
+    REQUIRE(cached->floorZ == 4.0f);
+    REQUIRE(cached->areaInfo.has_value());
+    REQUIRE(cached->areaInfo->groupId == 3);
+    REQUIRE_FALSE(cached->liquidInfo.has_value());
+
+    MapQueryCache::Stats stats = cache.ConsumeStats();
+    REQUIRE(stats.Hits == 1);
+    REQUIRE(stats.Misses == 1);
+    REQUIRE(cache.ConsumeStats().Hits == 0);
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Map.h"
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    constexpr time_t StartTime = 1600000000;
+
+    RespawnInfo MakeRespawnInfo(ObjectGuid::LowType spawnId, time_t respawnTime)
+    {
+        RespawnInfo info;
+        info.type = SPAWN_TYPE_CREATURE;
+        info.spawnId = spawnId;
+        info.entry = 1;
+        info.respawnTime = respawnTime;
+        info.gridId = 0;
+        return info;
+    }
+
+    std::vector<ObjectGuid::LowType> PopDue(RespawnListContainer& queue, time_t now)
+    {
+        std::vector<ObjectGuid::LowType> due;
+        queue.Advance(uint64(now));
+        while (Trinity::TimerWheelNode* node = queue.PopDue())
+            due.push_back(static_cast<RespawnInfo*>(node)->spawnId);
+        return due;
+    }
+}
+
+TEST_CASE("Respawn queue order", "[RespawnQueue]")
+{
+    RespawnListContainer queue;
+    queue.Advance(uint64(StartTime));
+
+    std::deque<RespawnInfo> infos;
+    infos.push_back(MakeRespawnInfo(1, StartTime + 300));
+    infos.push_back(MakeRespawnInfo(2, StartTime + 10));
+    infos.push_back(MakeRespawnInfo(3, StartTime + 3 * DAY));
+    infos.push_back(MakeRespawnInfo(4, std::numeric_limits<time_t>::max()));
+    for (RespawnInfo& info : infos)
+        queue.Schedule(&info, uint64(info.respawnTime));
+
+    REQUIRE(PopDue(queue, StartTime + 9).empty());
+    REQUIRE(PopDue(queue, StartTime + 10) == std::vector<ObjectGuid::LowType>{ 2 });
+
+    SECTION("Respawns overdue by several steps are returned together in time order")
+    {
+        REQUIRE(PopDue(queue, StartTime + 4 * DAY) == std::vector<ObjectGuid::LowType>{ 1, 3 });
+        REQUIRE(queue.Size() == 1);
+    }
+
+    SECTION("Forced respawn moves the entry to the current time")
+    {
+        RespawnInfo& info = infos[2];
+        info.respawnTime = StartTime + 20;
+        queue.Unschedule(&info);
+        queue.Schedule(&info, uint64(info.respawnTime));
+        REQUIRE(PopDue(queue, StartTime + 20) == std::vector<ObjectGuid::LowType>{ 3 });
+    }
+
+    SECTION("Copies do not take the queue position along")
+    {
+        RespawnInfo copy(infos[0]);
+        REQUIRE(infos[0].IsScheduled());
+        REQUIRE(!copy.IsScheduled());
+        REQUIRE(copy.spawnId == 1);
+        REQUIRE(copy.respawnTime == StartTime + 300);
+
+        copy = infos[2];
+        REQUIRE(!copy.IsScheduled());
+        REQUIRE(copy.spawnId == 3);
+    }
+
+    for (RespawnInfo& info : infos)
+        if (queue.Contains(&info))
+            queue.Unschedule(&info);
+}
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "RespawnWriteBuffer.h"
+
+TEST_CASE("RespawnWriteBuffer coalesces writes", "[RespawnWriteBuffer]")
+{
+    RespawnWriteBuffer buffer;
+
+    SECTION("Repeated saves of one spawn write the last time")
+    {
+        buffer.Save(SPAWN_TYPE_CREATURE, 10, 100);
+        buffer.Save(SPAWN_TYPE_CREATURE, 10, 200);
+        buffer.Save(SPAWN_TYPE_GAMEOBJECT, 10, 300);
+
+        std::vector<RespawnWriteBuffer::Write> writes = buffer.TakePending();
+        REQUIRE(writes.size() == 2);
+        for (RespawnWriteBuffer::Write const& write : writes)
+            REQUIRE(write.RespawnTime == (write.Type == SPAWN_TYPE_CREATURE ? 200 : 300));
+
+        RespawnWriteBuffer::Stats stats = buffer.ConsumeStats();
+        REQUIRE(stats.Requested == 3);
+        REQUIRE(stats.Written == 2);
+        REQUIRE(!buffer.HasPending());
+    }
+
+    SECTION("Save followed by delete of a row that was never written")
+    {
+        buffer.Save(SPAWN_TYPE_CREATURE, 10, 100);
+        buffer.Delete(SPAWN_TYPE_CREATURE, 10);
+        REQUIRE(buffer.TakePending().empty());
+
+        buffer.Delete(SPAWN_TYPE_CREATURE, 11);
+        REQUIRE(!buffer.HasPending());
+    }
+
+    SECTION("Delete of a persisted row")
+    {
+        buffer.SetPersisted(SPAWN_TYPE_CREATURE, 10);
+        buffer.Save(SPAWN_TYPE_CREATURE, 10, 100);
+        buffer.Delete(SPAWN_TYPE_CREATURE, 10);
+
+        std::vector<RespawnWriteBuffer::Write> writes = buffer.TakePending();
+        REQUIRE(writes.size() == 1);
+        REQUIRE(writes[0].SpawnId == 10);
+        REQUIRE(writes[0].RespawnTime == 0);
+
+        // row is gone now
+        buffer.Delete(SPAWN_TYPE_CREATURE, 10);
+        REQUIRE(!buffer.HasPending());
+    }
+
+    SECTION("Flushed saves are remembered as persisted")
+    {
+        buffer.Save(SPAWN_TYPE_GAMEOBJECT, 5, 100);
+        buffer.TakePending();
+        buffer.Delete(SPAWN_TYPE_GAMEOBJECT, 5);
+
+        std::vector<RespawnWriteBuffer::Write> writes = buffer.TakePending();
+        REQUIRE(writes.size() == 1);
+        REQUIRE(writes[0].Type == SPAWN_TYPE_GAMEOBJECT);
+        REQUIRE(writes[0].RespawnTime == 0);
+    }
+
+    SECTION("Direct writes supersede pending ones")
+    {
+        buffer.Save(SPAWN_TYPE_CREATURE, 10, 100);
+        buffer.WrittenDirectly(SPAWN_TYPE_CREATURE, 10, true);
+        REQUIRE(!buffer.HasPending());
+
+        buffer.Delete(SPAWN_TYPE_CREATURE, 10);
+        REQUIRE(buffer.GetPendingCount() == 1);
+
+        buffer.WrittenDirectly(SPAWN_TYPE_CREATURE, 10, false);
+        REQUIRE(!buffer.HasPending());
+    }
+
+    SECTION("Clear forgets pending writes and persisted rows")
+    {
+        buffer.SetPersisted(SPAWN_TYPE_CREATURE, 10);
+        buffer.Save(SPAWN_TYPE_CREATURE, 11, 100);
+        buffer.Clear();
+        REQUIRE(!buffer.HasPending());
+
+        buffer.Delete(SPAWN_TYPE_CREATURE, 10);
+        REQUIRE(!buffer.HasPending());
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DBCStores.h"
+#include "DBCfmt.h"
+#include "SpellAuraDefines.h"
+#include "SpellMgr.h"
+#include <boost/filesystem/operations.hpp>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 SpellFieldCount = sizeof(SpellEntryfmt) - 1;
+
+    // field indexes of SpellEntry in Spell.dbc
+    enum SpellField : uint32
+    {
+        SPELL_FIELD_ID                  = 0,
+        SPELL_FIELD_ATTRIBUTES          = 4,
+        SPELL_FIELD_ATTRIBUTES_EX3      = 7,
+        SPELL_FIELD_PROC_TYPE_MASK      = 34,
+        SPELL_FIELD_EQUIPPED_ITEM_CLASS = 68,
+        SPELL_FIELD_EFFECT              = 71,
+        SPELL_FIELD_EFFECT_AURA         = 95
+    };
+
+    using SpellRecord = std::array<uint32, SpellFieldCount>;
+
+    SpellRecord MakeSpell(uint32 id)
+    {
+        SpellRecord record = { };
+        record[SPELL_FIELD_ID] = id;
+        record[SPELL_FIELD_EQUIPPED_ITEM_CLASS] = uint32(-1);
+        return record;
+    }
+
+    // all strings of the records point at the empty string at offset 0 of the string block
+    void WriteSpellDbc(std::string const& fileName, std::vector<SpellRecord> const& records)
+    {
+        FILE* file = fopen(fileName.c_str(), "wb");
+        REQUIRE(file);
+
+        std::array<uint32, 5> header = { 0x43424457, uint32(records.size()), SpellFieldCount, SpellFieldCount * 4, 1 };
+        fwrite(header.data(), sizeof(uint32), header.size(), file);
+        for (SpellRecord const& record : records)
+            fwrite(record.data(), sizeof(uint32), record.size(), file);
+        fputc('\0', file);
+        fclose(file);
+    }
+}
+
+TEST_CASE("SpellMgr builds the spell hot data from the spell store", "[SpellMgr]")
+{
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("tc-dbc-%%%%-%%%%");
+    boost::filesystem::create_directories(path);
+    std::string fileName = (path / "Spell.dbc").string();
+
+    SpellRecord stealth = MakeSpell(10);
+    stealth[SPELL_FIELD_ATTRIBUTES] = SPELL_ATTR0_PASSIVE;
+    stealth[SPELL_FIELD_ATTRIBUTES_EX3] = SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED;
+    stealth[SPELL_FIELD_PROC_TYPE_MASK] = PROC_FLAG_DONE_SPELL_MAGIC_DMG_CLASS_NEG;
+    stealth[SPELL_FIELD_EFFECT + EFFECT_0] = SPELL_EFFECT_APPLY_AURA;
+    stealth[SPELL_FIELD_EFFECT_AURA + EFFECT_0] = SPELL_AURA_MOD_STEALTH;
+    // aura type of an effect that does not apply an aura
+    stealth[SPELL_FIELD_EFFECT + EFFECT_1] = SPELL_EFFECT_SCHOOL_DAMAGE;
+    stealth[SPELL_FIELD_EFFECT_AURA + EFFECT_1] = SPELL_AURA_MOD_STUN;
+
+    SpellRecord damage = MakeSpell(3);
+    damage[SPELL_FIELD_EFFECT + EFFECT_0] = SPELL_EFFECT_SCHOOL_DAMAGE;
+
+    WriteSpellDbc(fileName, { stealth, damage });
+    REQUIRE(sSpellStore.Load(fileName.c_str()));
+
+    sSpellMgr->LoadSpellInfoStore();
+    sSpellMgr->LoadSpellInfoHotData();
+
+    SECTION("Attributes and aura types")
+    {
+        SpellInfoHotData const* hotData = sSpellMgr->GetSpellInfoHotData(10);
+        REQUIRE(hotData);
+        REQUIRE(hotData->HasAttribute(SPELL_ATTR0_PASSIVE));
+        REQUIRE(hotData->HasAttribute(SPELL_ATTR3_CAN_PROC_WITH_TRIGGERED));
+        REQUIRE(!hotData->HasAttribute(SPELL_ATTR1_CHANNELED_1));
+        REQUIRE(hotData->HasAura(SPELL_AURA_MOD_STEALTH));
+        REQUIRE(!hotData->HasAura(SPELL_AURA_MOD_STUN));
+
+        hotData = sSpellMgr->GetSpellInfoHotData(3);
+        REQUIRE(hotData);
+        REQUIRE(!hotData->HasAttribute(SPELL_ATTR0_PASSIVE));
+        REQUIRE(!hotData->HasAura(SPELL_AURA_MOD_STEALTH));
+    }
+
+    SECTION("Proc entries are linked by LoadSpellProcs")
+    {
+        // spell_proc is not loaded, the proc mask from Spell.dbc alone does not make a spell proc
+        SpellInfoHotData const* hotData = sSpellMgr->GetSpellInfoHotData(10);
+        REQUIRE(hotData);
+        REQUIRE(hotData->ProcEntry == nullptr);
+        REQUIRE(hotData->ProcFlags == 0);
+    }
+
+    SECTION("Spell ids without a spell")
+    {
+        REQUIRE(sSpellMgr->GetSpellInfoStoreSize() == 11);
+
+        SpellInfoHotData const* hotData = sSpellMgr->GetSpellInfoHotData(5);
+        REQUIRE(hotData);
+        REQUIRE(!hotData->HasAttribute(SPELL_ATTR0_PASSIVE));
+        REQUIRE(hotData->ProcEntry == nullptr);
+
+        REQUIRE(sSpellMgr->GetSpellInfoHotData(11) == nullptr);
+    }
+
+    sSpellMgr->UnloadSpellInfoStore();
+    REQUIRE(sSpellMgr->GetSpellInfoHotData(10) == nullptr);
+
+    boost::filesystem::remove_all(path);
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "UpdateFieldFlags.h"
+#include "UpdateMask.h"
+#include <vector>
+
+namespace
+{
+    std::vector<uint32> SelectFieldsByMask(uint32 const* flags, UpdateMask changes, uint32 visibleFlag, uint32 notifyFlags)
+    {
+        std::vector<uint32> fields;
+        UpdateFieldFlagMasks::For(flags).Filter(changes, visibleFlag, notifyFlags);
+        changes.ForEachSetBit([&](uint32 index) { fields.push_back(index); });
+        return fields;
+    }
+}
+
+TEST_CASE("UpdateMask bits", "[UpdateMask]")
+{
+    UpdateMask mask;
+    mask.SetCount(UNIT_END);
+    REQUIRE(mask.GetBlockCount() == (UNIT_END + 31) / 32);
+
+    mask.SetBit(0);
+    mask.SetBit(31);
+    mask.SetBit(32);
+    mask.SetBit(UNIT_END - 1);
+    REQUIRE(mask.GetBit(31));
+    REQUIRE_FALSE(mask.GetBit(30));
+    REQUIRE(mask.GetBlock(0) == 0x80000001);
+    REQUIRE(mask.GetBlock(1) == 0x00000001);
+
+    std::vector<uint32> indexes;
+    mask.ForEachSetBit([&](uint32 index) { indexes.push_back(index); });
+    REQUIRE(indexes == std::vector<uint32>{ 0, 31, 32, UNIT_END - 1 });
+
+    mask.UnsetBit(31);
+    REQUIRE(mask.GetBlock(0) == 0x00000001);
+
+    ByteBuffer packet;
+    mask.AppendToPacket(&packet);
+    REQUIRE(packet.size() == mask.GetBlockCount() * sizeof(UpdateMask::ClientUpdateMaskType));
+    REQUIRE(packet.read<uint32>() == 0x00000001);
+
+    mask.Clear();
+    REQUIRE_FALSE(mask.GetBit(0));
+    REQUIRE_FALSE(mask.GetBit(UNIT_END - 1));
+}
+
+TEST_CASE("UpdateMask non zero values", "[UpdateMask]")
+{
+    uint32 values[GAMEOBJECT_END] = { };
+    values[1] = 5;
+    values[GAMEOBJECT_END - 1] = 1;
+
+    UpdateMask mask;
+    mask.SetCount(GAMEOBJECT_END);
+    mask.SetNonZeroBits(values);
+
+    std::vector<uint32> indexes;
+    mask.ForEachSetBit([&](uint32 index) { indexes.push_back(index); });
+    REQUIRE(indexes == std::vector<uint32>{ 1, GAMEOBJECT_END - 1 });
+}
+
+TEST_CASE("Visible fields", "[UpdateMask]")
+{
+    UpdateMask changes;
+    changes.SetCount(PLAYER_END);
+    changes.SetBit(UNIT_FIELD_HEALTH);
+    changes.SetBit(PLAYER_FIELD_COINAGE);
+
+    SECTION("Changed public fields and all dynamic fields are sent to other players")
+    {
+        REQUIRE(SelectFieldsByMask(UnitUpdateFieldFlags, changes, UF_FLAG_PUBLIC, UF_FLAG_DYNAMIC) == std::vector<uint32>{ UNIT_FIELD_HEALTH, UNIT_DYNAMIC_FLAGS, UNIT_NPC_FLAGS });
+    }
+
+    SECTION("Changed private fields are sent to the owner")
+    {
+        REQUIRE(SelectFieldsByMask(UnitUpdateFieldFlags, changes, UF_FLAG_PUBLIC | UF_FLAG_PRIVATE, UF_FLAG_DYNAMIC) == std::vector<uint32>{ UNIT_FIELD_HEALTH, UNIT_DYNAMIC_FLAGS, UNIT_NPC_FLAGS, PLAYER_FIELD_COINAGE });
+    }
+
+    SECTION("Dynamic fields are sent without changes")
+    {
+        changes.Clear();
+        REQUIRE(SelectFieldsByMask(UnitUpdateFieldFlags, changes, UF_FLAG_PUBLIC, UF_FLAG_DYNAMIC) == std::vector<uint32>{ UNIT_DYNAMIC_FLAGS, UNIT_NPC_FLAGS });
+        REQUIRE(SelectFieldsByMask(UnitUpdateFieldFlags, changes, UF_FLAG_PUBLIC, UF_FLAG_NONE).empty());
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "WorldUpdateScheduler.h"
+#include <thread>
+#include <vector>
+
+TEST_CASE("Queued tasks run once in queue order", "[WorldUpdateScheduler]")
+{
+    WorldUpdateScheduler scheduler;
+    std::vector<uint32> runs;
+    for (uint32 id = 0; id < 3; ++id)
+        scheduler.AddTask(id, "task", std::chrono::milliseconds(1), [&runs, id](TimePoint) { runs.push_back(id); return true; });
+
+    scheduler.Queue(2);
+    scheduler.Queue(0);
+    scheduler.Queue(2);
+    REQUIRE(scheduler.IsQueued(2));
+    REQUIRE(!scheduler.IsQueued(1));
+
+    scheduler.Update();
+    REQUIRE(runs == std::vector<uint32>{ 2, 0 });
+    REQUIRE(!scheduler.IsQueued(2));
+
+    scheduler.Update();
+    REQUIRE(runs.size() == 2);
+}
+
+TEST_CASE("Tasks over the tick budget wait for the next tick", "[WorldUpdateScheduler]")
+{
+    WorldUpdateScheduler scheduler;
+    scheduler.SetTickBudget(std::chrono::milliseconds(1));
+    std::vector<uint32> runs;
+    for (uint32 id = 0; id < 3; ++id)
+    {
+        scheduler.AddTask(id, "task", std::chrono::milliseconds(1), [&runs, id](TimePoint)
+        {
+            runs.push_back(id);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            return true;
+        });
+        scheduler.Queue(id);
+    }
+
+    // first queued task always runs even though it takes longer than the whole budget
+    scheduler.Update();
+    REQUIRE(runs == std::vector<uint32>{ 0 });
+    REQUIRE(scheduler.IsQueued(1));
+    REQUIRE(scheduler.IsQueued(2));
+
+    scheduler.Update();
+    scheduler.Update();
+    REQUIRE(runs == std::vector<uint32>{ 0, 1, 2 });
+
+    std::vector<uint32> deferred(3);
+    scheduler.ConsumeStats([&](uint32 id, WorldUpdateScheduler::TaskStats const& stats) { deferred[id] = stats.Deferred; });
+    REQUIRE(deferred == std::vector<uint32>{ 0, 1, 2 });
+}
+
+TEST_CASE("Unfinished tasks are queued behind the others", "[WorldUpdateScheduler]")
+{
+    WorldUpdateScheduler scheduler;
+    std::vector<uint32> runs;
+    uint32 remaining = 2;
+    scheduler.AddTask(0, "incremental", std::chrono::milliseconds(1), [&](TimePoint deadline)
+    {
+        REQUIRE(deadline > std::chrono::steady_clock::now());
+        runs.push_back(0);
+        return --remaining == 0;
+    });
+    scheduler.AddTask(1, "task", std::chrono::milliseconds(1), [&](TimePoint) { runs.push_back(1); return true; });
+
+    scheduler.Queue(0);
+    scheduler.Queue(1);
+    scheduler.Update();
+    REQUIRE(runs == std::vector<uint32>{ 0, 1 });
+    REQUIRE(scheduler.IsQueued(0));
+
+    scheduler.Update();
+    REQUIRE(runs == std::vector<uint32>{ 0, 1, 0 });
+    REQUIRE(!scheduler.IsQueued(0));
+
+    scheduler.ConsumeStats([](uint32 id, WorldUpdateScheduler::TaskStats const& stats)
+    {
+        REQUIRE(stats.Runs == (id == 0 ? 2u : 1u));
+        REQUIRE(stats.Unfinished == (id == 0 ? 1u : 0u));
+    });
+}
+
+TEST_CASE("Run times are collected in histogram buckets", "[WorldUpdateScheduler]")
+{
+    WorldUpdateScheduler scheduler;
+    scheduler.AddTask(0, "fast", std::chrono::milliseconds(1), [](TimePoint) { return true; });
+    scheduler.AddTask(1, "slow", std::chrono::milliseconds(1), [](TimePoint)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        return true;
+    });
+
+    scheduler.Queue(0);
+    scheduler.Queue(1);
+    scheduler.Update();
+
+    scheduler.ConsumeStats([&](uint32 id, WorldUpdateScheduler::TaskStats const& stats)
+    {
+        REQUIRE(stats.Runs == 1);
+        if (id == 1)
+            REQUIRE(stats.RunTimes.back() == 1);
+        else
+            REQUIRE(stats.RunTimes.back() == 0);
+    });
+
+    scheduler.ConsumeStats([](uint32, WorldUpdateScheduler::TaskStats const& stats) { REQUIRE(stats.Runs == 0); });
+    REQUIRE(scheduler.GetTaskName(1) == "slow");
+}